@@ -0,0 +1,54 @@
+#------------------------------------------
+# Generates a source file holding copies of the corrections tables, so that
+# they can be compiled into the library and used when the files are not
+# found on disk (enabled with -Dembedcorr=ON).
+#
+#   embed_corrections(<output> <file1> [<file2> ...])
+#
+# Each table is stored as a constexpr byte array and looked up at run time
+# by its file name. The output is only rewritten when its content changes.
+#------------------------------------------
+function (embed_corrections _output)
+    # Pattern matching one row of 16 bytes in the output
+    set (_row "")
+    foreach (_i RANGE 15)
+        set (_row "${_row}0x..,")
+    endforeach ()
+
+    set (_arrays "")
+    set (_names  "")
+    set (_data   "")
+    set (_sizes  "")
+    set (_index 0)
+    foreach (_file ${ARGN})
+        # Re-run the configuration whenever one of the tables changes
+        set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${_file})
+
+        # Convert the file content into a comma separated list of bytes
+        get_filename_component(_name ${_file} NAME)
+        file(READ ${_file} _hex HEX)
+        string(LENGTH "${_hex}" _length)
+        math(EXPR _size "${_length} / 2")
+        string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," _bytes "${_hex}")
+        string(REGEX REPLACE "(${_row})" "\\1\n        " _bytes "${_bytes}")
+
+        set (_arrays "${_arrays}    constexpr unsigned char table${_index}[] = {\n        ${_bytes}0x00};\n")
+        set (_names  "${_names}    \"${_name}\",\n")
+        set (_data   "${_data}    table${_index},\n")
+        set (_sizes  "${_sizes}    ${_size},\n")
+        math(EXPR _index "${_index} + 1")
+    endforeach ()
+
+    set (_content "// Generated by EmbedCorrections.cmake, do not edit\n\n")
+    set (_content "${_content}#include <cstddef>\n\n")
+    set (_content "${_content}namespace {\n${_arrays}}\n\n")
+    set (_content "${_content}extern const std::size_t ce_embedded_count = ${_index};\n")
+    set (_content "${_content}extern const char* const ce_embedded_names[] = {\n${_names}};\n")
+    set (_content "${_content}extern const unsigned char* const ce_embedded_data[] = {\n${_data}};\n")
+    set (_content "${_content}extern const std::size_t ce_embedded_sizes[] = {\n${_sizes}};\n")
+
+    # Only touch the output if it changed, to avoid needless rebuilds
+    file(WRITE ${_output}.tmp "${_content}")
+    execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different ${_output}.tmp ${_output})
+    file(REMOVE ${_output}.tmp)
+endfunction (embed_corrections)
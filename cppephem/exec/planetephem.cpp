@@ -193,29 +193,28 @@ void PrintEphemeris(CEObservation& obs,
     std::printf("\n");
     std::printf("      JD        LOCAL     RA (appar.)    DEC (appar.)     Az       Alt  \n") ;
     std::printf(" =======================================================================\n") ;
+    // All of the dates (and their time scales) are set up at once
     int max_steps = int(duration/step_size);
-    CESkyCoord obs_coords;
+    double step_days = step_size/(60.0*24.0);
+    CEDateRange dates = CEDateRange::Steps(date->JD(), max_steps + 1, step_days);
+    std::vector<CESkyCoord> all_obs_coords = obs.GetObservedCoords(dates);
     CESkyCoord appar_coords;
-    for (int s=0; s<=max_steps; s++) {
+    for (std::size_t s=0; s<dates.size(); s++) {
 
         // Get the observed coordinates
-        obs_coords.SetCoordinates(obs.GetAzimuth_Rad(), obs.GetZenith_Rad(),
-                                  CESkyCoordType::OBSERVED);
+        CESkyCoord& obs_coords = all_obs_coords[s];
         // Convert to RA,DEC
-        appar_coords = obs_coords.ConvertToICRS(*date, *observer);
+        appar_coords = obs_coords.ConvertToICRS(dates.TimeScales(s), *observer);
         // Update the coordiantes of the planet
         ra  = appar_coords.XCoord().HmsVect();
         dec = appar_coords.YCoord().DmsVect();
         
         std::printf(" %11.2f  %08.1f  %2.0fh %2.0fm %4.1fs  %+3.0fd %2.0fm %4.1fs  %8.3f  %+7.3f\n",
-                    double(*date), date->GetTime(observer->UTCOffset()),
+                    dates.JD(s), CEDate(dates.MJD(s), CEDateType::MJD).GetTime(observer->UTCOffset()),
                     ra[0], ra[1], ra[2] + ra[3],
                     dec[0], dec[1], dec[2] + dec[3],
                     obs_coords.XCoord().Deg(),
                     90.0-obs_coords.YCoord().Deg());
-        
-        // Update the date
-        date->SetDate(date->JD() + step_size/(60.0*24.0), CEDateType::JD);
     }
     
     std::printf(" -------------------------------------------------------------------\n");
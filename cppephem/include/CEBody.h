@@ -66,6 +66,8 @@ public:
     virtual CESkyCoord GetCoordinates(const CEDate& date=CEDate::CurrentJD()) const;
     virtual CESkyCoord ObservedCoords(const CEDate&     date,
                                       const CEObserver& observer) const;
+    virtual CESkyCoord ObservedCoords(const CETimeScales& date,
+                                      const CEObserver&   observer) const;
     std::string   Name(void) const;
     void          SetName(const std::string& new_name);
     
@@ -0,0 +1,160 @@
+/***************************************************************************
+ *  CEChebyshevCache.h: CppEphem                                           *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef CEChebyshevCache_h
+#define CEChebyshevCache_h
+
+#include <climits>
+#include <cmath>
+#include <map>
+#include <mutex>
+
+#include <sofam.h>
+
+/** \class CEChebyshevCache
+ CEChebyshevCache replaces a slow, smooth series of the TT Julian date by
+ Chebyshev fits over fixed segments of time.
+
+ The series is only evaluated at the Chebyshev nodes of a segment the
+ first time a date in that segment is needed, and the fitted coefficients
+ are kept. Every other date is a short polynomial evaluation. The segments
+ are shared between threads, and each thread also keeps the last segment
+ it used so that runs of nearby dates don't take the lock.
+
+ @tparam Series         Series to fit (of the two part TT Julian date)
+ @tparam NCoeff         Number of Chebyshev coefficients per segment
+ @tparam SegmentDays    Length of each segment (days)
+ */
+template<double (*Series)(const double&, const double&),
+         int NCoeff,
+         int SegmentDays>
+class CEChebyshevCache {
+public:
+    static double Value(const double& tt1,
+                        const double& tt2);
+
+private:
+    // Chebyshev coefficients of the series over one segment, which starts
+    // 'index' segments after J2000
+    struct Segment {
+        long   index;
+        double coeff[NCoeff];
+    };
+
+    static const Segment& GetSegment(const long& index);
+    static Segment        FitSegment(const long& index);
+
+    // Last segment used (one per thread)
+    static thread_local Segment cache_;
+};
+
+// Last segment used by each thread (none to begin with)
+template<double (*Series)(const double&, const double&), int NCoeff, int SegmentDays>
+thread_local typename CEChebyshevCache<Series, NCoeff, SegmentDays>::Segment
+    CEChebyshevCache<Series, NCoeff, SegmentDays>::cache_ = {LONG_MIN, {0.0}};
+
+
+/**********************************************************************//**
+ * Return the fitted series
+ *
+ * @param[in] tt1           First part of the TT Julian date
+ * @param[in] tt2           Second part of the TT Julian date
+ * @return Series value
+ *************************************************************************/
+template<double (*Series)(const double&, const double&), int NCoeff, int SegmentDays>
+double CEChebyshevCache<Series, NCoeff, SegmentDays>::Value(const double& tt1,
+                                                            const double& tt2)
+{
+    // Days since J2000, and the segment containing them
+    double t     = (tt1 - DJ00) + tt2;
+    long   index = static_cast<long>(std::floor(t / SegmentDays));
+    if (index != cache_.index) {
+        cache_ = GetSegment(index);
+    }
+
+    // Position in the segment scaled to [-1,1], then Clenshaw's recurrence
+    double x  = 2.0 * (t - index*SegmentDays) / SegmentDays - 1.0;
+    double b1 = 0.0;
+    double b2 = 0.0;
+    for (int k=NCoeff-1; k>0; k--) {
+        double b = 2.0*x*b1 - b2 + cache_.coeff[k];
+        b2 = b1;
+        b1 = b;
+    }
+    return x*b1 - b2 + 0.5*cache_.coeff[0];
+}
+
+
+/**********************************************************************//**
+ * Return a segment, fitting it if no thread has needed it yet
+ *
+ * @param[in] index         Segment index (segments since J2000)
+ * @return Segment
+ *************************************************************************/
+template<double (*Series)(const double&, const double&), int NCoeff, int SegmentDays>
+const typename CEChebyshevCache<Series, NCoeff, SegmentDays>::Segment&
+    CEChebyshevCache<Series, NCoeff, SegmentDays>::GetSegment(const long& index)
+{
+    static std::mutex              mutex;
+    static std::map<long, Segment> segments;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    typename std::map<long, Segment>::iterator seg = segments.find(index);
+    if (seg == segments.end()) {
+        seg = segments.insert(std::make_pair(index, FitSegment(index))).first;
+    }
+    // Entries are never removed, so the reference stays valid
+    return seg->second;
+}
+
+
+/**********************************************************************//**
+ * Fit the Chebyshev coefficients of one segment
+ *
+ * @param[in] index         Segment index (segments since J2000)
+ * @return Segment
+ *************************************************************************/
+template<double (*Series)(const double&, const double&), int NCoeff, int SegmentDays>
+typename CEChebyshevCache<Series, NCoeff, SegmentDays>::Segment
+    CEChebyshevCache<Series, NCoeff, SegmentDays>::FitSegment(const long& index)
+{
+    // Evaluate the series at the Chebyshev nodes
+    double start = static_cast<double>(index) * SegmentDays;
+    double values[NCoeff];
+    for (int j=0; j<NCoeff; j++) {
+        double x  = std::cos(DPI * (j + 0.5) / NCoeff);
+        values[j] = Series(DJ00, start + 0.5*(x + 1.0)*SegmentDays);
+    }
+
+    // Coefficients from the discrete cosine transform of the values
+    Segment seg;
+    seg.index = index;
+    for (int k=0; k<NCoeff; k++) {
+        double sum = 0.0;
+        for (int j=0; j<NCoeff; j++) {
+            sum += values[j] * std::cos(DPI * k * (j + 0.5) / NCoeff);
+        }
+        seg.coeff[k] = 2.0 * sum / NCoeff;
+    }
+    return seg;
+}
+
+#endif /* CEChebyshevCache_h */
@@ -22,15 +22,80 @@
 #ifndef CECorrections_h
 #define CECorrections_h
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
+/** Specifies how correction values are interpolated between table rows */
+enum class CEInterpType
+{
+    NONE=0,           ///< Use the value of the preceding row
+    LINEAR=1,         ///< Linear interpolation between the two closest rows
+    CUBIC=2           ///< Natural cubic spline through all of the rows
+};
+
+/** Specifies how correction values are found for dates outside of a table */
+enum class CEExtrapType
+{
+    NONE=0,           ///< Throw CEException::invalid_value
+    CLAMP=1,          ///< Use the value of the first or last row
+    BULLETIN_A=2      ///< IERS Bulletin A long-term predictions after the last row
+};
+
+/** Reports where correction values came from */
+enum class CELookupStatus : std::uint8_t
+{
+    TABLE=0,          ///< Looked up (or interpolated) from the table
+    EXTRAPOLATED=1    ///< Extrapolated outside of the table (see ::CEExtrapType)
+};
+
+/** Earth orientation parameters for a single date */
+struct CEEop
+{
+    double dut1;      ///< UT1-UTC (seconds)
+    double xp;        ///< x-polar motion (radians)
+    double yp;        ///< y-polar motion (radians)
+    double dpsi;      ///< Longitude correction (radians)
+    double deps;      ///< Obliquity correction (radians)
+    double ttut1;     ///< TT-UT1 (seconds)
+    CELookupStatus status; ///< Whether any of the values were extrapolated
+};
+
+/** Usage statistics of a single corrections table */
+struct CETableStats
+{
+    std::uint64_t loads;          ///< Number of times the table was (re)loaded
+    double        load_time;      ///< Total time spent loading the table (seconds)
+    std::uint64_t rows;           ///< Total number of rows parsed or mapped
+    std::uint64_t lookups;        ///< Number of dates looked up (single and batched)
+    std::uint64_t cache_hits;     ///< Single date lookups answered by the cache
+    std::uint64_t cache_misses;   ///< Single date lookups that searched the table
+    std::uint64_t range_errors;   ///< Dates outside of the table
+    std::uint64_t interpolations; ///< Values interpolated between rows
+    std::uint64_t tables;         ///< Tables of this kind in memory (all objects)
+};
+
+/** Usage statistics of a CECorrections object (see CECorrections::Stats()) */
+struct CECorrectionsStats
+{
+    CETableStats  nutation;       ///< Nutation (earth orientation) table
+    CETableStats  ttut1;          ///< TT-UT1 table
+    std::uint64_t downloads;      ///< Number of attempted downloads
+    double        download_time;  ///< Total time spent downloading (seconds)
+};
+
 class CECorrections {
 public:
     CECorrections();
     CECorrections(const CECorrections& other);
-    virtual ~CECorrections() {}
+    virtual ~CECorrections();
 
     CECorrections& operator=(const CECorrections& other);
 
@@ -40,62 +105,339 @@ public:
     double      deps(const double& mjd) const;
     double      dpsi(const double& mjd) const;
     double      ttut1(const double& mjd) const;
+    CEEop       eop(const double& mjd) const;
+
+    // Batched lookups for arrays of dates
+    void        dut1(const double* mjd, double* values, const std::size_t& n,
+                 CELookupStatus* status=nullptr) const;
+    void        xpolar(const double* mjd, double* values, const std::size_t& n,
+                   CELookupStatus* status=nullptr) const;
+    void        ypolar(const double* mjd, double* values, const std::size_t& n,
+                   CELookupStatus* status=nullptr) const;
+    void        deps(const double* mjd, double* values, const std::size_t& n,
+                 CELookupStatus* status=nullptr) const;
+    void        dpsi(const double* mjd, double* values, const std::size_t& n,
+                 CELookupStatus* status=nullptr) const;
+    void        ttut1(const double* mjd, double* values, const std::size_t& n,
+                  CELookupStatus* status=nullptr) const;
+    void        eop(const double* mjd, CEEop* values, const std::size_t& n) const;
+    std::vector<double> dut1(const std::vector<double>& mjd) const;
+    std::vector<double> xpolar(const std::vector<double>& mjd) const;
+    std::vector<double> ypolar(const std::vector<double>& mjd) const;
+    std::vector<double> deps(const std::vector<double>& mjd) const;
+    std::vector<double> dpsi(const std::vector<double>& mjd) const;
+    std::vector<double> ttut1(const std::vector<double>& mjd) const;
+    std::vector<CEEop>  eop(const std::vector<double>& mjd) const;
+
     std::string NutationFile(void) const;
     std::string TtUt1HistFile(void) const;
     std::string TtUt1PredFile(void) const;
+    std::string NutationCacheFile(void) const;
+    std::string TtUt1CacheFile(void) const;
     void        SetNutationFile(const std::string& filename);
     void        SetTtUt1HistFile(const std::string& filename);
     void        SetTtUt1PredFile(const std::string& filename);
     void        SetInterp(bool set_interp);
+    void        SetInterp(const CEInterpType& interp_type);
+    CEInterpType InterpType(void) const;
+    void        SetExtrap(const CEExtrapType& extrap_type);
+    CEExtrapType ExtrapType(void) const;
+    std::size_t NutationRows(void) const;
+    double      NutationLoadTime(void) const;
+    std::size_t TtUt1Rows(void) const;
+    double      TtUt1LoadTime(void) const;
+    void        SetMJDRange(const double& mjd_min, const double& mjd_max);
+
+    // Usage statistics
+    CECorrectionsStats Stats(void) const;
+    std::string StatsJSON(void) const;
+    void        ResetStats(void);
+
+    // Loading the tables in the background
+    std::shared_future<bool> Prefetch(void);
+
+    // Replacing the loaded tables while lookups are in progress
+    bool        Reload(void);
+    bool        SetWatchFiles(bool watch);
+    bool        WatchFiles(void) const;
 
 private:
 
+    // Index for finding the row of a given MJD without a binary search.
+    // Uniformly spaced tables are indexed arithmetically, otherwise 'bucket'
+    // holds the first row at or after the start of each 'step' wide bucket.
+    struct MJDIndex {
+        double                   start;    ///< MJD of the first row
+        double                   step;     ///< Row spacing (uniform) or bucket width
+        double                   inv_step; ///< 1/step (0 if the table is not indexed)
+        bool                     uniform;  ///< Whether the rows are uniformly spaced
+        std::vector<std::size_t> bucket;   ///< First row in each bucket
+    };
+
+    // Immutable tables of correction values. Once a table is published it
+    // is never modified, so it can be read concurrently without locking
+    // and shared by copies of the object.
+    // The columns either point into 'data' (parsed from the text files) or
+    // into a read-only memory mapping of the binary cache file.
+    struct NutationTable {
+        std::size_t                 size;      ///< Number of rows
+        double                      load_time; ///< Time taken to load the table (seconds)
+        double                      cover_min; ///< First date the table can be used for
+        double                      cover_max; ///< Last date the table can be used for
+        const double*               mjd;       ///< Modified Julian date of each row
+        const double*               dut1;      ///< UT1-UTC (seconds)
+        const double*               xp;        ///< x-polar motion (radians)
+        const double*               yp;        ///< y-polar motion (radians)
+        const double*               deps;      ///< Obliquity correction (radians)
+        const double*               dpsi;      ///< Longitude correction (radians)
+        MJDIndex                    index;     ///< Index of the 'mjd' column
+        std::vector<double>         spline;    ///< Cubic coefficients (per row: 4 per column)
+        double                      dut1_rate; ///< Recent UT1-UTC drift, less seasonal terms (seconds/day)
+        std::vector<double>         data;      ///< Column storage for parsed tables
+        std::shared_ptr<const void> mapping;   ///< Column storage for mapped tables
+    };
+    struct TtUt1Table {
+        std::size_t                 size;      ///< Number of rows
+        double                      load_time; ///< Time taken to load the table (seconds)
+        double                      cover_min; ///< First date the table can be used for
+        double                      cover_max; ///< Last date the table can be used for
+        const double*               mjd;       ///< Modified Julian date of each row
+        const double*               delt;      ///< TT-UT1 (seconds)
+        MJDIndex                    index;     ///< Index of the 'mjd' column
+        std::vector<double>         spline;    ///< Cubic coefficients (per row: 4 per column)
+        double                      delt_rate; ///< Recent TT-UT1 trend (seconds/day)
+        std::vector<double>         data;      ///< Column storage for parsed tables
+        std::shared_ptr<const void> mapping;   ///< Column storage for mapped tables
+    };
+
+    // Cache hits of one thread on one object. Each thread counts its hits
+    // in its own block, so a hit never writes to memory shared with other
+    // threads. Stats() sums the blocks.
+    struct HitCounters {
+        std::thread::id            thread;
+        std::atomic<std::uint64_t> nutation;
+        std::atomic<std::uint64_t> ttut1;
+    };
+
+    // Per-thread lookup state, so that lookups never write to shared memory.
+    // The cache owns the table its values came from, which keeps that table
+    // alive (and its address unique) for as long as the values are used.
+    struct NutationCache {
+        std::shared_ptr<const NutationTable> table;
+        std::uint64_t  owner;      ///< Identifier of the object that filled the cache
+        HitCounters*   hits;       ///< Hit counters of that object for this thread
+        CEInterpType   interp;
+        CEExtrapType   extrap;
+        CELookupStatus status;
+        double         mjd;
+        double         dut1;
+        double         xp;
+        double         yp;
+        double         deps;
+        double         dpsi;
+    };
+    struct TtUt1Cache {
+        std::shared_ptr<const TtUt1Table> table;
+        std::uint64_t  owner;      ///< Identifier of the object that filled the cache
+        HitCounters*   hits;       ///< Hit counters of that object for this thread
+        CEInterpType   interp;
+        CEExtrapType   extrap;
+        CELookupStatus status;
+        double         mjd;
+        double         delt;
+    };
+
+    // Counters behind CETableStats (the lookup count only includes batched
+    // lookups, single lookups are either a cache hit or a miss). Cache hits
+    // are counted per thread in HitCounters instead.
+    struct TableCounters {
+        std::atomic<std::uint64_t> loads;
+        std::atomic<std::uint64_t> load_ns;
+        std::atomic<std::uint64_t> rows;
+        std::atomic<std::uint64_t> batch_lookups;
+        std::atomic<std::uint64_t> cache_misses;
+        std::atomic<std::uint64_t> range_errors;
+        std::atomic<std::uint64_t> interpolations;
+    };
+
     void   copy_members(const CECorrections& other);
     void   free_members(void);
     void   init_members(void);
     std::ifstream LoadFile(const std::string& filename,
                           const std::string& url) const;
+    bool   ReadCorrectionsFile(const std::string& filename,
+                               const std::string& url,
+                               std::vector<char>* buffer,
+                               bool*              embedded) const;
     bool   DownloadTable(const std::string& filename,
                          const std::string& url) const;
-    bool   LoadNutation(void) const;
-    bool   LoadTtUt1(void) const;
+    bool   LoadNutation(const double& mjd_min, 
+                        const double& mjd_max,
+                        std::string*  filename=nullptr) const;
+    bool   LoadTtUt1(const double& mjd_min, 
+                     const double& mjd_max,
+                     std::string*  filename=nullptr) const;
+    std::shared_ptr<const NutationTable> ReadNutation(const std::string& filename,
+                                                      const double&      range_min,
+                                                      const double&      range_max) const;
+    std::shared_ptr<const TtUt1Table>    ReadTtUt1(const std::string& hist_file,
+                                                   const std::string& pred_file,
+                                                   const double&      range_min,
+                                                   const double&      range_max) const;
+    bool   ReloadNutation(void);
+    bool   ReloadTtUt1(void);
+    void   StopWatch(void);
+    void   WaitPrefetch(void) const;
+    void   WatchLoop(std::promise<bool> started);
+    void   PublishNutation(const std::shared_ptr<const NutationTable>& table) const;
+    void   PublishTtUt1(const std::shared_ptr<const TtUt1Table>& table) const;
+    std::shared_ptr<const NutationTable> Nutation(const double& mjd_min,
+                                                  const double& mjd_max) const;
+    std::shared_ptr<const NutationTable> Nutation(const double*      mjd,
+                                                  const std::size_t& n) const;
+    std::shared_ptr<const TtUt1Table>    TtUt1(const double& mjd_min,
+                                               const double& mjd_max) const;
+    std::shared_ptr<const TtUt1Table>    TtUt1(const double*      mjd,
+                                               const std::size_t& n) const;
+    static void          SetColumns(NutationTable* table, const double* columns);
+    static void          SetColumns(TtUt1Table* table, const double* columns);
+    static void          PrepareTable(NutationTable* table);
+    static void          PrepareTable(TtUt1Table* table);
+    static void          BuildIndex(MJDIndex*          index,
+                                    const double*      mjd,
+                                    const std::size_t& size);
+    static int           FindIndex(const MJDIndex&    index,
+                                   const double*      mjd,
+                                   const std::size_t& size,
+                                   const double&      x);
+    static void   BuildSpline(const double*      x,
+                              const double*      y,
+                              const std::size_t& size,
+                              const double&      max_jump,
+                              double*            coeffs,
+                              const std::size_t& stride);
+    static double SplineValue(const double* coeffs, const double& t);
     double InterpValue(const double& x,
                        const double& x0, const double& x1,
                        const double& y0, const double& y1) const;
-    void   UpdateNutationCache(const double& mjd) const;
-    void   UpdateTtUt1Cache(const double& mjd) const;
+    void   BatchLookup(const double*      table_mjd,
+                       const double*      column,
+                       const std::size_t& size,
+                       const MJDIndex&    index,
+                       const double*      spline,
+                       const std::size_t& stride,
+                       const double*      mjd,
+                       double*            values,
+                       const std::size_t& n,
+                       CELookupStatus*    status,
+                       const std::function<double(const double&)>& extrap,
+                       TableCounters*     counters) const;
+    void   FindRows(const double*             table_mjd,
+                    const std::size_t&        size,
+                    const MJDIndex&           index,
+                    const double*             mjd,
+                    const std::size_t&        n,
+                    const bool&               extrap,
+                    TableCounters*            counters,
+                    std::vector<int>*         rows,
+                    std::vector<std::size_t>* outside) const;
+    void   FillColumn(const double*       table_mjd,
+                      const double*       column,
+                      const std::size_t&  size,
+                      const double*       spline,
+                      const std::size_t&  stride,
+                      const CEInterpType& interp,
+                      const double*       mjd,
+                      const int*          rows,
+                      double*             values,
+                      const std::size_t&  n) const;
+    static std::function<double(const double&)> ExtrapFunction(const NutationTable& table,
+                                                               const double*        column,
+                                                               const CEExtrapType&  extrap);
+    static std::function<double(const double&)> ExtrapFunction(const TtUt1Table&   table,
+                                                               const CEExtrapType& extrap);
+    static double ExtrapValue(const NutationTable& table,
+                              const double*        column,
+                              const double&        mjd,
+                              const CEExtrapType&  extrap);
+    static double ExtrapValue(const TtUt1Table&   table,
+                              const double&       mjd,
+                              const CEExtrapType& extrap);
+    static void RangeError(const std::string& origin,
+                           const double&      mjd,
+                           const double*      table_mjd,
+                           const std::size_t& size);
+    const NutationCache& UpdateNutationCache(const double& mjd) const;
+    const TtUt1Cache&    UpdateTtUt1Cache(const double& mjd) const;
+    static void          RecordLoad(TableCounters*     counters,
+                                    const double&      load_time,
+                                    const std::size_t& rows);
+    static void          CountMiss(TableCounters*      counters,
+                                   const bool&         outside,
+                                   const CEInterpType& interp);
+    static void          CountInterpolations(TableCounters*      counters,
+                                             const std::size_t&  n,
+                                             const CEInterpType& interp);
+    HitCounters*         ThreadHits(void) const;
+    static std::uint64_t NextObjectId(void);
+    static CETableStats  GetTableStats(const TableCounters& counters,
+                                       const std::uint64_t& cache_hits);
+    static void          ResetCounters(TableCounters* counters);
 
     // Filenames for storing/loading correction values
     mutable std::string nutation_file_;   ///< File for nutation corrections
     mutable std::string ttut1_file_hist_; ///< File for historic TT-UT1 corrections
     mutable std::string ttut1_file_pred_; ///< File for predicted TT-UT1 corrections
 
-    // Table to hold the corrections for a given MJD
-    mutable std::vector<int>    nutation_mjd_;
-    mutable std::vector<double> nutation_dut1_;
-    mutable std::vector<double> nutation_xp_;
-    mutable std::vector<double> nutation_yp_;
-    mutable std::vector<double> nutation_deps_;
-    mutable std::vector<double> nutation_dpsi_;
+    // Loaded tables. The shared pointers own the tables and are only replaced
+    // while holding 'load_mutex_' (with std::atomic_store), readers take a
+    // reference with std::atomic_load. The raw pointers mirror them so that
+    // a cache hit can be detected without touching the reference count.
+    // A replaced table is freed once the last lookup using it lets go.
+    mutable std::shared_ptr<const NutationTable> nutation_;
+    mutable std::shared_ptr<const TtUt1Table>    ttut1_;
+    mutable std::atomic<const NutationTable*>    nutation_ptr_;
+    mutable std::atomic<const TtUt1Table*>       ttut1_ptr_;
+    mutable std::mutex                           load_mutex_;
+
+    // Range of dates that the tables are loaded for. Lookups outside of
+    // it extend the range and reload the table that doesn't cover them.
+    mutable double range_min_;
+    mutable double range_max_;
 
-    mutable std::vector<double> ttut1_mjd_;
-    mutable std::vector<double> ttut1_delt_;
+    // Background load started by Prefetch() (guarded by 'load_mutex_')
+    std::shared_future<bool> prefetch_;
+
+    // Background thread watching the correction files for updates
+    std::thread       watch_thread_;
+    std::atomic<bool> watch_stop_;
 
     // Specifies whether to interpolate values between dates or not
     // Interpolating will give slightly more accurate results at the expense
     // of increasing computation time.
-    bool interp_;
+    std::atomic<CEInterpType> interp_;
+
+    // Specifies what to do for dates outside of the tables
+    std::atomic<CEExtrapType> extrap_;
+
+    // Usage statistics, updated with relaxed atomics so that they can
+    // always be enabled. They are not shared with copies of the object.
+    mutable TableCounters              nutation_stats_;
+    mutable TableCounters              ttut1_stats_;
+    mutable std::atomic<std::uint64_t> downloads_;
+    mutable std::atomic<std::uint64_t> download_ns_;
+
+    // Cache hit counters of each thread that has used this object, and the
+    // identifier that tells the lookup caches which object filled them
+    // (a new one whenever the counters are discarded)
+    std::uint64_t                                     id_;
+    mutable std::mutex                                hits_mutex_;
+    mutable std::vector<std::unique_ptr<HitCounters>> hits_;
 
     // Caching variables so that we dont need to find new values if we've
-    // already looked up the appropriate index
-    mutable double cache_nut_mjd_;
-    mutable double cache_nut_dut1_;
-    mutable double cache_nut_xp_;
-    mutable double cache_nut_yp_;
-    mutable double cache_nut_deps_;
-    mutable double cache_nut_dpsi_;
-    mutable double cache_ttut1_mjd_;
-    mutable double cache_ttut1_delt_;
+    // already looked up the appropriate index (one set per thread)
+    static thread_local NutationCache cache_nut_;
+    static thread_local TtUt1Cache    cache_ttut1_;
 };
 
 
@@ -111,6 +453,30 @@ std::string CECorrections::NutationFile(void) const
 }
 
 
+/**********************************************************************//**
+ * Returns the name of the binary cache of the nutation corrections file
+ * 
+ * @return Binary nutation corrections cache filename
+ *************************************************************************/
+inline
+std::string CECorrections::NutationCacheFile(void) const
+{
+    return nutation_file_ + ".bin";
+}
+
+
+/**********************************************************************//**
+ * Returns the name of the binary cache of the TT-UT1 corrections files
+ * 
+ * @return Binary TT-UT1 corrections cache filename
+ *************************************************************************/
+inline
+std::string CECorrections::TtUt1CacheFile(void) const
+{
+    return ttut1_file_hist_ + ".bin";
+}
+
+
 /**********************************************************************//**
  * Returns the name of the historic TT-UT1 corrections file
  * 
@@ -134,4 +500,30 @@ std::string CECorrections::TtUt1PredFile(void) const
     return ttut1_file_pred_;
 }
 
+
+/**********************************************************************//**
+ * Returns whether the correction files are being watched for updates
+ * 
+ * @return True if a file watching thread is running
+ *************************************************************************/
+inline
+bool CECorrections::WatchFiles(void) const
+{
+    return watch_thread_.joinable();
+}
+
+
+/**********************************************************************//**
+ * Evaluate one interval of a cubic spline
+ * 
+ * @param[in] coeffs        Coefficients of the interval (constant term first)
+ * @param[in] t             Offset from the start of the interval
+ * @return Value of the spline
+ *************************************************************************/
+inline
+double CECorrections::SplineValue(const double* coeffs, const double& t)
+{
+    return coeffs[0] + t*(coeffs[1] + t*(coeffs[2] + t*coeffs[3]));
+}
+
 #endif /* CECorrections_h */
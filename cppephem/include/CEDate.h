@@ -22,6 +22,8 @@
 #ifndef CEDate_h
 #define CEDate_h
 
+#include <atomic>
+#include <cstddef>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -46,7 +48,7 @@ public:
     // Default constructor
     CEDate(double date=CurrentJD(), CEDateType date_format=CEDateType::JD) ;
     explicit CEDate(std::vector<double> date) ;
-    explicit CEDate(const CEDate& other) ;
+    CEDate(const CEDate& other) ;
     virtual ~CEDate();
     
     CEDate& operator=(const CEDate& other);
@@ -56,19 +58,23 @@ public:
                          const CEDateType& time_format=CEDateType::JD) ;
     // Method for setting the dates from the Gregorian calendar dates
     virtual void SetDate(std::vector<double> date) ;
+    // Method for setting the date to the current time
+    void         SetDateNow(void) ;
     
     /***********************************************************
      * Methods for getting the stored date in the various formats
      ***********************************************************/
     double                      GetDate(CEDateType time_format=CEDateType::JD) const;
     virtual double              JD() const;
+    virtual double              JD1() const;
+    virtual double              JD2() const;
     virtual double              MJD() const;
     virtual double              Gregorian() const;
-    virtual std::vector<double> GregorianVect();
-    int                         Year();
-    int                         Month();
-    int                         Day();
-    double                      DayFraction();
+    virtual std::vector<double> GregorianVect() const;
+    int                         Year() const;
+    int                         Month() const;
+    int                         Day() const;
+    double                      DayFraction() const;
     
     /***********************************************************
      * Methods for converting between different formats
@@ -83,13 +89,78 @@ public:
     static double               MJD2JD(double mjd);
     static double               MJD2Gregorian(double mjd);
     static std::vector<double>  MJD2GregorianVect(double mjd);
+
+    /***********************************************************
+     * Methods for converting arrays of dates. The output is
+     * written to caller provided arrays of 'n' values, with the
+     * vector formatted Gregorian dates split into separate
+     * year, month, day and day fraction arrays.
+     ***********************************************************/
+    static void JD2MJD(const double* jd, double* mjd, const std::size_t& n);
+    static void MJD2JD(const double* mjd, double* jd, const std::size_t& n);
+    static void JD2Gregorian(const double* jd, double* gregorian, 
+                             const std::size_t& n);
+    static void MJD2Gregorian(const double* mjd, double* gregorian, 
+                              const std::size_t& n);
+    static void Gregorian2JD(const double* gregorian, double* jd, 
+                             const std::size_t& n);
+    static void Gregorian2MJD(const double* gregorian, double* mjd, 
+                              const std::size_t& n);
+    static void JD2GregorianVect(const double*      jd,
+                                 int*               year,
+                                 int*               month,
+                                 int*               day,
+                                 double*            day_fraction,
+                                 const std::size_t& n);
+    static void MJD2GregorianVect(const double*      mjd,
+                                  int*               year,
+                                  int*               month,
+                                  int*               day,
+                                  double*            day_fraction,
+                                  const std::size_t& n);
+    static void GregorianVect2JD(const int*         year,
+                                 const int*         month,
+                                 const int*         day,
+                                 const double*      day_fraction,
+                                 double*            jd,
+                                 const std::size_t& n);
+    static void GregorianVect2MJD(const int*         year,
+                                  const int*         month,
+                                  const int*         day,
+                                  const double*      day_fraction,
+                                  double*            mjd,
+                                  const std::size_t& n);
+    static void GregorianVect2Gregorian(const int*         year,
+                                        const int*         month,
+                                        const int*         day,
+                                        const double*      day_fraction,
+                                        double*            gregorian,
+                                        const std::size_t& n);
+    static void Gregorian2GregorianVect(const double*      gregorian,
+                                        int*               year,
+                                        int*               month,
+                                        int*               day,
+                                        double*            day_fraction,
+                                        const std::size_t& n);
+    static void                 UTC2UT1(const double& mjd,
+                                        double*       ut11,
+                                        double*       ut12) ;
+    static void                 UTC2TT(const double& mjd,
+                                       double*       tt1,
+                                       double*       tt2) ;
+    static void                 UTC2TDB(const double& mjd,
+                                        double*       tdb1,
+                                        double*       tdb2) ;
     static void                 UTC2UT1(const double& mjd,
+                                        const CEEop&  eop,
                                         double*       ut11,
                                         double*       ut12) ;
     static void                 UTC2TT(const double& mjd,
+                                       const CEEop&  eop,
                                        double*       tt1,
                                        double*       tt2) ;
     static void                 UTC2TDB(const double& mjd,
+                                        const CEEop&  eop,
                                         double*       tdb1,
                                         double*       tdb2) ;
     
@@ -109,6 +180,9 @@ public:
     static double ypolar(const double&     date, 
                          const CEDateType& date_type=CEDateType::JD) ;
     double        ypolar(void) const;
+    static CEEop  eop(const double&     date, 
+                      const CEDateType& date_type=CEDateType::JD) ;
+    CEEop         eop(void) const;
     
     static double GregorianVect2Gregorian(std::vector<double> gregorian) ;
     static std::vector<double> Gregorian2GregorianVect(double gregorian) ;
@@ -116,6 +190,7 @@ public:
     virtual double GetTime(const double& utc_offset=0.0) const;
     virtual double GetTime_UTC() const;
     static double  CurrentJD();
+    static void    CurrentJD(double* jd1, double* jd2);
     void           SetReturnType(CEDateType return_type);
     
     /************************************************************
@@ -130,16 +205,29 @@ private:
     void free_members(void);
     void copy_members(const CEDate& other);
     void init_members(void);
+    void set_gregorian(void) const;
+
+    // States of the Gregorian calendar fields
+    enum CalendarState {CALENDAR_UNSET,           ///< Not computed yet
+                        CALENDAR_BUSY,            ///< Being computed by set_gregorian()
+                        CALENDAR_SET};            ///< Computed
 
     /************************************************************
      * Variables that hold the time information
      ************************************************************/
-    double julian_date_ ;                       ///< Julian date formated
-    double mod_julian_date_ ;                   ///< Modified Julian date formated
-    double gregorian_date_ ;                    ///< Gregorian calendar date. Format as YYYYMMDD.DD
-    std::vector<double> gregorian_date_vect_ ;  ///< Vector containing the gregorian calendar date
-                                                ///< 0 - Year, 1 - Month, 2 - date, 3 - date fraction
+    double jd1_ ;                               ///< First part of the two-part Julian date
+    double jd2_ ;                               ///< Second part of the two-part Julian date
     CEDateType return_type_ = CEDateType::JD ;  ///< what format the 'operator double' will return
+
+    // The Gregorian calendar date is only computed when first asked for.
+    // The fields below are only read once 'gregorian_state_' is set (with
+    // acquire/release ordering), so a const date can be shared by threads.
+    mutable std::atomic<int> gregorian_state_ ; ///< ::CalendarState of the fields below
+    mutable double gregorian_date_ ;            ///< Gregorian calendar date. Format as YYYYMMDD.DD
+    mutable int    year_ ;                      ///< Gregorian calendar year
+    mutable int    month_ ;                     ///< Gregorian calendar month
+    mutable int    day_ ;                       ///< Gregorian calendar day
+    mutable double day_fraction_ ;              ///< Gregorian calendar day fraction
     
 };
 
@@ -150,7 +238,27 @@ private:
 inline 
 double CEDate::JD(void) const
 {
-    return julian_date_;
+    return jd1_ + jd2_;
+}
+
+
+/**********************************************************************//**
+ * Get the first part of the two-part Julian date
+ *************************************************************************/
+inline 
+double CEDate::JD1(void) const
+{
+    return jd1_;
+}
+
+
+/**********************************************************************//**
+ * Get the second part of the two-part Julian date
+ *************************************************************************/
+inline 
+double CEDate::JD2(void) const
+{
+    return jd2_;
 }
 
 
@@ -160,7 +268,7 @@ double CEDate::JD(void) const
 inline 
 double CEDate::MJD(void) const
 {
-    return mod_julian_date_;
+    return (jd1_ - DJM0) + jd2_;
 }
 
 
@@ -170,6 +278,7 @@ double CEDate::MJD(void) const
 inline 
 double CEDate::Gregorian(void) const
 {
+    if (gregorian_state_.load(std::memory_order_acquire) != CALENDAR_SET) set_gregorian();
     return gregorian_date_;
 }
 
@@ -178,9 +287,11 @@ double CEDate::Gregorian(void) const
  * Get the Gregorian calendar date formatted as a vector
  *************************************************************************/
 inline 
-std::vector<double> CEDate::GregorianVect(void)
+std::vector<double> CEDate::GregorianVect(void) const
 {
-    return gregorian_date_vect_;
+    if (gregorian_state_.load(std::memory_order_acquire) != CALENDAR_SET) set_gregorian();
+    return std::vector<double>({double(year_), double(month_), 
+                                double(day_), day_fraction_});
 }
 
 
@@ -188,9 +299,10 @@ std::vector<double> CEDate::GregorianVect(void)
  * Get the Gregorian calendar year
  *************************************************************************/
 inline 
-int CEDate::Year(void)
+int CEDate::Year(void) const
 {
-    return gregorian_date_vect_[0];
+    if (gregorian_state_.load(std::memory_order_acquire) != CALENDAR_SET) set_gregorian();
+    return year_;
 }
 
 
@@ -198,9 +310,10 @@ int CEDate::Year(void)
  * Get the Gregorian calendar month
  *************************************************************************/
 inline 
-int CEDate::Month(void) 
+int CEDate::Month(void) const
 {
-    return gregorian_date_vect_[1];
+    if (gregorian_state_.load(std::memory_order_acquire) != CALENDAR_SET) set_gregorian();
+    return month_;
 }
 
 
@@ -208,9 +321,10 @@ int CEDate::Month(void)
  * Get the Gregorian calendar day
  *************************************************************************/
 inline 
-int CEDate::Day(void) 
+int CEDate::Day(void) const
 {
-    return gregorian_date_vect_[2];
+    if (gregorian_state_.load(std::memory_order_acquire) != CALENDAR_SET) set_gregorian();
+    return day_;
 }
 
 
@@ -218,9 +332,10 @@ int CEDate::Day(void)
  * Get the Gregorian calendar day fraction
  *************************************************************************/
 inline 
-double CEDate::DayFraction(void)
+double CEDate::DayFraction(void) const
 {
-    return gregorian_date_vect_[3];
+    if (gregorian_state_.load(std::memory_order_acquire) != CALENDAR_SET) set_gregorian();
+    return day_fraction_;
 }
 
 
@@ -0,0 +1,272 @@
+/***************************************************************************
+ *  CEDateRange.h: CppEphem                                                *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef CEDateRange_h
+#define CEDateRange_h
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// CppEphem HEADERS
+#include "CEDate.h"
+#include "CENamespace.h"
+#include "CETimeScales.h"
+
+class CEDateRange {
+public:
+    CEDateRange();
+    CEDateRange(const double&      start,
+                const double&      stop,
+                const double&      step,
+                const CEDateType&  date_format=CEDateType::JD);
+    CEDateRange(const std::vector<double>& dates,
+                const CEDateType&          date_format=CEDateType::JD);
+    CEDateRange(const CEDateRange& other);
+    virtual ~CEDateRange();
+
+    CEDateRange& operator=(const CEDateRange& other);
+
+    // Evenly spaced dates given by their number rather than the stop date
+    static CEDateRange Steps(const double&      start,
+                             const std::size_t& n,
+                             const double&      step,
+                             const CEDateType&  date_format=CEDateType::JD);
+
+    // Number of dates in the range
+    std::size_t  size(void) const;
+
+    /***********************************************************
+     * Methods for getting each date in the various time scales.
+     * Each time is a two-part Julian date, as in CETimeScales.
+     ***********************************************************/
+    double       MJD(const std::size_t& i) const;
+    double       JD(const std::size_t& i) const;
+    double       UTC1(const std::size_t& i) const;
+    double       UTC2(const std::size_t& i) const;
+    const CEEop& eop(const std::size_t& i) const;
+    double       UT11(const std::size_t& i) const;
+    double       UT12(const std::size_t& i) const;
+    double       TAI1(const std::size_t& i) const;
+    double       TAI2(const std::size_t& i) const;
+    double       TT1(const std::size_t& i) const;
+    double       TT2(const std::size_t& i) const;
+    double       TDB1(const std::size_t& i) const;
+    double       TDB2(const std::size_t& i) const;
+    double       ERA(const std::size_t& i) const;
+    CETimeScales TimeScales(const std::size_t& i) const;
+
+private:
+
+    void free_members(void);
+    void copy_members(const CEDateRange& other);
+    void init_members(void);
+    void set_steps(const CEDate&      start,
+                   const std::size_t& n,
+                   const double&      step);
+    void compute(void) const;
+    void compute_scales(void) const;
+
+    // States of the computed time scales
+    enum RangeState {RANGE_UNSET,               ///< Not computed yet
+                     RANGE_BUSY,                ///< Being computed by compute()
+                     RANGE_SET};                ///< Computed
+
+    std::vector<double> utc1_;               ///< UTC (first part, dates are sorted)
+    std::vector<double> utc2_;               ///< UTC (second part)
+
+    // The time scales are only computed when first asked for. The values
+    // below are only read once 'state_' is set (with acquire/release
+    // ordering), so a const range can be shared by threads.
+    mutable std::atomic<int>    state_;      ///< ::RangeState of the values below
+    mutable std::vector<CEEop>  eop_;        ///< Earth orientation parameters
+    mutable std::vector<double> ut11_;       ///< UT1 (first part)
+    mutable std::vector<double> ut12_;       ///< UT1 (second part)
+    mutable std::vector<double> tai1_;       ///< TAI (first part)
+    mutable std::vector<double> tai2_;       ///< TAI (second part)
+    mutable std::vector<double> tt1_;        ///< TT (first part)
+    mutable std::vector<double> tt2_;        ///< TT (second part)
+    mutable std::vector<double> tdb1_;       ///< TDB (first part)
+    mutable std::vector<double> tdb2_;       ///< TDB (second part)
+    mutable std::vector<double> era_;        ///< Earth rotation angle (radians)
+};
+
+
+/**********************************************************************//**
+ * Return the number of dates in the range
+ *************************************************************************/
+inline
+std::size_t CEDateRange::size(void) const
+{
+    return utc1_.size();
+}
+
+
+/**********************************************************************//**
+ * Return the UTC modified Julian date of date @p i
+ *************************************************************************/
+inline
+double CEDateRange::MJD(const std::size_t& i) const
+{
+    return (utc1_[i] - DJM0) + utc2_[i];
+}
+
+
+/**********************************************************************//**
+ * Return the UTC Julian date of date @p i
+ *************************************************************************/
+inline
+double CEDateRange::JD(const std::size_t& i) const
+{
+    return utc1_[i] + utc2_[i];
+}
+
+
+/**********************************************************************//**
+ * Return the first part of the UTC Julian date of date @p i
+ *************************************************************************/
+inline
+double CEDateRange::UTC1(const std::size_t& i) const
+{
+    return utc1_[i];
+}
+
+
+/**********************************************************************//**
+ * Return the second part of the UTC Julian date of date @p i
+ *************************************************************************/
+inline
+double CEDateRange::UTC2(const std::size_t& i) const
+{
+    return utc2_[i];
+}
+
+
+/**********************************************************************//**
+ * Return the Earth orientation parameters of date @p i
+ *************************************************************************/
+inline
+const CEEop& CEDateRange::eop(const std::size_t& i) const
+{
+    if (state_.load(std::memory_order_acquire) != RANGE_SET) compute();
+    return eop_[i];
+}
+
+
+/**********************************************************************//**
+ * Return the first part of the UT1 Julian date of date @p i
+ *************************************************************************/
+inline
+double CEDateRange::UT11(const std::size_t& i) const
+{
+    if (state_.load(std::memory_order_acquire) != RANGE_SET) compute();
+    return ut11_[i];
+}
+
+
+/**********************************************************************//**
+ * Return the second part of the UT1 Julian date of date @p i
+ *************************************************************************/
+inline
+double CEDateRange::UT12(const std::size_t& i) const
+{
+    if (state_.load(std::memory_order_acquire) != RANGE_SET) compute();
+    return ut12_[i];
+}
+
+
+/**********************************************************************//**
+ * Return the first part of the TAI Julian date of date @p i
+ *************************************************************************/
+inline
+double CEDateRange::TAI1(const std::size_t& i) const
+{
+    if (state_.load(std::memory_order_acquire) != RANGE_SET) compute();
+    return tai1_[i];
+}
+
+
+/**********************************************************************//**
+ * Return the second part of the TAI Julian date of date @p i
+ *************************************************************************/
+inline
+double CEDateRange::TAI2(const std::size_t& i) const
+{
+    if (state_.load(std::memory_order_acquire) != RANGE_SET) compute();
+    return tai2_[i];
+}
+
+
+/**********************************************************************//**
+ * Return the first part of the TT Julian date of date @p i
+ *************************************************************************/
+inline
+double CEDateRange::TT1(const std::size_t& i) const
+{
+    if (state_.load(std::memory_order_acquire) != RANGE_SET) compute();
+    return tt1_[i];
+}
+
+
+/**********************************************************************//**
+ * Return the second part of the TT Julian date of date @p i
+ *************************************************************************/
+inline
+double CEDateRange::TT2(const std::size_t& i) const
+{
+    if (state_.load(std::memory_order_acquire) != RANGE_SET) compute();
+    return tt2_[i];
+}
+
+
+/**********************************************************************//**
+ * Return the first part of the TDB Julian date of date @p i
+ *************************************************************************/
+inline
+double CEDateRange::TDB1(const std::size_t& i) const
+{
+    if (state_.load(std::memory_order_acquire) != RANGE_SET) compute();
+    return tdb1_[i];
+}
+
+
+/**********************************************************************//**
+ * Return the second part of the TDB Julian date of date @p i
+ *************************************************************************/
+inline
+double CEDateRange::TDB2(const std::size_t& i) const
+{
+    if (state_.load(std::memory_order_acquire) != RANGE_SET) compute();
+    return tdb2_[i];
+}
+
+
+/**********************************************************************//**
+ * Return the Earth rotation angle (radians) of date @p i
+ *************************************************************************/
+inline
+double CEDateRange::ERA(const std::size_t& i) const
+{
+    if (state_.load(std::memory_order_acquire) != RANGE_SET) compute();
+    return era_[i];
+}
+
+#endif /* CEDateRange_h */
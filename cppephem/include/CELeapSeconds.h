@@ -0,0 +1,69 @@
+/***************************************************************************
+ *  CELeapSeconds.h: CppEphem                                              *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef CELeapSeconds_h
+#define CELeapSeconds_h
+
+#include <cstdint>
+#include <vector>
+
+class CELeapSeconds {
+public:
+    static double TaiUtc(const double& mjd);
+    static void   UTC2TAI(const double& mjd,
+                          double*       tai1,
+                          double*       tai2);
+    static void   UTC2TAI(const double& utc1,
+                          const double& utc2,
+                          double*       tai1,
+                          double*       tai2);
+    static void   UTC2UT1(const double& mjd,
+                          const double& dut1,
+                          double*       ut11,
+                          double*       ut12);
+    static void   UTC2UT1(const double& utc1,
+                          const double& utc2,
+                          const double& dut1,
+                          double*       ut11,
+                          double*       ut12);
+    static void   UTC2TT(const double& mjd,
+                         double*       tt1,
+                         double*       tt2);
+    static double FirstMJD(void);
+    static double LastMJD(void);
+
+private:
+    // TAI-UTC at 0h UTC of every day from 'first_mjd' onwards. Since 1972
+    // TAI-UTC is a whole number of seconds, so one byte per day is enough.
+    struct Table {
+        int                      first_mjd;
+        std::vector<std::int8_t> dat;
+    };
+
+    static const Table& GetTable(void);
+    static bool         FastUTC2TAI(const double& utc1,
+                                    const double& utc2,
+                                    double*       tai1,
+                                    double*       tai2,
+                                    double*       dat);
+};
+
+#endif /* CELeapSeconds_h */
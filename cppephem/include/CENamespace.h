@@ -81,6 +81,36 @@ namespace CppEphem {
      *********************************************/
     double ttut1(const double& mjd);
 
+    /*********************************************
+     * All Earth orientation parameters at once
+     *********************************************/
+    CEEop eop(const double& mjd);
+
+    /*********************************************
+     * Corrections for arrays of dates (much
+     * cheaper than one call per date)
+     *********************************************/
+    std::vector<double> dut1(const std::vector<double>& mjd);
+    std::vector<double> xp(const std::vector<double>& mjd);
+    std::vector<double> yp(const std::vector<double>& mjd);
+    std::vector<double> deps(const std::vector<double>& mjd);
+    std::vector<double> dpsi(const std::vector<double>& mjd);
+    std::vector<double> ttut1(const std::vector<double>& mjd);
+    std::vector<CEEop>  eop(const std::vector<double>& mjd);
+    void dut1(const double* mjd, double* values, const std::size_t& n,
+              CELookupStatus* status=nullptr);
+    void xp(const double* mjd, double* values, const std::size_t& n,
+            CELookupStatus* status=nullptr);
+    void yp(const double* mjd, double* values, const std::size_t& n,
+            CELookupStatus* status=nullptr);
+    void deps(const double* mjd, double* values, const std::size_t& n,
+              CELookupStatus* status=nullptr);
+    void dpsi(const double* mjd, double* values, const std::size_t& n,
+              CELookupStatus* status=nullptr);
+    void ttut1(const double* mjd, double* values, const std::size_t& n,
+               CELookupStatus* status=nullptr);
+    void eop(const double* mjd, CEEop* values, const std::size_t& n);
+
     /** Method for estimating altitude (in meters) from atmospheric pressure (in hPa) */
     inline double EstimateAltitude_m(double pressure_hPa)
         {return -29.3 * SeaLevelTemp_K() * std::log(pressure_hPa/1013.25) ;}
@@ -96,6 +126,13 @@ namespace CppEphem {
     void        SetTtUt1HistFile(const std::string& filename);
     void        SetTtUt1PredFile(const std::string& filename);
     void        CorrectionsInterp(bool set_interp);
+    void        CorrectionsInterp(const CEInterpType& interp_type);
+    void        CorrectionsExtrap(const CEExtrapType& extrap_type);
+    CECorrectionsStats CorrectionsStats(void);
+    std::string CorrectionsStatsJSON(void);
+    std::shared_future<bool> PrefetchCorrections(void);
+    bool        CorrectionsReload(void);
+    bool        CorrectionsWatch(bool watch);
     static      CECorrections corrections;
 
     namespace StrOpt {
@@ -0,0 +1,242 @@
+/***************************************************************************
+ *  CENanoTime.h: CppEphem                                                 *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef CENanoTime_h
+#define CENanoTime_h
+
+#include <cstddef>
+#include <cstdint>
+
+class CENanoTime {
+public:
+    // Constructors (the default is J2000.0 TT)
+    CENanoTime(void);
+
+    // Named constructors
+    static CENanoTime FromTT(const std::int64_t& ns);
+    static CENanoTime FromTT(const double& tt1,
+                             const double& tt2);
+    static CENanoTime FromTAI(const std::int64_t& ns);
+    static CENanoTime FromUTC(const std::int64_t& unix_ns);
+    static CENanoTime FromUTC(const std::int64_t& mjd,
+                              const std::int64_t& ns_of_day);
+    static CENanoTime Now(void);
+
+    // Integer representations
+    std::int64_t TT(void) const;
+    std::int64_t TAI(void) const;
+    std::int64_t UTC(void) const;
+    void         UTC(std::int64_t* mjd,
+                     std::int64_t* ns_of_day) const;
+
+    // Two-part Julian dates
+    void TT(double* tt1, double* tt2) const;
+    void TAI(double* tai1, double* tai2) const;
+    void UTC(double* utc1, double* utc2) const;
+    static void TT(const CENanoTime*  times,
+                   double*            tt1,
+                   double*            tt2,
+                   const std::size_t& n);
+
+    // Arithmetic (durations are in nanoseconds)
+    CENanoTime&  operator+=(const std::int64_t& ns);
+    CENanoTime&  operator-=(const std::int64_t& ns);
+    CENanoTime   operator+(const std::int64_t& ns) const;
+    CENanoTime   operator-(const std::int64_t& ns) const;
+    std::int64_t operator-(const CENanoTime& other) const;
+
+    // Comparisons
+    friend bool operator==(const CENanoTime& lhs, const CENanoTime& rhs);
+    friend bool operator!=(const CENanoTime& lhs, const CENanoTime& rhs);
+    friend bool operator<(const CENanoTime& lhs, const CENanoTime& rhs);
+    friend bool operator<=(const CENanoTime& lhs, const CENanoTime& rhs);
+    friend bool operator>(const CENanoTime& lhs, const CENanoTime& rhs);
+    friend bool operator>=(const CENanoTime& lhs, const CENanoTime& rhs);
+
+    // Nanoseconds per second and per day
+    static constexpr std::int64_t sec_ns = 1000000000LL;
+    static constexpr std::int64_t day_ns = 86400LL * sec_ns;
+
+private:
+    explicit CENanoTime(const std::int64_t& tt_ns);
+
+    static void         SplitDays(const std::int64_t& ns,
+                                  std::int64_t*       days,
+                                  std::int64_t*       rem);
+    static std::int64_t TaiUtc(const std::int64_t& mjd,
+                               const std::int64_t& ns_of_day);
+
+    std::int64_t tt_ns_;        ///< TT nanoseconds since J2000.0 (JD 2451545.0 TT)
+};
+
+
+/**********************************************************************//**
+ * Default constructor (J2000.0 TT)
+ *************************************************************************/
+inline
+CENanoTime::CENanoTime(void) :
+    tt_ns_(0)
+{}
+
+
+/**********************************************************************//**
+ * Constructor from TT nanoseconds since J2000.0
+ *
+ * @param[in] tt_ns         TT nanoseconds since J2000.0
+ *************************************************************************/
+inline
+CENanoTime::CENanoTime(const std::int64_t& tt_ns) :
+    tt_ns_(tt_ns)
+{}
+
+
+/**********************************************************************//**
+ * Return a time given in TT nanoseconds since J2000.0
+ *
+ * @param[in] ns            TT nanoseconds since J2000.0 (JD 2451545.0 TT)
+ * @return Time
+ *************************************************************************/
+inline
+CENanoTime CENanoTime::FromTT(const std::int64_t& ns)
+{
+    return CENanoTime(ns);
+}
+
+
+/**********************************************************************//**
+ * Return TT nanoseconds since J2000.0
+ *
+ * @return TT nanoseconds since J2000.0 (JD 2451545.0 TT)
+ *************************************************************************/
+inline
+std::int64_t CENanoTime::TT(void) const
+{
+    return tt_ns_;
+}
+
+
+/**********************************************************************//**
+ * Add a duration
+ *
+ * @param[in] ns            Duration (nanoseconds)
+ * @return Reference to this time
+ *************************************************************************/
+inline
+CENanoTime& CENanoTime::operator+=(const std::int64_t& ns)
+{
+    tt_ns_ += ns;
+    return *this;
+}
+
+
+/**********************************************************************//**
+ * Subtract a duration
+ *
+ * @param[in] ns            Duration (nanoseconds)
+ * @return Reference to this time
+ *************************************************************************/
+inline
+CENanoTime& CENanoTime::operator-=(const std::int64_t& ns)
+{
+    tt_ns_ -= ns;
+    return *this;
+}
+
+
+/**********************************************************************//**
+ * Return this time plus a duration
+ *
+ * @param[in] ns            Duration (nanoseconds)
+ * @return Later time
+ *************************************************************************/
+inline
+CENanoTime CENanoTime::operator+(const std::int64_t& ns) const
+{
+    return CENanoTime(tt_ns_ + ns);
+}
+
+
+/**********************************************************************//**
+ * Return this time minus a duration
+ *
+ * @param[in] ns            Duration (nanoseconds)
+ * @return Earlier time
+ *************************************************************************/
+inline
+CENanoTime CENanoTime::operator-(const std::int64_t& ns) const
+{
+    return CENanoTime(tt_ns_ - ns);
+}
+
+
+/**********************************************************************//**
+ * Return the time elapsed since another time
+ *
+ * @param[in] other         Other time
+ * @return Elapsed time (nanoseconds, SI)
+ *************************************************************************/
+inline
+std::int64_t CENanoTime::operator-(const CENanoTime& other) const
+{
+    return tt_ns_ - other.tt_ns_;
+}
+
+
+/**********************************************************************//**
+ * Comparison operators
+ *************************************************************************/
+inline
+bool operator==(const CENanoTime& lhs, const CENanoTime& rhs)
+{
+    return lhs.tt_ns_ == rhs.tt_ns_;
+}
+
+inline
+bool operator!=(const CENanoTime& lhs, const CENanoTime& rhs)
+{
+    return lhs.tt_ns_ != rhs.tt_ns_;
+}
+
+inline
+bool operator<(const CENanoTime& lhs, const CENanoTime& rhs)
+{
+    return lhs.tt_ns_ < rhs.tt_ns_;
+}
+
+inline
+bool operator<=(const CENanoTime& lhs, const CENanoTime& rhs)
+{
+    return lhs.tt_ns_ <= rhs.tt_ns_;
+}
+
+inline
+bool operator>(const CENanoTime& lhs, const CENanoTime& rhs)
+{
+    return lhs.tt_ns_ > rhs.tt_ns_;
+}
+
+inline
+bool operator>=(const CENanoTime& lhs, const CENanoTime& rhs)
+{
+    return lhs.tt_ns_ >= rhs.tt_ns_;
+}
+
+#endif /* CENanoTime_h */
@@ -25,6 +25,7 @@
 // CppEphem HEAD
 #include "CEBody.h"
 #include "CEDate.h"
+#include "CEDateRange.h"
 #include "CEObserver.h"
 #include "CENamespace.h"
 #include "CESkyCoord.h"
@@ -66,6 +67,7 @@ public:
     virtual void   GetAzimuthZenith_Deg(double *azimuth, double *zenith);
     virtual void   GetApparentXYCoordinate_Rad(double *apparent_X, double *apparent_Y);
     virtual void   GetApparentXYCoordinate_Deg(double *apparent_X, double *apparent_Y);
+    std::vector<CESkyCoord> GetObservedCoords(const CEDateRange& dates) const;
     bool           UpdateCoordinates();
     
 private:
@@ -24,6 +24,7 @@
 
 #include "CEAngle.h"
 #include "CEDate.h"
+#include "CETimeScales.h"
 #include "CENamespace.h"
 
 class CEObserver {
@@ -80,10 +81,15 @@ public:
      * vectors relative to CIRS and ICRS coordinates
      ****************************************************/
     std::vector<double> PositionGeo(void) const;
-    std::vector<double> PositionCIRS(const CEDate& date) const;
-    std::vector<double> PositionICRS(const CEDate& date) const;
-    std::vector<double> VelocityCIRS(const CEDate& date) const;
-    std::vector<double> VelocityICRS(const CEDate& date) const;
+    std::vector<double> PositionCIRS(const CETimeScales& date) const;
+    std::vector<double> PositionICRS(const CETimeScales& date) const;
+    std::vector<double> VelocityCIRS(const CETimeScales& date) const;
+    std::vector<double> VelocityICRS(const CETimeScales& date) const;
+
+    // Incremental updates of the position/velocity for closely spaced dates
+    void   SetIncrementalUpdate(const double& max_error_m=1.0);
+    double IncrementalError_m(void) const;
+    double IncrementalStep_s(void) const;
 
     // Print information about the observer
     std::string print(void) const;
@@ -95,7 +101,20 @@ private:
     void free_members(void);
 
     // Update teh Position and velocity vectors
-    void UpdatePosVel(const CEDate& date) const;
+    void UpdatePosVel(const CETimeScales& date) const;
+    void ClearCache(void) const;
+
+    // Last full evaluation of the position/velocity, which incremental
+    // updates start from
+    struct PosVelReference {
+        bool   valid;       ///< Whether a full evaluation has been done
+        double utc1;        ///< First part of the UTC Julian date
+        double utc2;        ///< Second part of the UTC Julian date
+        double day;         ///< UTC modified Julian day number
+        double era;         ///< Earth rotation angle (radians)
+        double xyz[3];      ///< Position (m) after polar motion, before Earth rotation
+        double ebpv[2][3];  ///< Earth barycentric position (AU) and velocity (AU/day)
+    };
 
     // Variables which define the observers location on Earth
     double longitude_;              ///< Geographic longitude (radians)
@@ -115,6 +134,10 @@ private:
     mutable std::vector<double> vel_cirs_;   ///< XYZ velocity (AU) relative to Earth center
     mutable std::vector<double> vel_icrs_;   ///< XYZ veloicty (AU) relative to solar system barycenter
 
+    // Incremental updates
+    double                  max_error_m_;    ///< Error budget of incremental updates (m), 0 if off
+    mutable PosVelReference ref_;            ///< Last full evaluation
+
     // Variables defining the time of the observer
     double  utc_offset_;            ///< UTC offset in hours (set by default to system offset)
 };
@@ -286,6 +309,7 @@ inline
 void CEObserver::SetElevation(const double& elevation)
 {
     elevation_m_ = elevation ;
+    ClearCache();
 }
 
 
@@ -299,6 +323,7 @@ void CEObserver::SetLongitude(const double& longitude,
                               const CEAngleType&  angle_type)
 {
     longitude_ = longitude * ((angle_type==CEAngleType::RADIANS) ? 1 : DD2R) ;
+    ClearCache();
 }
 
 
@@ -312,6 +337,7 @@ void CEObserver::SetLatitude(const double& latitude,
                              const CEAngleType&  angle_type)
 {
     latitude_ = latitude * ((angle_type==CEAngleType::RADIANS) ? 1 : DD2R) ;
+    ClearCache();
 }
 
 
@@ -396,4 +422,27 @@ void CEObserver::SetWavelength_um(const double& new_wavelength_um)
     wavelength_um_ = new_wavelength_um ;
 }
 
+
+/**********************************************************************//**
+ * Return the error budget of incremental position/velocity updates
+ * 
+ * @return Error budget (meters), zero when incremental updates are off
+ *************************************************************************/
+inline
+double CEObserver::IncrementalError_m(void) const
+{
+    return max_error_m_;
+}
+
+
+/**********************************************************************//**
+ * Forget the cached position/velocity (after the observer has moved)
+ *************************************************************************/
+inline
+void CEObserver::ClearCache(void) const
+{
+    cache_date_ = -1.0e30;
+    ref_.valid  = false;
+}
+
 #endif /* CEObserver_h */
@@ -56,14 +56,18 @@ public:
     virtual double XCoordinate_Deg(double new_date=-1.0e30) const;
     virtual double YCoordinate_Rad(double new_date=-1.0e30) const;
     virtual double YCoordinate_Deg(double new_date=-1.0e30) const;
-    virtual double EarthDist_AU(const CEDate& date);
+    virtual double EarthDist_AU(const CETimeScales& date);
     virtual void   UpdateCoordinates(double new_date=-1.0e30) const;
     virtual void   Update_JPL(double new_date=-1.0e30) const;
+    virtual void   Update_JPL(const CETimeScales& date) const;
     virtual void   Update_SOFA(double new_date=-1.0e30) const;
+    virtual void   Update_SOFA(const CETimeScales& date) const;
     
     // Override CEBody methods
     virtual CESkyCoord ObservedCoords(const CEDate&     date,
                                       const CEObserver& observer) const;
+    virtual CESkyCoord ObservedCoords(const CETimeScales& date,
+                                      const CEObserver&   observer) const;
     
     /****************************
      * Methods for getting the current x,y,z coordinates and velocities relative to the ICRS point
@@ -72,7 +76,7 @@ public:
     double GetYICRS();
     double GetZICRS();
     std::vector<double> PositionICRS(void) const;
-    std::vector<double> PositionICRS_Obs(const CEDate& date) const;
+    std::vector<double> PositionICRS_Obs(const CETimeScales& date) const;
     double GetVxICRS();
     double GetVyICRS();
     double GetVzICRS();
@@ -137,6 +141,7 @@ private:
     void free_members(void);
 
     void UpdatePosition(const double& jd) const;
+    void UpdatePosition(const CETimeScales& date) const;
 
     /******************************************
      * Methods for the JPL algorithm
@@ -38,6 +38,8 @@ public:
     // Some overloaded methods to make sure that the current
     // values are obtained first
     virtual double JD() const;
+    virtual double JD1() const;
+    virtual double JD2() const;
     virtual double MJD() const;
     virtual double Gregorian() const;
     
@@ -47,6 +49,13 @@ public:
     void           ResetTime(void);
     virtual double GetTimerSpeed(void) const;
     virtual void   SetTimerSpeed(const double& scale=1.0);
+
+    // Methods for holding the date at one instant (i.e. for one frame
+    // of a real-time loop)
+    void           Freeze(void);
+    void           Tick(void);
+    void           Thaw(void);
+    bool           IsFrozen(void) const;
     
 private:
 
@@ -54,12 +63,20 @@ private:
     void init_members(void);
     void free_members(void);
 
+    double LiveRunTime(void) const;
+
     /// Variable to hold the starting time. Additional updates will be computed from
     /// this start time.
     std::chrono::high_resolution_clock::time_point start_;
     
     /// Variable that can be used to speed up, slow down, or reverse the rate of time
     double timer_speed_factor_;
+
+    /// Whether the run time is held at 'frozen_runtime_'
+    bool   frozen_;
+
+    /// Run time (seconds) at the last call to Freeze() or Tick()
+    double frozen_runtime_;
 };
 
 
@@ -81,7 +98,8 @@ double CERunningDate::GetTimerSpeed(void) const
 inline
 void CERunningDate::ResetTime(void)
 {
-    start_ = std::chrono::high_resolution_clock::now();
+    start_          = std::chrono::high_resolution_clock::now();
+    frozen_runtime_ = 0.0;
 }
 
 /**********************************************************************//**
@@ -95,6 +113,53 @@ void CERunningDate::SetTimerSpeed(const double& scale)
     timer_speed_factor_ = scale;
 }
 
+/**********************************************************************//**
+ * Hold the date at the current instant
+ * 
+ * Until Tick() or Thaw() is called every method returns this same date, so
+ * that objects which cache results for a date (i.e. CEPlanet, CEObserver)
+ * can reuse them. Calling this on a frozen date does nothing.
+ *************************************************************************/
+inline
+void CERunningDate::Freeze(void)
+{
+    if (!frozen_) Tick();
+}
+
+
+/**********************************************************************//**
+ * Move a frozen date to the current instant (and freeze it if it isn't)
+ *************************************************************************/
+inline
+void CERunningDate::Tick(void)
+{
+    frozen_runtime_ = LiveRunTime();
+    frozen_         = true;
+}
+
+
+/**********************************************************************//**
+ * Let the date follow the clock again after Freeze() or Tick()
+ *************************************************************************/
+inline
+void CERunningDate::Thaw(void)
+{
+    frozen_ = false;
+}
+
+
+/**********************************************************************//**
+ * Get whether the date is held at one instant
+ * 
+ * @return Whether the date is frozen
+ *************************************************************************/
+inline
+bool CERunningDate::IsFrozen(void) const
+{
+    return frozen_;
+}
+
+
 /**********************************************************************//**
  * Return the scaled ellapsed time since this object was created
  * 
@@ -0,0 +1,110 @@
+/***************************************************************************
+ *  CESiderealTime.h: CppEphem                                             *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef CESiderealTime_h
+#define CESiderealTime_h
+
+#include <cstddef>
+
+class CESiderealTime {
+public:
+    // Earth rotation angle
+    static double ERA(const double& ut11,
+                      const double& ut12);
+    static void   ERA(const double*      ut11,
+                      const double*      ut12,
+                      double*            era,
+                      const std::size_t& n);
+
+    // Greenwich mean sidereal time
+    static double GMST(const double& ut11,
+                       const double& ut12,
+                       const double& tt1,
+                       const double& tt2);
+    static void   GMST(const double*      ut11,
+                       const double*      ut12,
+                       const double*      tt1,
+                       const double*      tt2,
+                       double*            gmst,
+                       const std::size_t& n);
+
+    // Greenwich apparent sidereal time
+    static double GAST(const double& ut11,
+                       const double& ut12,
+                       const double& tt1,
+                       const double& tt2);
+    static void   GAST(const double*      ut11,
+                       const double*      ut12,
+                       const double*      tt1,
+                       const double*      tt2,
+                       double*            gast,
+                       const std::size_t& n);
+
+    // Local apparent sidereal time
+    static double LAST(const double& ut11,
+                       const double& ut12,
+                       const double& tt1,
+                       const double& tt2,
+                       const double& longitude);
+    static void   LAST(const double*      ut11,
+                       const double*      ut12,
+                       const double*      tt1,
+                       const double*      tt2,
+                       const double&      longitude,
+                       double*            last,
+                       const std::size_t& n);
+    static void   LAST(const double*      ut11,
+                       const double*      ut12,
+                       const double*      tt1,
+                       const double*      tt2,
+                       const double*      longitude,
+                       double*            last,
+                       const std::size_t& n);
+
+    // Equation of the equinoxes
+    static double EquationOfEquinoxes(const double& tt1,
+                                      const double& tt2);
+    static double SeriesEquationOfEquinoxes(const double& tt1,
+                                            const double& tt2);
+    static double SegmentDays(void);
+
+private:
+    // Number of Chebyshev coefficients per segment and the length of each
+    // segment (days) of the CEChebyshevCache fit. The nutation terms with the shortest periods (~5 days) set
+    // the segment length, the fit is then good to a few 1e-15 radians.
+    static constexpr int    ncoeff_       = 12;
+    static constexpr int    segment_days_ = 4;
+};
+
+
+/**********************************************************************//**
+ * Return the length of the intervals over which the equation of the
+ * equinoxes is fitted
+ *
+ * @return Segment length (days)
+ *************************************************************************/
+inline
+double CESiderealTime::SegmentDays(void)
+{
+    return segment_days_;
+}
+
+#endif /* CESiderealTime_h */
@@ -31,6 +31,7 @@
 #include "CENamespace.h"
 #include "CEException.h"
 #include "CEObserver.h"
+#include "CETimeScales.h"
 #include "CECoordinates.h"
 
 // SOFA HEADER
@@ -92,105 +93,107 @@ public:
     // Note that whenever a date is required, the default will be set to the
     // start of the J2000 epoch (January 1, 2000 at 12:00 GMT). This corresponds
     // to the Julian Date of 2451545.0.
+    // Dates are taken as CETimeScales, which a CEDate converts to implicitly.
+    // Pass a CETimeScales directly to reuse it for several conversions.
     
     // Convert from CIRS to other coordinates
-    static void CIRS2ICRS(const CESkyCoord& in_cirs, 
-                          CESkyCoord*       out_icrs,
-                          const CEDate&     date=CEDate());
-    static void CIRS2Galactic(const CESkyCoord& in_cirs,
-                              CESkyCoord*       out_galactic,
-                              const CEDate&     date=CEDate());
-    static void CIRS2Observed(const CESkyCoord& in_cirs,
-                              CESkyCoord*       out_observed,
-                              const CEDate&     date,
-                              const CEObserver& observer,
-                              CESkyCoord*       observed_cirs=nullptr,
-                              CEAngle*          hour_angle=nullptr);
-    static void CIRS2Ecliptic(const CESkyCoord& in_cirs,
-                              CESkyCoord*       out_ecliptic,
-                              const CEDate&     date=CEDate());
+    static void CIRS2ICRS(const CESkyCoord&   in_cirs,
+                          CESkyCoord*         out_icrs,
+                          const CETimeScales& date=CETimeScales());
+    static void CIRS2Galactic(const CESkyCoord&   in_cirs,
+                              CESkyCoord*         out_galactic,
+                              const CETimeScales& date=CETimeScales());
+    static void CIRS2Observed(const CESkyCoord&   in_cirs,
+                              CESkyCoord*         out_observed,
+                              const CETimeScales& date,
+                              const CEObserver&   observer,
+                              CESkyCoord*         observed_cirs=nullptr,
+                              CEAngle*            hour_angle=nullptr);
+    static void CIRS2Ecliptic(const CESkyCoord&   in_cirs,
+                              CESkyCoord*         out_ecliptic,
+                              const CETimeScales& date=CETimeScales());
 
     // Convert from ICRS to other coordinates
-    static void ICRS2CIRS(const CESkyCoord& in_icrs,
-                          CESkyCoord*       out_cirs,
-                          const CEDate&     date=CEDate());
+    static void ICRS2CIRS(const CESkyCoord&   in_icrs,
+                          CESkyCoord*         out_cirs,
+                          const CETimeScales& date=CETimeScales());
     static void ICRS2Galactic(const CESkyCoord& in_icrs,
                               CESkyCoord*       out_galactic);
-    static void ICRS2Observed(const CESkyCoord& in_icrs,
-                              CESkyCoord*       out_observed,
-                              const CEDate&     date,
-                              const CEObserver& observer,
-                              CESkyCoord*       observed_cirs=nullptr,
-                              CEAngle*          hour_angle=nullptr);
-    static void ICRS2Ecliptic(const CESkyCoord& in_icrs,
-                              CESkyCoord*       out_ecliptic,
-                              const CEDate&     date=CEDate());
+    static void ICRS2Observed(const CESkyCoord&   in_icrs,
+                              CESkyCoord*         out_observed,
+                              const CETimeScales& date,
+                              const CEObserver&   observer,
+                              CESkyCoord*         observed_cirs=nullptr,
+                              CEAngle*            hour_angle=nullptr);
+    static void ICRS2Ecliptic(const CESkyCoord&   in_icrs,
+                              CESkyCoord*         out_ecliptic,
+                              const CETimeScales& date=CETimeScales());
 
     // Convert from GALACTIC to other coordinates
-    static void Galactic2CIRS(const CESkyCoord& in_galactic,
-                              CESkyCoord*       out_cirs,
-                              const CEDate&     date=CEDate());
+    static void Galactic2CIRS(const CESkyCoord&   in_galactic,
+                              CESkyCoord*         out_cirs,
+                              const CETimeScales& date=CETimeScales());
     static void Galactic2ICRS(const CESkyCoord& in_galactic,
                               CESkyCoord*       out_icrs);
-    static void Galactic2Observed(const CESkyCoord& in_galactic,
-                                  CESkyCoord*       out_observed,
-                                  const CEDate&     date,
-                                  const CEObserver& observer,
-                                  CESkyCoord*       observed_galactic=nullptr,
-                                  CEAngle*          hour_angle=nullptr);
-    static void Galactic2Ecliptic(const CESkyCoord& in_galactic,
-                                  CESkyCoord*       out_ecliptic,
-                                  const CEDate&     date=CEDate());
+    static void Galactic2Observed(const CESkyCoord&   in_galactic,
+                                  CESkyCoord*         out_observed,
+                                  const CETimeScales& date,
+                                  const CEObserver&   observer,
+                                  CESkyCoord*         observed_galactic=nullptr,
+                                  CEAngle*            hour_angle=nullptr);
+    static void Galactic2Ecliptic(const CESkyCoord&   in_galactic,
+                                  CESkyCoord*         out_ecliptic,
+                                  const CETimeScales& date=CETimeScales());
 
     // Convert from OBSERVED to other coordinates
-    static void Observed2CIRS(const CESkyCoord& in_observed,
-                              CESkyCoord*       out_cirs,
-                              const CEDate&     date,
-                              const CEObserver& observer);
-    static void Observed2ICRS(const CESkyCoord& in_observed,
-                              CESkyCoord*       out_icrs,
-                              const CEDate&     date,
-                              const CEObserver& observer);
-    static void Observed2Galactic(const CESkyCoord& in_observed,
-                                  CESkyCoord*       out_galactic,
-                                  const CEDate&     date,
-                                  const CEObserver& observer);
-    static void Observed2Ecliptic(const CESkyCoord& in_observed,
-                                  CESkyCoord*       out_ecliptic,
-                                  const CEDate&     date,
-                                  const CEObserver& observer);
+    static void Observed2CIRS(const CESkyCoord&   in_observed,
+                              CESkyCoord*         out_cirs,
+                              const CETimeScales& date,
+                              const CEObserver&   observer);
+    static void Observed2ICRS(const CESkyCoord&   in_observed,
+                              CESkyCoord*         out_icrs,
+                              const CETimeScales& date,
+                              const CEObserver&   observer);
+    static void Observed2Galactic(const CESkyCoord&   in_observed,
+                                  CESkyCoord*         out_galactic,
+                                  const CETimeScales& date,
+                                  const CEObserver&   observer);
+    static void Observed2Ecliptic(const CESkyCoord&   in_observed,
+                                  CESkyCoord*         out_ecliptic,
+                                  const CETimeScales& date,
+                                  const CEObserver&   observer);
 
     // Convert from ECLIPTIC to other coordinates
-    static void Ecliptic2CIRS(const CESkyCoord& in_ecliptic,
-                              CESkyCoord*       out_cirs,
-                              const CEDate&     date=CEDate());
-    static void Ecliptic2ICRS(const CESkyCoord& in_ecliptic,
-                              CESkyCoord*       out_icrs,
-                              const CEDate&     date=CEDate());
-    static void Ecliptic2Galactic(const CESkyCoord& in_ecliptic,
-                                  CESkyCoord*       out_galactic,
-                                  const CEDate&     date=CEDate());
-    static void Ecliptic2Observed(const CESkyCoord& in_ecliptic,
-                                  CESkyCoord*       out_observed,
-                                  const CEDate&     date,
-                                  const CEObserver& observer);
+    static void Ecliptic2CIRS(const CESkyCoord&   in_ecliptic,
+                              CESkyCoord*         out_cirs,
+                              const CETimeScales& date=CETimeScales());
+    static void Ecliptic2ICRS(const CESkyCoord&   in_ecliptic,
+                              CESkyCoord*         out_icrs,
+                              const CETimeScales& date=CETimeScales());
+    static void Ecliptic2Galactic(const CESkyCoord&   in_ecliptic,
+                                  CESkyCoord*         out_galactic,
+                                  const CETimeScales& date=CETimeScales());
+    static void Ecliptic2Observed(const CESkyCoord&   in_ecliptic,
+                                  CESkyCoord*         out_observed,
+                                  const CETimeScales& date,
+                                  const CEObserver&   observer);
 
     /*********************************************************
      * More generic methods for converting between coordinate types
      *********************************************************/
     CESkyCoord ConvertTo(const CESkyCoordType&  output_coord_type,
-                         const CEDate&          date=CEDate(),
+                         const CETimeScales&    date=CETimeScales(),
                          const CEObserver&      observer=CEObserver());
-    CESkyCoord ConvertToCIRS(const CEDate&     date=CEDate(),
-                             const CEObserver& observer=CEObserver());
-    CESkyCoord ConvertToICRS(const CEDate&     date=CEDate(),
-                             const CEObserver& observer=CEObserver());
-    CESkyCoord ConvertToGalactic(const CEDate&     date=CEDate(),
-                                 const CEObserver& observer=CEObserver());
-    CESkyCoord ConvertToObserved(const CEDate&     date=CEDate(),
-                                 const CEObserver& observer=CEObserver());
-    CESkyCoord ConvertToEcliptic(const CEDate&     date=CEDate(),
-                                 const CEObserver& observer=CEObserver());
+    CESkyCoord ConvertToCIRS(const CETimeScales& date=CETimeScales(),
+                             const CEObserver&   observer=CEObserver());
+    CESkyCoord ConvertToICRS(const CETimeScales& date=CETimeScales(),
+                             const CEObserver&   observer=CEObserver());
+    CESkyCoord ConvertToGalactic(const CETimeScales& date=CETimeScales(),
+                                 const CEObserver&   observer=CEObserver());
+    CESkyCoord ConvertToObserved(const CETimeScales& date=CETimeScales(),
+                                 const CEObserver&   observer=CEObserver());
+    CESkyCoord ConvertToEcliptic(const CETimeScales& date=CETimeScales(),
+                                 const CEObserver&   observer=CEObserver());
 
     /*********************************************************
      * Methods for setting the coordinates of this object
@@ -0,0 +1,58 @@
+/***************************************************************************
+ *  CETdbTt.h: CppEphem                                                    *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef CETdbTt_h
+#define CETdbTt_h
+
+#include <cstddef>
+
+class CETdbTt {
+public:
+    static double TdbTt(const double& tt1,
+                        const double& tt2);
+    static void   TdbTt(const double*      tt1,
+                        const double*      tt2,
+                        double*            dtr,
+                        const std::size_t& n);
+    static double SeriesTdbTt(const double& tt1,
+                              const double& tt2);
+    static double SegmentDays(void);
+
+private:
+    // Number of Chebyshev coefficients per segment and the length of each
+    // segment (days) of the CEChebyshevCache fit. This keeps the fit within a few picoseconds of the series.
+    static constexpr int    ncoeff_       = 12;
+    static constexpr int    segment_days_ = 16;
+};
+
+
+/**********************************************************************//**
+ * Return the length of the intervals over which TDB-TT is fitted
+ *
+ * @return Segment length (days)
+ *************************************************************************/
+inline
+double CETdbTt::SegmentDays(void)
+{
+    return segment_days_;
+}
+
+#endif /* CETdbTt_h */
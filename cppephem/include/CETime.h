@@ -23,6 +23,7 @@
 #define CETime_h
 
 #include <cmath>
+#include <cstdint>
 #include <stdio.h>
 #include <vector>
 
@@ -59,6 +60,7 @@ public:
     double Min(void) const;
     double Sec(void) const;
 
+    static void   CurrentUnixDay(std::int64_t* day, std::int64_t* nanosec) ;
     static double CurrentUTC() ;
     static std::vector<double> CurrentUTC_vect() ;
     static double UTC(const double& jd) ;
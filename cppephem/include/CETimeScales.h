@@ -0,0 +1,251 @@
+/***************************************************************************
+ *  CETimeScales.h: CppEphem                                               *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef CETimeScales_h
+#define CETimeScales_h
+
+#include <atomic>
+
+// CppEphem HEADERS
+#include "CEDate.h"
+#include "CENamespace.h"
+
+class CETimeScales {
+public:
+    CETimeScales(const double&     date=CEDate::CurrentJD(), 
+                 const CEDateType& date_format=CEDateType::JD);
+    CETimeScales(const CEDate& date);
+    CETimeScales(const double& mjd, const CEEop& eop);
+    CETimeScales(const CETimeScales& other);
+    virtual ~CETimeScales();
+
+    CETimeScales& operator=(const CETimeScales& other);
+
+    // Methods for changing the date
+    void SetDate(const CEDate& date);
+    void SetDate(const double& mjd, const CEEop& eop);
+    void SetDate(const double& utc1, const double& utc2, const CEEop& eop);
+
+    /***********************************************************
+     * Methods for getting the date in the various time scales.
+     * Each time is a two-part Julian date, as used by SOFA.
+     ***********************************************************/
+    double       MJD(void) const;
+    double       JD(void) const;
+    const CEEop& eop(void) const;
+    double       UTC1(void) const;
+    double       UTC2(void) const;
+    double       UT11(void) const;
+    double       UT12(void) const;
+    double       TAI1(void) const;
+    double       TAI2(void) const;
+    double       TT1(void) const;
+    double       TT2(void) const;
+    double       TDB1(void) const;
+    double       TDB2(void) const;
+    double       ERA(void) const;
+
+private:
+
+    // Fills in the time scales it computed for a range of dates
+    friend class CEDateRange;
+
+    void free_members(void);
+    void copy_members(const CETimeScales& other);
+    void init_members(void);
+    void compute(void) const;
+
+    // States of the computed time scales
+    enum ScalesState {SCALES_UNSET,             ///< Not computed yet
+                      SCALES_BUSY,              ///< Being computed by compute()
+                      SCALES_SET};              ///< Computed
+
+    double utc1_;               ///< UTC (first part)
+    double utc2_;               ///< UTC (second part)
+    bool   has_eop_;            ///< Whether 'eop_' was given rather than looked up
+
+    // The time scales are only computed when first asked for. The values
+    // below are only read once 'state_' is set (with acquire/release
+    // ordering), so a const object can be shared by threads.
+    mutable std::atomic<int> state_; ///< ::ScalesState of the values below
+    mutable CEEop  eop_;        ///< Earth orientation parameters at the date
+    mutable double ut11_;       ///< UT1 (first part)
+    mutable double ut12_;       ///< UT1 (second part)
+    mutable double tai1_;       ///< TAI (first part)
+    mutable double tai2_;       ///< TAI (second part)
+    mutable double tt1_;        ///< TT (first part)
+    mutable double tt2_;        ///< TT (second part)
+    mutable double tdb1_;       ///< TDB (first part)
+    mutable double tdb2_;       ///< TDB (second part)
+    mutable double era_;        ///< Earth rotation angle (radians)
+};
+
+
+/**********************************************************************//**
+ * Return the UTC modified Julian date
+ *************************************************************************/
+inline
+double CETimeScales::MJD(void) const
+{
+    return (utc1_ - DJM0) + utc2_;
+}
+
+
+/**********************************************************************//**
+ * Return the UTC Julian date
+ *************************************************************************/
+inline
+double CETimeScales::JD(void) const
+{
+    return utc1_ + utc2_;
+}
+
+
+/**********************************************************************//**
+ * Return the Earth orientation parameters used for the time scales
+ *************************************************************************/
+inline
+const CEEop& CETimeScales::eop(void) const
+{
+    if (state_.load(std::memory_order_acquire) != SCALES_SET) compute();
+    return eop_;
+}
+
+
+/**********************************************************************//**
+ * Return the first part of the UTC Julian date
+ *************************************************************************/
+inline
+double CETimeScales::UTC1(void) const
+{
+    return utc1_;
+}
+
+
+/**********************************************************************//**
+ * Return the second part of the UTC Julian date
+ *************************************************************************/
+inline
+double CETimeScales::UTC2(void) const
+{
+    return utc2_;
+}
+
+
+/**********************************************************************//**
+ * Return the first part of the UT1 Julian date
+ *************************************************************************/
+inline
+double CETimeScales::UT11(void) const
+{
+    if (state_.load(std::memory_order_acquire) != SCALES_SET) compute();
+    return ut11_;
+}
+
+
+/**********************************************************************//**
+ * Return the second part of the UT1 Julian date
+ *************************************************************************/
+inline
+double CETimeScales::UT12(void) const
+{
+    if (state_.load(std::memory_order_acquire) != SCALES_SET) compute();
+    return ut12_;
+}
+
+
+/**********************************************************************//**
+ * Return the first part of the TAI Julian date
+ *************************************************************************/
+inline
+double CETimeScales::TAI1(void) const
+{
+    if (state_.load(std::memory_order_acquire) != SCALES_SET) compute();
+    return tai1_;
+}
+
+
+/**********************************************************************//**
+ * Return the second part of the TAI Julian date
+ *************************************************************************/
+inline
+double CETimeScales::TAI2(void) const
+{
+    if (state_.load(std::memory_order_acquire) != SCALES_SET) compute();
+    return tai2_;
+}
+
+
+/**********************************************************************//**
+ * Return the first part of the TT Julian date
+ *************************************************************************/
+inline
+double CETimeScales::TT1(void) const
+{
+    if (state_.load(std::memory_order_acquire) != SCALES_SET) compute();
+    return tt1_;
+}
+
+
+/**********************************************************************//**
+ * Return the second part of the TT Julian date
+ *************************************************************************/
+inline
+double CETimeScales::TT2(void) const
+{
+    if (state_.load(std::memory_order_acquire) != SCALES_SET) compute();
+    return tt2_;
+}
+
+
+/**********************************************************************//**
+ * Return the first part of the TDB Julian date
+ *************************************************************************/
+inline
+double CETimeScales::TDB1(void) const
+{
+    if (state_.load(std::memory_order_acquire) != SCALES_SET) compute();
+    return tdb1_;
+}
+
+
+/**********************************************************************//**
+ * Return the second part of the TDB Julian date
+ *************************************************************************/
+inline
+double CETimeScales::TDB2(void) const
+{
+    if (state_.load(std::memory_order_acquire) != SCALES_SET) compute();
+    return tdb2_;
+}
+
+
+/**********************************************************************//**
+ * Return the Earth rotation angle (radians)
+ *************************************************************************/
+inline
+double CETimeScales::ERA(void) const
+{
+    if (state_.load(std::memory_order_acquire) != SCALES_SET) compute();
+    return era_;
+}
+
+#endif /* CETimeScales_h */
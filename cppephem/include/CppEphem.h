@@ -31,12 +31,18 @@
 #include "CEAngle.h"
 #include "CECoordinates.h"
 #include "CEDate.h"
+#include "CEDateRange.h"
+#include "CELeapSeconds.h"
 #include "CENamespace.h"
+#include "CENanoTime.h"
 #include "CEObservation.h"
 #include "CEObserver.h"
 #include "CEPlanet.h"
 #include "CERunningDate.h"
+#include "CESiderealTime.h"
 #include "CESkyCoord.h"
+#include "CETdbTt.h"
 #include "CETime.h"
+#include "CETimeScales.h"
 
 #endif /* CppEphem_h */
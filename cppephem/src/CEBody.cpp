@@ -130,7 +130,22 @@ CEBody& CEBody::operator=(const CEBody& other)
 CESkyCoord CEBody::ObservedCoords(const CEDate&     date,
                                   const CEObserver& observer) const
 {
-    CESkyCoord coords_icrs = GetCoordinates(date);
+    return ObservedCoords(CETimeScales(date), observer);
+}
+
+
+/**********************************************************************//**
+ * Computes the observed coordinates for this object on a date whose time
+ * scales are already known (i.e. one date of a CEDateRange)
+ * 
+ * @param[in] date          Date
+ * @param[in] observer      Observer
+ * @return Observed coordinates
+ *************************************************************************/
+CESkyCoord CEBody::ObservedCoords(const CETimeScales& date,
+                                  const CEObserver&   observer) const
+{
+    CESkyCoord coords_icrs = GetCoordinates(CEDate(date.JD()));
     return coords_icrs.ConvertToObserved(date, observer);
 }                                         
 
@@ -30,28 +30,193 @@
  The downloaded file will be stored locally to prevent the need to re-download 
  it every time it is needed in the future.
 
+ The first time a corrections file is parsed, the parsed columns are also
+ written to a compact binary file next to it (see NutationCacheFile() and
+ TtUt1CacheFile()). Later runs memory map that file read-only instead of
+ parsing the text again, which also lets concurrent processes share the
+ same pages. The binary file records the size and modification time of
+ the text files it was built from and is ignored once they change.
+
+ When CppEphem is configured with '-Dembedcorr=ON' the tables shipped in
+ share/ are also compiled into the library. They are used in place of any
+ of the default corrections files that cannot be found, so the library
+ works without the share directory or network access.
+
  IMPORTANT NOTE: These correction values should only be accessed through the 
  CppEphem namespace, and not by directly querying this class. This prevents
- creating multiple CECorrections objects that could be resource intensive.
+ creating multiple CECorrections objects that each load their own tables.
+ Copying an object is cheap however: the loaded tables are immutable and
+ reference counted, so copies share them and only the filenames and
+ interpolation setting are per-object.
+
+ Thread safety: the correction tables are loaded once and then published
+ as immutable snapshots through an atomic pointer. Lookups only read the
+ published tables and keep their cached values in thread-local storage,
+ so the correction methods can be called concurrently from any number of
+ threads without locking.
+
+ Dates that are not covered by a table throw CEException::invalid_value
+ by default. SetExtrap() can instead have the values extrapolated (see
+ ::CEExtrapType), in which case eop() and the batched lookups report
+ which values were extrapolated. CEExtrapType::BULLETIN_A continues the
+ table with the closed form long-term predictions of IERS Bulletin A:
+ UT1-UTC follows its recent drift plus the seasonal UT2-UT1 model, and
+ the polar motion follows the annual and Chandler wobble terms, both
+ anchored to the last row. The celestial pole offsets keep their last
+ values and TT-UT1 follows its trend over the last year of the table.
+
+ Programs that only need corrections for a limited period can declare it
+ with SetMJDRange(). Tables that are parsed from the text files then only
+ keep the rows for that period (plus a few rows either side so that the
+ interpolation is unaffected), which saves memory and parse time. A
+ lookup outside of the range transparently extends it and reloads the
+ table. Near the edges of a restricted table the cubic spline can differ
+ very slightly from the one through the full table.
+
+ Stats() (or StatsJSON()) reports how often the tables were loaded and
+ how long that took, along with the number of lookups, cache hits and
+ misses, dates outside of the tables and interpolations. The counters are
+ relaxed atomics, cheap enough to be left enabled.
+
+ Loading the tables (and possibly downloading them) takes long enough to
+ be noticed by whichever lookup comes first. Prefetch() loads them on a
+ background thread instead, so that this can overlap with the rest of an
+ application's start up. Lookups that need a table before the prefetch
+ is done wait for it rather than loading the table a second time.
+
+ Long running programs can pick up updated correction files by calling
+ Reload(), or by enabling SetWatchFiles() (Linux only) which reloads a
+ table as soon as one of its files is rewritten or moved into place. The
+ new table is parsed in the background and then swapped in, so lookups in
+ progress keep using the previous table and never wait for the parse.
  */
 
 #include "CECorrections.h"
 #include "CEDate.h"
 #include "CEException.h"
 #include <sofam.h>
+#include <algorithm>
 #include <exception>
 #include <iostream>
+#include <chrono>
+#include <cerrno>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
 
 #ifndef NOCURL
 #include <curl/curl.h>
 #endif
 
+#ifdef CE_EMBED_CORRECTIONS
+// Shipped corrections tables compiled into the library
+// (generated by EmbedCorrections.cmake)
+extern const std::size_t          ce_embedded_count;
+extern const char* const          ce_embedded_names[];
+extern const unsigned char* const ce_embedded_data[];
+extern const std::size_t          ce_embedded_sizes[];
+#endif
+
 // #ifndef CECORRFILEPATH
 // #define CECORRFILEPATH std::string("")
 // #endif
 
+namespace {
+
+    // Identifies the state of a source file so that stale binary caches
+    // can be detected
+    struct CEFileStamp {
+        std::int64_t size;
+        std::int64_t mtime_sec;
+        std::int64_t mtime_nsec;
+    };
+
+    // Header of a binary corrections cache. The header is followed by
+    // 'ncols' contiguous columns, each holding 'nrows' doubles.
+    struct CEBinaryHeader {
+        char          magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint64_t ncols;
+        std::uint64_t nrows;
+        CEFileStamp   sources[2];
+    };
+
+    const char          cache_magic[8]   = {'C','E','E','O','P','T','B','L'};
+    const std::uint32_t cache_version    = 1;
+    const std::uint32_t cache_byte_order = 0x01020304;
+
+    bool GetFileStamp(const std::string& filename, CEFileStamp* stamp);
+    std::shared_ptr<const void> MapBinaryTable(const std::string&              filename,
+                                               const std::vector<std::string>& sources,
+                                               const std::size_t&              ncols,
+                                               std::size_t*                    nrows,
+                                               const double**                  columns);
+    void WriteBinaryTable(const std::string&              filename,
+                          const std::vector<std::string>& sources,
+                          const std::size_t&              ncols,
+                          const std::size_t&              nrows,
+                          const double*                   columns);
+
+    // A single line inside of a text buffer (not including the newline)
+    struct CETextLine {
+        const char* begin;
+        const char* end;
+    };
+
+    bool ReadTextFile(std::ifstream& file, std::vector<char>* buffer);
+    bool GetEmbeddedFile(const std::string& filename, std::vector<char>* buffer);
+    bool NextLine(const char** pos, const char* end, CETextLine* line);
+    bool ScanInt(const CETextLine& line, const std::size_t& start,
+                 const std::size_t& width, int* value);
+    bool ScanDouble(const CETextLine& line, const std::size_t& start,
+                    const std::size_t& width, double* value);
+    const char* FindDailyRow(const char* begin, const char* end,
+                             const std::size_t& start, const std::size_t& width,
+                             const double& mjd);
+    double Seconds(const std::chrono::steady_clock::time_point& start);
+    std::string TableStatsJSON(const CETableStats& stats);
+
+    // IERS Bulletin A long-term prediction terms
+    double SeasonalUT2UT1(const double& mjd);
+    void   PolarMotionTerms(const double& mjd, double* xp, double* yp);
+
+    // Extra rows kept either side of a restricted range of dates
+    const double      nutation_margin = 10.0;   // days
+    const std::size_t ttut1_margin    = 4;      // rows
+
+    // Rows at a cut off end of a table that lookups don't use, since the
+    // spline there depends on the rows that were left out
+    const std::size_t edge_rows = 2;
+    void ExtendRange(const double& mjd_min, const double& mjd_max,
+                     double* range_min, double* range_max);
+
+    // Number of tables in memory, decremented when a table is freed
+    std::atomic<std::uint64_t> nutation_tables(0);
+    std::atomic<std::uint64_t> ttut1_tables(0);
+}
+
+// Per-thread lookup caches
+thread_local CECorrections::NutationCache CECorrections::cache_nut_ = 
+    {nullptr, 0, nullptr, CEInterpType::NONE, CEExtrapType::NONE, CELookupStatus::TABLE,
+     -1.0e30, 0.0, 0.0, 0.0, 0.0, 0.0};
+thread_local CECorrections::TtUt1Cache CECorrections::cache_ttut1_ = 
+    {nullptr, 0, nullptr, CEInterpType::NONE, CEExtrapType::NONE, CELookupStatus::TABLE,
+     -1.0e30, 63.8285};
+
 
 /**********************************************************************//**
  * Constructor for coordinate corrections object
@@ -67,10 +232,20 @@ CECorrections::CECorrections()
  *************************************************************************/
 CECorrections::CECorrections(const CECorrections& other)
 {
+    init_members();
     copy_members(other);
 }
 
 
+/**********************************************************************//**
+ * Destructor
+ *************************************************************************/
+CECorrections::~CECorrections()
+{
+    free_members();
+}
+
+
 /**********************************************************************//**
  * Return the DUT1 correction parameter (represents UT1 - UTC in seconds)
  * 
@@ -79,11 +254,8 @@ CECorrections::CECorrections(const CECorrections& other)
  *************************************************************************/
 double CECorrections::dut1(const double& mjd) const
 {
-    // Update the cache
-    UpdateNutationCache(mjd);
-    
-    // return cached value
-    return cache_nut_dut1_;
+    // Return the (possibly cached) value
+    return UpdateNutationCache(mjd).dut1;
 }
 
 
@@ -95,11 +267,8 @@ double CECorrections::dut1(const double& mjd) const
  *************************************************************************/
 double CECorrections::xpolar(const double& mjd) const
 {
-    // Update the cache
-    UpdateNutationCache(mjd);
-
-    // return cached value
-    return cache_nut_xp_;
+    // Return the (possibly cached) value
+    return UpdateNutationCache(mjd).xp;
 }
 
 
@@ -111,11 +280,8 @@ double CECorrections::xpolar(const double& mjd) const
  *************************************************************************/
 double CECorrections::ypolar(const double& mjd) const
 {
-    // Update the cache
-    UpdateNutationCache(mjd);
-
-    // return cached value
-    return cache_nut_yp_;
+    // Return the (possibly cached) value
+    return UpdateNutationCache(mjd).yp;
 }
 
 
@@ -127,11 +293,8 @@ double CECorrections::ypolar(const double& mjd) const
  *************************************************************************/
 double CECorrections::deps(const double& mjd) const
 {
-    // Update the cache
-    UpdateTtUt1Cache(mjd);
-
-    // return cached value
-    return cache_nut_deps_;
+    // Return the (possibly cached) value
+    return UpdateNutationCache(mjd).deps;
 }
 
 
@@ -143,11 +306,8 @@ double CECorrections::deps(const double& mjd) const
  *************************************************************************/
 double CECorrections::dpsi(const double& mjd) const
 {
-    // Update the cache
-    UpdateTtUt1Cache(mjd);
-
-    // return cached value
-    return cache_nut_dpsi_;
+    // Return the (possibly cached) value
+    return UpdateNutationCache(mjd).dpsi;
 }
 
 
@@ -159,539 +319,2577 @@ double CECorrections::dpsi(const double& mjd) const
  *************************************************************************/
 double CECorrections::ttut1(const double& mjd) const
 {
-    // Update the cache
-    UpdateTtUt1Cache(mjd);
-
-    // return cached value
-    return cache_ttut1_delt_;
+    // Return the (possibly cached) value
+    return UpdateTtUt1Cache(mjd).delt;
 }
 
 
 /**********************************************************************//**
- * Overloaded assignment operator
+ * Fill an array with the DUT1 correction for an array of dates
  * 
- * @param[in] other     CECorrections object to be copied
- * @return Reference to this object post-assignment
+ * @param[in]  mjd      Modified Julian dates
+ * @param[out] values   DUT1 correction for each date (UT1 - UTC in seconds)
+ * @param[in]  n        Number of dates
+ * @param[out] status   Where each value came from (optional)
+ * 
+ * Batched lookups do not touch the single value cache, so they are cheaper
+ * than calling dut1(const double&) for every date of an event list. They
+ * are fastest when @p mjd is sorted.
  *************************************************************************/
-CECorrections& CECorrections::operator=(const CECorrections& other)
+void CECorrections::dut1(const double* mjd, double* values, const std::size_t& n,
+                         CELookupStatus* status) const
 {
-    if (this != &other) {
-        free_members();
-        init_members();
-        copy_members(other);
-    }
-    return *this;
+    std::shared_ptr<const NutationTable> ref    = Nutation(mjd, n);
+    const NutationTable&                 table  = *ref;
+    CEExtrapType                         extrap = extrap_.load(std::memory_order_relaxed);
+    BatchLookup(table.mjd, table.dut1, table.size, table.index,
+                &table.spline[0], 20, mjd, values, n, status,
+                ExtrapFunction(table, table.dut1, extrap), &nutation_stats_);
 }
 
 
 /**********************************************************************//**
- * Sets the name of the nutation corrections file
+ * Fill an array with the x-polar motion for an array of dates
  * 
- * @param[in] filename      Filename to read/write corrections from/to
+ * @param[in]  mjd      Modified Julian dates
+ * @param[out] values   x-polar motion for each date (radians)
+ * @param[in]  n        Number of dates
+ * @param[out] status   Where each value came from (optional)
  *************************************************************************/
-void CECorrections::SetNutationFile(const std::string& filename)
+void CECorrections::xpolar(const double* mjd, double* values, const std::size_t& n,
+                           CELookupStatus* status) const
 {
-    nutation_file_ = filename;
+    std::shared_ptr<const NutationTable> ref    = Nutation(mjd, n);
+    const NutationTable&                 table  = *ref;
+    CEExtrapType                         extrap = extrap_.load(std::memory_order_relaxed);
+    BatchLookup(table.mjd, table.xp, table.size, table.index,
+                &table.spline[4], 20, mjd, values, n, status,
+                ExtrapFunction(table, table.xp, extrap), &nutation_stats_);
 }
 
 
 /**********************************************************************//**
- * Sets the name of the historic values TT-UT1 corrections file
+ * Fill an array with the y-polar motion for an array of dates
  * 
- * @param[in] filename      Filename to read/write corrections from/to
+ * @param[in]  mjd      Modified Julian dates
+ * @param[out] values   y-polar motion for each date (radians)
+ * @param[in]  n        Number of dates
+ * @param[out] status   Where each value came from (optional)
  *************************************************************************/
-void CECorrections::SetTtUt1HistFile(const std::string& filename)
+void CECorrections::ypolar(const double* mjd, double* values, const std::size_t& n,
+                           CELookupStatus* status) const
 {
-    ttut1_file_hist_ = filename;
+    std::shared_ptr<const NutationTable> ref    = Nutation(mjd, n);
+    const NutationTable&                 table  = *ref;
+    CEExtrapType                         extrap = extrap_.load(std::memory_order_relaxed);
+    BatchLookup(table.mjd, table.yp, table.size, table.index,
+                &table.spline[8], 20, mjd, values, n, status,
+                ExtrapFunction(table, table.yp, extrap), &nutation_stats_);
 }
 
 
 /**********************************************************************//**
- * Sets the name of the predicted values TT-UT1 corrections file
+ * Fill an array with the obliquity correction for an array of dates
  * 
- * @param[in] filename      Filename to read/write corrections from/to
+ * @param[in]  mjd      Modified Julian dates
+ * @param[out] values   Obliquity correction for each date (radians)
+ * @param[in]  n        Number of dates
+ * @param[out] status   Where each value came from (optional)
  *************************************************************************/
-void CECorrections::SetTtUt1PredFile(const std::string& filename)
+void CECorrections::deps(const double* mjd, double* values, const std::size_t& n,
+                         CELookupStatus* status) const
 {
-    ttut1_file_pred_ = filename;
+    std::shared_ptr<const NutationTable> ref    = Nutation(mjd, n);
+    const NutationTable&                 table  = *ref;
+    CEExtrapType                         extrap = extrap_.load(std::memory_order_relaxed);
+    BatchLookup(table.mjd, table.deps, table.size, table.index,
+                &table.spline[12], 20, mjd, values, n, status,
+                ExtrapFunction(table, table.deps, extrap), &nutation_stats_);
 }
 
 
 /**********************************************************************//**
- * Defines that the correction values should be interpolated
+ * Fill an array with the longitude correction for an array of dates
  * 
- * @param[in] set_interp        New interpolation boolean
+ * @param[in]  mjd      Modified Julian dates
+ * @param[out] values   Longitude correction for each date (radians)
+ * @param[in]  n        Number of dates
+ * @param[out] status   Where each value came from (optional)
  *************************************************************************/
-void CECorrections::SetInterp(bool set_interp)
+void CECorrections::dpsi(const double* mjd, double* values, const std::size_t& n,
+                         CELookupStatus* status) const
 {
-    // Only update if the value is different
-    if (set_interp != interp_) {
-        interp_ = set_interp;
-        // Update cached dates to force recompute
-        cache_nut_mjd_   = -1.0e30;
-        cache_ttut1_mjd_ = -1.0e30;
-    }
+    std::shared_ptr<const NutationTable> ref    = Nutation(mjd, n);
+    const NutationTable&                 table  = *ref;
+    CEExtrapType                         extrap = extrap_.load(std::memory_order_relaxed);
+    BatchLookup(table.mjd, table.dpsi, table.size, table.index,
+                &table.spline[16], 20, mjd, values, n, status,
+                ExtrapFunction(table, table.dpsi, extrap), &nutation_stats_);
 }
 
 
 /**********************************************************************//**
- * Free data member objects
+ * Fill an array with the TT-UT1 correction for an array of dates
+ * 
+ * @param[in]  mjd      Modified Julian dates
+ * @param[out] values   TT-UT1 for each date (seconds)
+ * @param[in]  n        Number of dates
+ * @param[out] status   Where each value came from (optional)
  *************************************************************************/
-void CECorrections::free_members(void)
+void CECorrections::ttut1(const double* mjd, double* values, const std::size_t& n,
+                          CELookupStatus* status) const
 {
-    // Clear the nutation vectors
-    nutation_mjd_.clear();
-    nutation_dut1_.clear();
-    nutation_xp_.clear();
-    nutation_yp_.clear();
-    nutation_deps_.clear();
-    nutation_dpsi_.clear();
-
-    // Clear the TT-UT1 vectors
-    ttut1_mjd_.clear();
-    ttut1_delt_.clear();
+    std::shared_ptr<const TtUt1Table> ref    = TtUt1(mjd, n);
+    const TtUt1Table&                 table  = *ref;
+    CEExtrapType                      extrap = extrap_.load(std::memory_order_relaxed);
+    BatchLookup(table.mjd, table.delt, table.size, table.index,
+                &table.spline[0], 4, mjd, values, n, status,
+                ExtrapFunction(table, extrap), &ttut1_stats_);
 }
 
 
 /**********************************************************************//**
- * Copy data members from another object
+ * Fill an array with all of the Earth orientation parameters for an array
+ * of dates
  * 
- * @param[in] other     CECorrections object to be copied
+ * @param[in]  mjd      Modified Julian dates
+ * @param[out] values   Earth orientation parameters for each date
+ * @param[in]  n        Number of dates
+ * 
+ * Same as eop(const double&) for each date, but the rows of each table are
+ * only found once for all of its columns.
  *************************************************************************/
-void CECorrections::copy_members(const CECorrections& other)
+void CECorrections::eop(const double* mjd, CEEop* values, const std::size_t& n) const
 {
-    nutation_file_ = other.nutation_file_;
-    nutation_mjd_  = other.nutation_mjd_;
-    nutation_dut1_ = other.nutation_dut1_;
-    nutation_xp_   = other.nutation_xp_;
-    nutation_yp_   = other.nutation_yp_;
-    nutation_deps_ = other.nutation_deps_;
-    nutation_dpsi_ = other.nutation_dpsi_;
-
-    ttut1_file_hist_ = other.ttut1_file_hist_;
-    ttut1_file_pred_ = other.ttut1_file_pred_;
-    ttut1_delt_      = other.ttut1_delt_;
+    if (n == 0) {
+        return;
+    }
+    CEInterpType             interp = interp_.load(std::memory_order_relaxed);
+    CEExtrapType             extrap = extrap_.load(std::memory_order_relaxed);
+    std::vector<int>         rows;
+    std::vector<std::size_t> outside;
+    std::vector<double>      column(n);
+
+    // Nutation table (the spline coefficients of the columns are
+    // interleaved, see PrepareTable())
+    {
+        std::shared_ptr<const NutationTable> ref   = Nutation(mjd, n);
+        const NutationTable&                 table = *ref;
+        nutation_stats_.batch_lookups.fetch_add(n, std::memory_order_relaxed);
+        FindRows(table.mjd, table.size, table.index, mjd, n,
+                 extrap != CEExtrapType::NONE, &nutation_stats_, &rows, &outside);
+        CountInterpolations(&nutation_stats_, n - outside.size(), interp);
+
+        const double* columns[5] = {table.dut1, table.xp, table.yp, table.deps, table.dpsi};
+        double CEEop::* fields[5] = {&CEEop::dut1, &CEEop::xp, &CEEop::yp, 
+                                     &CEEop::deps, &CEEop::dpsi};
+        for (int c=0; c<5; c++) {
+            FillColumn(table.mjd, columns[c], table.size, &table.spline[4*c], 20,
+                       interp, mjd, &rows[0], &column[0], n);
+            for (std::size_t i=0; i<n; i++) {
+                values[i].*fields[c] = column[i];
+            }
+            for (std::size_t i : outside) {
+                values[i].*fields[c] = ExtrapValue(table, columns[c], mjd[i], extrap);
+            }
+        }
+        for (std::size_t i=0; i<n; i++) {
+            values[i].status = CELookupStatus::TABLE;
+        }
+        for (std::size_t i : outside) {
+            values[i].status = CELookupStatus::EXTRAPOLATED;
+        }
+    }
 
-    // Caching values
-    cache_nut_mjd_    = other.cache_nut_mjd_;
-    cache_nut_dut1_   = other.cache_nut_dut1_;
-    cache_nut_xp_     = other.cache_nut_xp_;
-    cache_nut_yp_     = other.cache_nut_yp_;
-    cache_nut_deps_   = other.cache_nut_deps_;
-    cache_nut_dpsi_   = other.cache_nut_dpsi_;
-    cache_ttut1_mjd_  = other.cache_ttut1_mjd_;
-    cache_ttut1_delt_ = other.cache_ttut1_delt_;
+    // TT-UT1 table
+    {
+        std::shared_ptr<const TtUt1Table> ref   = TtUt1(mjd, n);
+        const TtUt1Table&                 table = *ref;
+        ttut1_stats_.batch_lookups.fetch_add(n, std::memory_order_relaxed);
+        FindRows(table.mjd, table.size, table.index, mjd, n,
+                 extrap != CEExtrapType::NONE, &ttut1_stats_, &rows, &outside);
+        CountInterpolations(&ttut1_stats_, n - outside.size(), interp);
+
+        FillColumn(table.mjd, table.delt, table.size, &table.spline[0], 4,
+                   interp, mjd, &rows[0], &column[0], n);
+        for (std::size_t i=0; i<n; i++) {
+            values[i].ttut1 = column[i];
+        }
+        for (std::size_t i : outside) {
+            values[i].ttut1  = ExtrapValue(table, mjd[i], extrap);
+            values[i].status = CELookupStatus::EXTRAPOLATED;
+        }
+    }
 }
 
 
 /**********************************************************************//**
- * Initialize data members
+ * Return all of the Earth orientation parameters for a vector of dates
+ * 
+ * @param[in] mjd       Modified Julian dates
+ * @return Earth orientation parameters for each date
  *************************************************************************/
-void CECorrections::init_members(void)
+std::vector<CEEop> CECorrections::eop(const std::vector<double>& mjd) const
 {
-    // Note that CECORRFILEPATH is defined at compile time
-    interp_ = false;
-
-    nutation_file_ = std::string(CECORRFILEPATH) + "/nutation.txt";
-    nutation_mjd_  = std::vector<int>(0);
-    nutation_dut1_ = std::vector<double>(0);
-    nutation_xp_   = std::vector<double>(0);
-    nutation_yp_   = std::vector<double>(0);
-    nutation_deps_ = std::vector<double>(0);
-    nutation_dpsi_ = std::vector<double>(0);
-
-    ttut1_file_hist_ = std::string(CECORRFILEPATH) + "/ttut1_historic.txt";
-    ttut1_file_pred_ = std::string(CECORRFILEPATH) + "/ttut1_predicted.txt";
-    ttut1_mjd_       = std::vector<double>(0);
-    ttut1_delt_      = std::vector<double>(0); 
+    std::vector<CEEop> values(mjd.size());
+    eop(mjd.data(), values.data(), mjd.size());
+    return values;
+}
 
-    // Nutation cached values
-    cache_nut_mjd_  = -1e30;
-    cache_nut_dut1_ = 0.0;
-    cache_nut_xp_   = 0.0;
-    cache_nut_yp_   = 0.0;
-    cache_nut_deps_ = 0.0;
-    cache_nut_dpsi_ = 0.0;
 
-    // TT-UT1 cached values
-    cache_ttut1_mjd_  = -1e30;
-    cache_ttut1_delt_ = 63.8285; // Default to J2000 reference date value
+/**********************************************************************//**
+ * Return the DUT1 correction for a vector of dates
+ * 
+ * @param[in] mjd       Modified Julian dates
+ * @return DUT1 correction for each date (UT1 - UTC in seconds)
+ *************************************************************************/
+std::vector<double> CECorrections::dut1(const std::vector<double>& mjd) const
+{
+    std::vector<double> values(mjd.size());
+    dut1(mjd.data(), values.data(), mjd.size());
+    return values;
 }
 
 
 /**********************************************************************//**
- * Initialize data members
+ * Return the x-polar motion for a vector of dates
+ * 
+ * @param[in] mjd       Modified Julian dates
+ * @return x-polar motion for each date (radians)
  *************************************************************************/
-std::ifstream CECorrections::LoadFile(const std::string& filename,
-                                      const std::string& url) const
+std::vector<double> CECorrections::xpolar(const std::vector<double>& mjd) const
 {
-    // Check if the file has been stored
-    std::ifstream corrections_file(filename, std::ios::in);
-
-    // Try downloading the file
-    if (!corrections_file.is_open()) {
-        // Close the file so there's no funny business while attempting
-        // to write to it
-        corrections_file.close();
+    std::vector<double> values(mjd.size());
+    xpolar(mjd.data(), values.data(), mjd.size());
+    return values;
+}
 
-        // Try downloading the correction files
-        if (!DownloadTable(filename, url)) {
-            throw CEException::exception();
-        }
 
-        // Try to open the file again
-        corrections_file.open(filename, std::ios::in);
+/**********************************************************************//**
+ * Return the y-polar motion for a vector of dates
+ * 
+ * @param[in] mjd       Modified Julian dates
+ * @return y-polar motion for each date (radians)
+ *************************************************************************/
+std::vector<double> CECorrections::ypolar(const std::vector<double>& mjd) const
+{
+    std::vector<double> values(mjd.size());
+    ypolar(mjd.data(), values.data(), mjd.size());
+    return values;
+}
 
-        // Make sure the file is open
-        if (!corrections_file.is_open()) {
-            std::string msg = "Unable to load corrections file: " + filename;
-            throw CEException::corr_file_load_error(__func__, msg);
-        }
-    }
 
-    return corrections_file;
+/**********************************************************************//**
+ * Return the obliquity correction for a vector of dates
+ * 
+ * @param[in] mjd       Modified Julian dates
+ * @return Obliquity correction for each date (radians)
+ *************************************************************************/
+std::vector<double> CECorrections::deps(const std::vector<double>& mjd) const
+{
+    std::vector<double> values(mjd.size());
+    deps(mjd.data(), values.data(), mjd.size());
+    return values;
 }
 
 
 /**********************************************************************//**
- * Downloads the IERS earth orientation correction parameters
+ * Return the longitude correction for a vector of dates
  * 
- * @return Whether or not the download was successful
+ * @param[in] mjd       Modified Julian dates
+ * @return Longitude correction for each date (radians)
  *************************************************************************/
-bool CECorrections::DownloadTable(const std::string& filename,
-                                  const std::string& url) const
+std::vector<double> CECorrections::dpsi(const std::vector<double>& mjd) const
 {
-    bool success = true;
-    #ifndef NOCURL
-    try {
-        CURL *curl;
-        FILE *fp;
-        CURLcode res;
-        curl = curl_easy_init();                                                                                                                                                                                                                                                           
-        if (curl)
-        {   
-            fp = fopen(filename.c_str(), "wb");
-            curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, NULL);
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
-            res = curl_easy_perform(curl);
-            curl_easy_cleanup(curl);
-            fclose(fp);
-            // TODO: handle the result
-        }   
-    } 
-    // Catch exceptions that may happen
-    catch (std::exception& e) {
-        std::cerr << "ERROR trying to download corrections files: " 
-                  << e.what() << std::endl;
-        success = false;
-    }
-    #else
-    std::cout << "CppEphem was not compiled with curl support. To download "
-              << "the corrections file automatically, recompile with -DNOCURL=0."
-              << std::endl;
-    success = false;
-    #endif
-
-    return success;
+    std::vector<double> values(mjd.size());
+    dpsi(mjd.data(), values.data(), mjd.size());
+    return values;
 }
 
 
 /**********************************************************************//**
- * Loads the IERS earth orientation correction parameters
+ * Return the TT-UT1 correction for a vector of dates
  * 
- * @return Whether or not the load was successful
+ * @param[in] mjd       Modified Julian dates
+ * @return TT-UT1 for each date (seconds)
  *************************************************************************/
-bool CECorrections::LoadNutation(void) const
-{
-    bool loaded = true;
-    if (nutation_mjd_.size() == 0) {
-        // Check if the file has been stored
-        std::string   url = "http://maia.usno.navy.mil/ser7/finals2000A.all";
-        std::ifstream corrections_file = LoadFile(nutation_file_, url);
-
-        // Try to load values from the file
-        try {
-            // Allocate an approximate amount of memory for the values
-            nutation_mjd_.reserve(20000);
-            nutation_dut1_.reserve(20000);
-            nutation_xp_.reserve(20000);
-            nutation_yp_.reserve(20000);
-            nutation_deps_.reserve(20000);
-            nutation_dpsi_.reserve(20000);
-
-            // Preliminary storage values
-            int    mjd;
-            double dut1;
-            double xp;
-            double yp;
-            double deps;
-            double dpsi;
-
-            // Loop through each line of the file
-            std::string line;
-            while(std::getline(corrections_file, line)) {
-                mjd = std::stoi(line.substr(7,8));
-
-                // Try to load dut1, xypolar from bulletin B positions
-                try {
-                    dut1 = std::stod(line.substr(154,11));
-                    xp   = std::stod(line.substr(134,10));
-                    yp   = std::stod(line.substr(144,10));
-                    deps = std::stod(line.substr(175,10));
-                    dpsi = std::stod(line.substr(165,10));
-                } 
-                // Otherwise load from bulletin A positions
-                catch (std::exception& e) {
-                    try {
-                        dut1 = std::stod(line.substr(58,10));
-                        xp   = std::stod(line.substr(18, 9));
-                        yp   = std::stod(line.substr(37, 9));
-                        deps = std::stod(line.substr(116,9));
-                        dpsi = std::stod(line.substr(97,9));
-                    }
-                    catch (std::exception& e) {
-                        // Reached end of useable fields in the file
-                        break;
-                    }
-                }
+std::vector<double> CECorrections::ttut1(const std::vector<double>& mjd) const
+{
+    std::vector<double> values(mjd.size());
+    ttut1(mjd.data(), values.data(), mjd.size());
+    return values;
+}
 
-                // The Standards of Fundamental Astronomy expects angles in 
-                // units of radians, so xp, yp, deps, and dpsi need to be converted
-                nutation_mjd_.push_back( mjd );
-                nutation_dut1_.push_back( dut1 );
-                nutation_xp_.push_back( xp * DAS2R );      // arcsec -> radians
-                nutation_yp_.push_back( yp * DAS2R );      // arcsec -> radians
-                nutation_deps_.push_back( deps * DMAS2R ); // marcsec -> radians
-                nutation_dpsi_.push_back( dpsi * DMAS2R ); // marcsec -> radians
-            }
 
-            // Close the corrections file
-            corrections_file.close();
+/**********************************************************************//**
+ * Return all of the Earth orientation parameters at a given date
+ * 
+ * @param[in] mjd       Modified Julian date
+ * @return Earth orientation parameters at @p mjd
+ * 
+ * This is cheaper than querying the parameters one at a time, since each
+ * table is only looked up once.
+ *************************************************************************/
+CEEop CECorrections::eop(const double& mjd) const
+{
+    const NutationCache& nut = UpdateNutationCache(mjd);
+    CEEop values;
+    values.dut1  = nut.dut1;
+    values.xp    = nut.xp;
+    values.yp    = nut.yp;
+    values.dpsi  = nut.dpsi;
+    values.deps  = nut.deps;
+    const TtUt1Cache& ttut1 = UpdateTtUt1Cache(mjd);
+    values.ttut1 = ttut1.delt;
+    values.status = ((nut.status == CELookupStatus::TABLE) && 
+                     (ttut1.status == CELookupStatus::TABLE)) ? 
+                    CELookupStatus::TABLE : CELookupStatus::EXTRAPOLATED;
+    return values;
+}
 
-            // Shrink up the vectors so we dont take more memory than necessary
-            nutation_mjd_.shrink_to_fit();
-            nutation_dut1_.shrink_to_fit();
-            nutation_xp_.shrink_to_fit();
-            nutation_yp_.shrink_to_fit();
-            nutation_deps_.shrink_to_fit();
-            nutation_dpsi_.shrink_to_fit();
 
-        } catch (std::exception& e) {
-            std::cerr << "ERROR Unable to load corrections from file" << std::endl;
-            std::cerr << e.what() << std::endl;
-            loaded = false;
-        }
+/**********************************************************************//**
+ * Overloaded assignment operator
+ * 
+ * @param[in] other     CECorrections object to be copied
+ * @return Reference to this object post-assignment
+ *************************************************************************/
+CECorrections& CECorrections::operator=(const CECorrections& other)
+{
+    if (this != &other) {
+        free_members();
+        init_members();
+        copy_members(other);
     }
-    return loaded;
+    return *this;
 }
 
 
 /**********************************************************************//**
- * Loads the TT-UT1 correction values
+ * Sets the name of the nutation corrections file
  * 
- * @return Whether or not the load was successful
+ * @param[in] filename      Filename to read/write corrections from/to
  *************************************************************************/
-bool CECorrections::LoadTtUt1(void) const
+void CECorrections::SetNutationFile(const std::string& filename)
 {
-    bool loaded = true;
-    if (ttut1_mjd_.size() == 0) {
-
-        try{
-            // Check if the file has been stored
-            std::string   url = "http://maia.usno.navy.mil/ser7/deltat.data";
-            std::ifstream corrections_file = LoadFile(ttut1_file_hist_, url);    
-        
-            // Allocate an approximate amount of memory for the values
-            ttut1_mjd_.reserve(5000);
-
-            // Preliminary storage values
-            int    mjd;
-            double delt;
-
-            // Loop through each line of the file
-            std::string line;
-            while(std::getline(corrections_file, line)) {
-
-                // Extract the Gregorian vector date
-                std::vector<double> greg_vect(4, 0.0);
-                greg_vect[0] = std::stod(line.substr(1,4));
-                greg_vect[1] = std::stod(line.substr(6,2));
-                greg_vect[2] = std::stod(line.substr(9,2));
-                mjd = CEDate::GregorianVect2MJD(greg_vect);
-
-                // Try to load delta T from the file
-                try {
-                    delt = std::stod(line.substr(13,7));
-                } 
-                // Otherwise load from bulletin A positions
-                catch (std::exception& e) {
-                    // Reached end of useable fields in the file
-                    break;
-                }
+    nutation_file_ = filename;
+}
 
-                // Store the values into a vector
-                ttut1_mjd_.push_back( mjd );
-                ttut1_delt_.push_back( delt );
-            }
 
-            // Close the corrections file
-            corrections_file.close();
+/**********************************************************************//**
+ * Sets the name of the historic values TT-UT1 corrections file
+ * 
+ * @param[in] filename      Filename to read/write corrections from/to
+ *************************************************************************/
+void CECorrections::SetTtUt1HistFile(const std::string& filename)
+{
+    ttut1_file_hist_ = filename;
+}
 
-            // Load the predicted corrections for the future
-            url = "http://maia.usno.navy.mil/ser7/deltat.preds";
-            corrections_file = LoadFile(ttut1_file_pred_, url);
 
-            // Loop through each line of the file
-            std::getline(corrections_file, line);   // First line is a header
-            while(std::getline(corrections_file, line)) {
+/**********************************************************************//**
+ * Sets the name of the predicted values TT-UT1 corrections file
+ * 
+ * @param[in] filename      Filename to read/write corrections from/to
+ *************************************************************************/
+void CECorrections::SetTtUt1PredFile(const std::string& filename)
+{
+    ttut1_file_pred_ = filename;
+}
 
-                // Extract the MJD
-                mjd = std::stoi(line.substr(3,9));
 
-                // Only add this value if it is actually from a later date
-                // than the last entry in the vector
-                if (mjd > ttut1_mjd_.back()) {
+/**********************************************************************//**
+ * Defines that the correction values should be interpolated
+ * 
+ * @param[in] set_interp        New interpolation boolean
+ *************************************************************************/
+void CECorrections::SetInterp(bool set_interp)
+{
+    SetInterp(set_interp ? CEInterpType::LINEAR : CEInterpType::NONE);
+}
 
-                    // Try to load delta T from the file
-                    try {
-                        delt = std::stod(line.substr(24,5));
-                    } 
-                    // Otherwise load from bulletin A positions
-                    catch (std::exception& e) {
-                        // Reached end of useable fields in the file
-                        break;
-                    }
 
-                    // Store the values into a vector
-                    ttut1_mjd_.push_back( mjd );
-                    ttut1_delt_.push_back( delt );
-                }
-            }
+/**********************************************************************//**
+ * Defines how the correction values should be interpolated
+ * 
+ * @param[in] interp_type       Interpolation type (see ::CEInterpType)
+ * 
+ * The cubic spline coefficients are computed when the tables are loaded,
+ * so CEInterpType::CUBIC is both smoother and cheaper to evaluate than
+ * CEInterpType::LINEAR.
+ *************************************************************************/
+void CECorrections::SetInterp(const CEInterpType& interp_type)
+{
+    // Note that the cached values record the interpolation setting they
+    // were computed with, so they will be recomputed on the next lookup
+    interp_.store(interp_type, std::memory_order_relaxed);
+}
 
-            // Shrink up the vectors so we dont take more memory than necessary
-            ttut1_mjd_.shrink_to_fit();
-            ttut1_delt_.shrink_to_fit();
 
-        } catch (std::exception& e) {
-            std::cerr << "ERROR Unable to load corrections from file" << std::endl;
-            std::cerr << e.what() << std::endl;
-            loaded = false;
-        }
-    }
-    return loaded;
+/**********************************************************************//**
+ * Returns how the correction values are interpolated
+ * 
+ * @return Interpolation type (see ::CEInterpType)
+ *************************************************************************/
+CEInterpType CECorrections::InterpType(void) const
+{
+    return interp_.load(std::memory_order_relaxed);
 }
 
 
 /**********************************************************************//**
- * Recompute cached values of nutation valeus if necessary
+ * Defines what happens for dates outside of the correction tables
  * 
- * @param[in] mjd       Modified Julian date for lookup
+ * @param[in] extrap_type       Extrapolation type (see ::CEExtrapType)
+ * 
+ * With CEExtrapType::NONE (the default) such dates throw an exception.
  *************************************************************************/
-void CECorrections::UpdateNutationCache(const double& mjd) const
+void CECorrections::SetExtrap(const CEExtrapType& extrap_type)
 {
-    // Check if the nutation actually needs to be updated
-    if (mjd != cache_nut_mjd_) {
-        // Make sure nutation corrections are loaded
-        LoadNutation();
+    extrap_.store(extrap_type, std::memory_order_relaxed);
+}
 
-        // Compute the closest index associated with the MJD
-        int indx = (std::lower_bound(nutation_mjd_.begin(),nutation_mjd_.end(), mjd) 
-                    - nutation_mjd_.begin() ) - 1;
 
-        // Make sure the MJD date is covered by stored correction values
-        if ((indx < 0) || (indx >= nutation_mjd_.size()-1)) {
-            // TODO: Make this a warning message
-            std::string min_mjd(std::to_string(nutation_mjd_.front()));
-            std::string max_mjd(std::to_string(nutation_mjd_.back()));
-            std::string msg = "Invalid mjd: " + std::to_string(mjd) + ". Accepted " +
-                            "range is " + min_mjd + " - " + max_mjd;
-            throw CEException::invalid_value(__func__, msg);
-        } 
+/**********************************************************************//**
+ * Returns what happens for dates outside of the correction tables
+ * 
+ * @return Extrapolation type (see ::CEExtrapType)
+ *************************************************************************/
+CEExtrapType CECorrections::ExtrapType(void) const
+{
+    return extrap_.load(std::memory_order_relaxed);
+}
 
-        // Get the uninterpolated value
-        else if (!interp_) {
-            cache_nut_dut1_ = nutation_dut1_[indx];
-            cache_nut_xp_   = nutation_xp_[indx];
-            cache_nut_yp_   = nutation_yp_[indx];
-            cache_nut_deps_ = nutation_deps_[indx];
-            cache_nut_dpsi_ = nutation_dpsi_[indx];
-        } 
-        
-        // Otherwise interpolate between closest two values (a bit slower)
-        else {
-            double mjd_lower( nutation_mjd_[indx] );
-            double mjd_upper( nutation_mjd_[indx+1] );
-            
-            cache_nut_dut1_ = InterpValue(mjd, mjd_lower, mjd_upper,
-                                          nutation_dut1_[indx], 
-                                          nutation_dut1_[indx+1]);
-            cache_nut_xp_   = InterpValue(mjd, mjd_lower, mjd_upper,
-                                          nutation_xp_[indx], 
-                                          nutation_xp_[indx+1]);
-            cache_nut_yp_   = InterpValue(mjd, mjd_lower, mjd_upper,
-                                          nutation_yp_[indx], 
-                                          nutation_yp_[indx+1]);
-            cache_nut_deps_ = InterpValue(mjd, mjd_lower, mjd_upper,
-                                          nutation_deps_[indx], 
-                                          nutation_deps_[indx+1]);
-            cache_nut_dpsi_ = InterpValue(mjd, mjd_lower, mjd_upper,
-                                          nutation_dpsi_[indx], 
-                                          nutation_dpsi_[indx+1]);
-        }
 
-        cache_nut_mjd_  = mjd;
+/**********************************************************************//**
+ * Returns the usage statistics of this object
+ * 
+ * @return Statistics accumulated since construction (or ResetStats())
+ * 
+ * The counters are read individually while lookups may be in progress,
+ * so they are not necessarily consistent with each other.
+ *************************************************************************/
+CECorrectionsStats CECorrections::Stats(void) const
+{
+    // Sum the cache hits of all threads
+    std::uint64_t nutation_hits = 0;
+    std::uint64_t ttut1_hits    = 0;
+    {
+        std::lock_guard<std::mutex> lock(hits_mutex_);
+        for (std::size_t i=0; i<hits_.size(); i++) {
+            nutation_hits += hits_[i]->nutation.load(std::memory_order_relaxed);
+            ttut1_hits    += hits_[i]->ttut1.load(std::memory_order_relaxed);
+        }
     }
 
-    return;
+    CECorrectionsStats stats;
+    stats.nutation      = GetTableStats(nutation_stats_, nutation_hits);
+    stats.ttut1         = GetTableStats(ttut1_stats_, ttut1_hits);
+    stats.nutation.tables = nutation_tables.load(std::memory_order_relaxed);
+    stats.ttut1.tables    = ttut1_tables.load(std::memory_order_relaxed);
+    stats.downloads     = downloads_.load(std::memory_order_relaxed);
+    stats.download_time = 1.0e-9 * download_ns_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+
+/**********************************************************************//**
+ * Returns the usage statistics of this object as a JSON document
+ * 
+ * @return JSON object with the values of Stats()
+ *************************************************************************/
+std::string CECorrections::StatsJSON(void) const
+{
+    CECorrectionsStats stats = Stats();
+    std::ostringstream json;
+    json << std::setprecision(9)
+         << "{\n"
+         << "  \"nutation\": " << TableStatsJSON(stats.nutation) << ",\n"
+         << "  \"ttut1\": " << TableStatsJSON(stats.ttut1) << ",\n"
+         << "  \"downloads\": " << stats.downloads << ",\n"
+         << "  \"download_time\": " << stats.download_time << "\n"
+         << "}";
+    return json.str();
+}
+
+
+/**********************************************************************//**
+ * Reset all of the usage statistics to zero
+ *************************************************************************/
+void CECorrections::ResetStats(void)
+{
+    ResetCounters(&nutation_stats_);
+    ResetCounters(&ttut1_stats_);
+    downloads_.store(0, std::memory_order_relaxed);
+    download_ns_.store(0, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(hits_mutex_);
+    for (std::size_t i=0; i<hits_.size(); i++) {
+        hits_[i]->nutation.store(0, std::memory_order_relaxed);
+        hits_[i]->ttut1.store(0, std::memory_order_relaxed);
+    }
+}
+
+
+/**********************************************************************//**
+ * Returns the number of rows in the loaded nutation corrections table
+ * 
+ * @return Number of rows (0 if the table has not been loaded yet)
+ *************************************************************************/
+std::size_t CECorrections::NutationRows(void) const
+{
+    std::shared_ptr<const NutationTable> table = std::atomic_load(&nutation_);
+    return (table == nullptr) ? 0 : table->size;
+}
+
+
+/**********************************************************************//**
+ * Returns the time it took to load the nutation corrections table
+ * 
+ * @return Load time in seconds (0 if the table has not been loaded yet)
+ *************************************************************************/
+double CECorrections::NutationLoadTime(void) const
+{
+    std::shared_ptr<const NutationTable> table = std::atomic_load(&nutation_);
+    return (table == nullptr) ? 0.0 : table->load_time;
+}
+
+
+/**********************************************************************//**
+ * Returns the number of rows in the loaded TT-UT1 corrections table
+ * 
+ * @return Number of rows (0 if the table has not been loaded yet)
+ *************************************************************************/
+std::size_t CECorrections::TtUt1Rows(void) const
+{
+    std::shared_ptr<const TtUt1Table> table = std::atomic_load(&ttut1_);
+    return (table == nullptr) ? 0 : table->size;
+}
+
+
+/**********************************************************************//**
+ * Returns the time it took to load the TT-UT1 corrections table
+ * 
+ * @return Load time in seconds (0 if the table has not been loaded yet)
+ *************************************************************************/
+double CECorrections::TtUt1LoadTime(void) const
+{
+    std::shared_ptr<const TtUt1Table> table = std::atomic_load(&ttut1_);
+    return (table == nullptr) ? 0.0 : table->load_time;
+}
+
+
+/**********************************************************************//**
+ * Restrict the correction tables to a range of dates
+ * 
+ * @param[in] mjd_min       First modified Julian date that will be looked up
+ * @param[in] mjd_max       Last modified Julian date that will be looked up
+ * 
+ * Tables loaded after this call only keep the rows needed for the range.
+ * Looking up a date outside of it is still supported, the range is then
+ * extended and the table reloaded. Tables that are already loaded are
+ * kept until they are reloaded.
+ *************************************************************************/
+void CECorrections::SetMJDRange(const double& mjd_min, const double& mjd_max)
+{
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    range_min_ = mjd_min;
+    range_max_ = mjd_max;
+}
+
+
+/**********************************************************************//**
+ * Start loading the correction tables on a background thread
+ * 
+ * @return Future holding whether both tables were loaded (never throws)
+ * 
+ * Only one prefetch runs at a time, calling this again while one is in
+ * progress returns the same future. The tables are loaded for the range
+ * set with SetMJDRange() (all dates by default).
+ *************************************************************************/
+std::shared_future<bool> CECorrections::Prefetch(void)
+{
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    if (!prefetch_.valid() || 
+        (prefetch_.wait_for(std::chrono::seconds(0)) == std::future_status::ready)) {
+        // An empty range of dates loads any table that isn't loaded yet
+        // (errors are reported again by the lookups that need the table)
+        prefetch_ = std::async(std::launch::async, [this]() {
+            bool nutation = false;
+            bool ttut1    = false;
+            try {
+                nutation = LoadNutation(HUGE_VAL, -HUGE_VAL);
+            } catch (std::exception& e) {
+                nutation = false;
+            }
+            try {
+                ttut1 = LoadTtUt1(HUGE_VAL, -HUGE_VAL);
+            } catch (std::exception& e) {
+                ttut1 = false;
+            }
+            return nutation && ttut1;
+        }).share();
+    }
+    return prefetch_;
+}
+
+
+/**********************************************************************//**
+ * Re-read the correction files of all tables that have been loaded
+ * 
+ * @return Whether all of the loaded tables could be re-read
+ * 
+ * The files are parsed without blocking lookups from other threads, which
+ * continue to use the current tables until the new ones are swapped in.
+ * If a file cannot be read the current table is kept. Tables that have
+ * not been loaded yet will be read from the current files on first use.
+ *************************************************************************/
+bool CECorrections::Reload(void)
+{
+    bool nutation = ReloadNutation();
+    bool ttut1    = ReloadTtUt1();
+    return nutation && ttut1;
+}
+
+
+/**********************************************************************//**
+ * Start or stop watching the correction files for updates
+ * 
+ * @param[in] watch         Whether to watch the correction files
+ * @return Whether the files are now being watched
+ * 
+ * While watching, a background thread reloads a table (see Reload()) each
+ * time one of its files is closed after writing or moved into place. The
+ * watched files are those set when watching starts. Updates should be
+ * written to a temporary file and then renamed over the old one, since a
+ * file that is rewritten in place may be reloaded while still incomplete.
+ * 
+ * File watching relies on inotify and is only available on Linux.
+ *************************************************************************/
+bool CECorrections::SetWatchFiles(bool watch)
+{
+    // Stop the current watch so that it picks up the current filenames
+    StopWatch();
+    #ifdef __linux__
+    if (watch) {
+        // Wait until the files are watched so no update can be missed
+        std::promise<bool> started;
+        std::future<bool>  result = started.get_future();
+        watch_stop_.store(false);
+        watch_thread_ = std::thread(&CECorrections::WatchLoop, this, std::move(started));
+        if (!result.get()) {
+            watch_thread_.join();
+        }
+    }
+    #else
+    if (watch) {
+        std::cerr << "[WARNING] Watching the corrections files is only "
+                  << "supported on Linux" << std::endl;
+    }
+    #endif
+    return WatchFiles();
+}
+
+
+/**********************************************************************//**
+ * Free data member objects
+ *************************************************************************/
+void CECorrections::free_members(void)
+{
+    // Background threads load tables, so stop them first
+    StopWatch();
+    WaitPrefetch();
+
+    std::lock_guard<std::mutex> lock(load_mutex_);
+
+    // Release the loaded tables (lookups still using them keep them alive)
+    PublishNutation(nullptr);
+    PublishTtUt1(nullptr);
+}
+
+
+/**********************************************************************//**
+ * Copy data members from another object
+ * 
+ * @param[in] other     CECorrections object to be copied
+ *************************************************************************/
+void CECorrections::copy_members(const CECorrections& other)
+{
+    // Grab the other object's tables while they cannot be replaced
+    std::shared_ptr<const NutationTable> nutation;
+    std::shared_ptr<const TtUt1Table>    ttut1;
+    {
+        std::lock_guard<std::mutex> lock(other.load_mutex_);
+        nutation_file_   = other.nutation_file_;
+        ttut1_file_hist_ = other.ttut1_file_hist_;
+        ttut1_file_pred_ = other.ttut1_file_pred_;
+        range_min_       = other.range_min_;
+        range_max_       = other.range_max_;
+        nutation         = other.nutation_;
+        ttut1            = other.ttut1_;
+    }
+
+    // Published tables are never modified, so the copy simply shares them.
+    // Reloading either object later swaps in a new table for that object
+    // only, leaving the other one untouched.
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    PublishNutation(nutation);
+    PublishTtUt1(ttut1);
+
+    interp_.store(other.interp_.load(std::memory_order_relaxed), 
+                  std::memory_order_relaxed);
+    extrap_.store(other.extrap_.load(std::memory_order_relaxed), 
+                  std::memory_order_relaxed);
+}
+
+
+/**********************************************************************//**
+ * Initialize data members
+ *************************************************************************/
+void CECorrections::init_members(void)
+{
+    // Note that CECORRFILEPATH is defined at compile time
+    interp_.store(CEInterpType::NONE, std::memory_order_relaxed);
+    extrap_.store(CEExtrapType::NONE, std::memory_order_relaxed);
+
+    // Lookup caches filled for a previous identifier no longer count as hits
+    id_ = NextObjectId();
+    {
+        std::lock_guard<std::mutex> lock(hits_mutex_);
+        hits_.clear();
+    }
+    ResetStats();
+
+    nutation_file_   = std::string(CECORRFILEPATH) + "/nutation.txt";
+    ttut1_file_hist_ = std::string(CECORRFILEPATH) + "/ttut1_historic.txt";
+    ttut1_file_pred_ = std::string(CECORRFILEPATH) + "/ttut1_predicted.txt";
+
+    // Tables are loaded on first use and cover all dates
+    range_min_ = -HUGE_VAL;
+    range_max_ = HUGE_VAL;
+    PublishNutation(nullptr);
+    PublishTtUt1(nullptr);
+
+    // Files are not watched (or prefetched) unless requested
+    prefetch_ = std::shared_future<bool>();
+    watch_stop_.store(false);
+}
+
+
+/**********************************************************************//**
+ * Initialize data members
+ *************************************************************************/
+std::ifstream CECorrections::LoadFile(const std::string& filename,
+                                      const std::string& url) const
+{
+    // Check if the file has been stored
+    std::ifstream corrections_file(filename, std::ios::in);
+
+    // Try downloading the file
+    if (!corrections_file.is_open()) {
+        // Close the file so there's no funny business while attempting
+        // to write to it
+        corrections_file.close();
+
+        // Try downloading the correction files
+        if (!DownloadTable(filename, url)) {
+            throw CEException::exception();
+        }
+
+        // Try to open the file again
+        corrections_file.open(filename, std::ios::in);
+
+        // Make sure the file is open
+        if (!corrections_file.is_open()) {
+            std::string msg = "Unable to load corrections file: " + filename;
+            throw CEException::corr_file_load_error(__func__, msg);
+        }
+    }
+
+    return corrections_file;
+}
+
+
+/**********************************************************************//**
+ * Read the content of a corrections file
+ * 
+ * @param[in]  filename     Corrections file
+ * @param[in]  url          Location to download the file from if it is missing
+ * @param[out] buffer       Content of the file
+ * @param[out] embedded     Whether the content came from the library itself
+ * @return Whether the file could be read
+ * 
+ * If the library was compiled with the corrections tables embedded (CMake
+ * option 'embedcorr') and @p filename does not exist, the embedded copy of
+ * the table with the same name is used without any disk or network access.
+ *************************************************************************/
+bool CECorrections::ReadCorrectionsFile(const std::string& filename,
+                                        const std::string& url,
+                                        std::vector<char>* buffer,
+                                        bool*              embedded) const
+{
+    // Files on disk take precedence over the embedded tables
+    *embedded = (access(filename.c_str(), F_OK) != 0) && 
+                GetEmbeddedFile(filename, buffer);
+    if (*embedded) {
+        return true;
+    }
+
+    std::ifstream corrections_file = LoadFile(filename, url);
+    bool success = ReadTextFile(corrections_file, buffer);
+    corrections_file.close();
+    return success;
+}
+
+
+/**********************************************************************//**
+ * Downloads the IERS earth orientation correction parameters
+ * 
+ * @return Whether or not the download was successful
+ *************************************************************************/
+bool CECorrections::DownloadTable(const std::string& filename,
+                                  const std::string& url) const
+{
+    bool success = true;
+    #ifndef NOCURL
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    try {
+        CURL *curl;
+        FILE *fp;
+        CURLcode res;
+        curl = curl_easy_init();                                                                                                                                                                                                                                                           
+        if (curl)
+        {   
+            fp = fopen(filename.c_str(), "wb");
+            curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, NULL);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
+            res = curl_easy_perform(curl);
+            curl_easy_cleanup(curl);
+            fclose(fp);
+            // TODO: handle the result
+        }   
+    } 
+    // Catch exceptions that may happen
+    catch (std::exception& e) {
+        std::cerr << "ERROR trying to download corrections files: " 
+                  << e.what() << std::endl;
+        success = false;
+    }
+    downloads_.fetch_add(1, std::memory_order_relaxed);
+    download_ns_.fetch_add(std::uint64_t(1.0e9 * Seconds(start)), 
+                           std::memory_order_relaxed);
+    #else
+    std::cout << "CppEphem was not compiled with curl support. To download "
+              << "the corrections file automatically, recompile with -DNOCURL=0."
+              << std::endl;
+    success = false;
+    #endif
+
+    return success;
+}
+
+
+/**********************************************************************//**
+ * Loads the IERS earth orientation correction parameters
+ * 
+ * @param[in]  mjd_min      First date the table needs to cover
+ * @param[in]  mjd_max      Last date the table needs to cover
+ * @param[out] filename     Nutation file used (optional, for error messages)
+ * @return Whether or not the load was successful
+ * 
+ * The table is parsed into a new object which is then published through
+ * an atomic pointer, so concurrent readers never see a partially loaded
+ * table. Only one thread performs the load.
+ *************************************************************************/
+bool CECorrections::LoadNutation(const double& mjd_min,
+                                 const double& mjd_max,
+                                 std::string*  filename) const
+{
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    if (filename != nullptr) {
+        *filename = nutation_file_;
+    }
+
+    // Another thread may have loaded a suitable table in the meantime
+    const NutationTable* current = nutation_.get();
+    if ((current != nullptr) &&
+        !(mjd_min < current->cover_min) && !(mjd_max > current->cover_max)) {
+        return true;
+    }
+
+    // Extend the range of dates to cover the requested ones
+    ExtendRange(mjd_min, mjd_max, &range_min_, &range_max_);
+
+    std::shared_ptr<const NutationTable> table =
+        ReadNutation(nutation_file_, range_min_, range_max_);
+    if (table == nullptr) {
+        return false;
+    }
+
+    RecordLoad(&nutation_stats_, table->load_time, table->size);
+
+    // Publish the table (lookups may still be using the one it replaces)
+    PublishNutation(table);
+    return true;
+}
+
+
+/**********************************************************************//**
+ * Read the IERS earth orientation correction parameters
+ * 
+ * @param[in] filename      Nutation corrections file
+ * @param[in] range_min     First date the table needs to cover
+ * @param[in] range_max     Last date the table needs to cover
+ * @return New nutation table (nullptr if the file could not be read)
+ * 
+ * The file is read into memory in one go and its fixed width columns are
+ * scanned in place, so parsing does not create any temporary strings or
+ * rely on exceptions to detect missing values. Since the file has one
+ * line per day, the first line needed for the range is found directly
+ * and parsing stops once the range is passed. An up to date binary cache
+ * is always used in full.
+ *************************************************************************/
+std::shared_ptr<const CECorrections::NutationTable>
+    CECorrections::ReadNutation(const std::string& filename,
+                                const double&      range_min,
+                                const double&      range_max) const
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    nutation_tables.fetch_add(1, std::memory_order_relaxed);
+    std::shared_ptr<NutationTable> table(new NutationTable, [](NutationTable* t) {
+        delete t;
+        nutation_tables.fetch_sub(1, std::memory_order_relaxed);
+    });
+    table->cover_min = -HUGE_VAL;
+    table->cover_max = HUGE_VAL;
+
+    // Use the binary cache if it is still up to date
+    std::string              cache_file = filename + ".bin";
+    std::vector<std::string> sources(1, filename);
+    const double* columns = nullptr;
+    table->mapping = MapBinaryTable(cache_file, sources, 6,
+                                    &table->size, &columns);
+    if (table->mapping != nullptr) {
+        SetColumns(table.get(), columns);
+        PrepareTable(table.get());
+        table->load_time = Seconds(start);
+        return table;
+    }
+
+    // Check if the file has been stored
+    std::string       url = "http://maia.usno.navy.mil/ser7/finals2000A.all";
+    std::vector<char> buffer;
+    bool              embedded;
+    if (!ReadCorrectionsFile(filename, url, &buffer, &embedded)) {
+        std::cerr << "ERROR Unable to read corrections file: " 
+                  << filename << std::endl;
+        return nullptr;
+    }
+
+    // Rows needed for the range of dates, including a margin so that
+    // interpolating (and the spline) near the edges is unaffected
+    double row_min = range_min - nutation_margin;
+    double row_max = range_max + nutation_margin;
+
+    // Skip straight to the first row that is needed
+    const char* end = buffer.data() + buffer.size();
+    const char* pos = FindDailyRow(buffer.data(), end, 7, 8, row_min);
+    bool at_start = (pos == buffer.data());
+    bool at_end   = true;
+
+    // Allocate an approximate amount of memory for the values
+    // (each line of the file is 188 characters long)
+    std::size_t nlines = (end - pos) / 188 + 1;
+    if (row_max - row_min < nlines) {
+        nlines = std::size_t(std::max(row_max - row_min, 0.0)) + 1;
+    }
+    std::vector<double> nut_mjd;
+    std::vector<double> nut_dut1;
+    std::vector<double> nut_xp;
+    std::vector<double> nut_yp;
+    std::vector<double> nut_deps;
+    std::vector<double> nut_dpsi;
+    nut_mjd.reserve(nlines);
+    nut_dut1.reserve(nlines);
+    nut_xp.reserve(nlines);
+    nut_yp.reserve(nlines);
+    nut_deps.reserve(nlines);
+    nut_dpsi.reserve(nlines);
+
+    // Preliminary storage values
+    int    mjd;
+    double dut1;
+    double xp;
+    double yp;
+    double deps;
+    double dpsi;
+
+    // Loop through each line of the file
+    CETextLine line;
+    while (NextLine(&pos, end, &line)) {
+        if (!ScanInt(line, 7, 8, &mjd)) {
+            break;
+        }
+
+        // Only keep the rows for the range of dates
+        if (mjd < row_min) {
+            at_start = false;
+            continue;
+        } else if (mjd > row_max) {
+            at_end = false;
+            break;
+        }
+
+        // Try to load dut1, xypolar from bulletin B positions,
+        // otherwise load from bulletin A positions
+        if (!(ScanDouble(line, 154, 11, &dut1) &&
+              ScanDouble(line, 134, 10, &xp)   &&
+              ScanDouble(line, 144, 10, &yp)   &&
+              ScanDouble(line, 175, 10, &deps) &&
+              ScanDouble(line, 165, 10, &dpsi)) &&
+            !(ScanDouble(line,  58, 10, &dut1) &&
+              ScanDouble(line,  18,  9, &xp)   &&
+              ScanDouble(line,  37,  9, &yp)   &&
+              ScanDouble(line, 116,  9, &deps) &&
+              ScanDouble(line,  97,  9, &dpsi))) {
+            // Reached end of useable fields in the file
+            break;
+        }
+
+        // The Standards of Fundamental Astronomy expects angles in 
+        // units of radians, so xp, yp, deps, and dpsi need to be converted
+        nut_mjd.push_back( mjd );
+        nut_dut1.push_back( dut1 );
+        nut_xp.push_back( xp * DAS2R );      // arcsec -> radians
+        nut_yp.push_back( yp * DAS2R );      // arcsec -> radians
+        nut_deps.push_back( deps * DMAS2R ); // marcsec -> radians
+        nut_dpsi.push_back( dpsi * DMAS2R ); // marcsec -> radians
+    }
+
+    // If the range misses the file entirely then read the whole file
+    // instead, so that lookups report the dates the file covers
+    if (nut_mjd.empty() && (!at_start || !at_end)) {
+        return ReadNutation(filename, -HUGE_VAL, HUGE_VAL);
+    }
+    if (nut_mjd.empty()) {
+        std::cerr << "ERROR Unable to load corrections from file: " 
+                  << filename << std::endl;
+        return nullptr;
+    }
+
+    // Pack the columns into the table
+    table->size = nut_mjd.size();
+    table->data.reserve(6 * table->size);
+    table->data.insert(table->data.end(), nut_mjd.begin(), nut_mjd.end());
+    table->data.insert(table->data.end(), nut_dut1.begin(), nut_dut1.end());
+    table->data.insert(table->data.end(), nut_xp.begin(), nut_xp.end());
+    table->data.insert(table->data.end(), nut_yp.begin(), nut_yp.end());
+    table->data.insert(table->data.end(), nut_deps.begin(), nut_deps.end());
+    table->data.insert(table->data.end(), nut_dpsi.begin(), nut_dpsi.end());
+    SetColumns(table.get(), table->data.data());
+    PrepareTable(table.get());
+    table->load_time = Seconds(start);
+
+    // A table that stops short of either end of the file covers the dates
+    // of its rows, apart from those next to the rows that were left out
+    std::size_t edge = std::min(edge_rows, table->size - 1);
+    if (!at_start) {
+        table->cover_min = std::min(range_min, table->mjd[edge]);
+    }
+    if (!at_end) {
+        table->cover_max = std::max(range_max, table->mjd[table->size - 1 - edge]);
+    }
+
+    // Store the binary version for next time (unless there is no file, or
+    // the table only holds part of it)
+    if (!embedded && at_start && at_end) {
+        WriteBinaryTable(cache_file, sources, 6,
+                         table->size, table->data.data());
+    }
+
+    return table;
+}
+
+
+/**********************************************************************//**
+ * Loads the TT-UT1 correction values
+ * 
+ * @param[in]  mjd_min      First date the table needs to cover
+ * @param[in]  mjd_max      Last date the table needs to cover
+ * @param[out] filename     Historic TT-UT1 file used (optional, for error messages)
+ * @return Whether or not the load was successful
+ *************************************************************************/
+bool CECorrections::LoadTtUt1(const double& mjd_min,
+                              const double& mjd_max,
+                              std::string*  filename) const
+{
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    if (filename != nullptr) {
+        *filename = ttut1_file_hist_;
+    }
+
+    // Another thread may have loaded a suitable table in the meantime
+    const TtUt1Table* current = ttut1_.get();
+    if ((current != nullptr) &&
+        !(mjd_min < current->cover_min) && !(mjd_max > current->cover_max)) {
+        return true;
+    }
+
+    // Extend the range of dates to cover the requested ones
+    ExtendRange(mjd_min, mjd_max, &range_min_, &range_max_);
+
+    std::shared_ptr<const TtUt1Table> table =
+        ReadTtUt1(ttut1_file_hist_, ttut1_file_pred_, range_min_, range_max_);
+    if (table == nullptr) {
+        return false;
+    }
+
+    RecordLoad(&ttut1_stats_, table->load_time, table->size);
+
+    // Publish the table (lookups may still be using the one it replaces)
+    PublishTtUt1(table);
+    return true;
+}
+
+
+/**********************************************************************//**
+ * Read the TT-UT1 correction values
+ * 
+ * @param[in] hist_file     Historic TT-UT1 corrections file
+ * @param[in] pred_file     Predicted TT-UT1 corrections file
+ * @param[in] range_min     First date the table needs to cover
+ * @param[in] range_max     Last date the table needs to cover
+ * @return New TT-UT1 table (nullptr if the files could not be read)
+ * 
+ * The files are small, so they are always parsed in full and only the
+ * rows needed for the range of dates are kept.
+ *************************************************************************/
+std::shared_ptr<const CECorrections::TtUt1Table>
+    CECorrections::ReadTtUt1(const std::string& hist_file,
+                             const std::string& pred_file,
+                             const double&      range_min,
+                             const double&      range_max) const
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    ttut1_tables.fetch_add(1, std::memory_order_relaxed);
+    std::shared_ptr<TtUt1Table> table(new TtUt1Table, [](TtUt1Table* t) {
+        delete t;
+        ttut1_tables.fetch_sub(1, std::memory_order_relaxed);
+    });
+    table->cover_min = -HUGE_VAL;
+    table->cover_max = HUGE_VAL;
+
+    // Use the binary cache if it is still up to date
+    std::string              cache_file = hist_file + ".bin";
+    std::vector<std::string> sources = {hist_file, pred_file};
+    const double* columns = nullptr;
+    table->mapping = MapBinaryTable(cache_file, sources, 2,
+                                    &table->size, &columns);
+    if (table->mapping != nullptr) {
+        SetColumns(table.get(), columns);
+        PrepareTable(table.get());
+        table->load_time = Seconds(start);
+        return table;
+    }
+
+    // Check if the file has been stored
+    std::string       url = "http://maia.usno.navy.mil/ser7/deltat.data";
+    std::vector<char> buffer;
+    bool              hist_embedded;
+    if (!ReadCorrectionsFile(hist_file, url, &buffer, &hist_embedded)) {
+        std::cerr << "ERROR Unable to read corrections file: " 
+                  << hist_file << std::endl;
+        return nullptr;
+    }
+
+    // Allocate an approximate amount of memory for the values
+    std::vector<double> ttut1_mjd;
+    std::vector<double> ttut1_delt;
+    ttut1_mjd.reserve(5000);
+    ttut1_delt.reserve(5000);
+
+    // Preliminary storage values
+    int    year;
+    int    month;
+    int    day;
+    double mjd0;
+    double mjd;
+    double delt;
+
+    // Loop through each line of the file
+    const char* pos = buffer.data();
+    const char* end = pos + buffer.size();
+    CETextLine  line;
+    while (NextLine(&pos, end, &line)) {
+
+        // Extract the Gregorian date and convert it to MJD
+        // (a bad day still produces a date, as in CEDate)
+        if (!(ScanInt(line, 1, 4, &year)  &&
+              ScanInt(line, 6, 2, &month) &&
+              ScanInt(line, 9, 2, &day))  ||
+            (iauCal2jd(year, month, day, &mjd0, &mjd) < -2)) {
+            break;
+        }
+
+        // Try to load delta T from the file
+        if (!ScanDouble(line, 13, 7, &delt)) {
+            // Reached end of useable fields in the file
+            break;
+        }
+
+        // Store the values into a vector
+        ttut1_mjd.push_back( mjd );
+        ttut1_delt.push_back( delt );
+    }
+
+    // Load the predicted corrections for the future
+    url = "http://maia.usno.navy.mil/ser7/deltat.preds";
+    bool pred_embedded;
+    if (!ReadCorrectionsFile(pred_file, url, &buffer, &pred_embedded)) {
+        std::cerr << "ERROR Unable to read corrections file: " 
+                  << pred_file << std::endl;
+        return nullptr;
+    }
+
+    // Loop through each line of the file
+    pos = buffer.data();
+    end = pos + buffer.size();
+    NextLine(&pos, end, &line);   // First line is a header
+    while (NextLine(&pos, end, &line)) {
+
+        // Extract the MJD
+        int pred_mjd;
+        if (!ScanInt(line, 3, 9, &pred_mjd)) {
+            break;
+        }
+
+        // Only add this value if it is actually from a later date
+        // than the last entry in the vector
+        if (ttut1_mjd.empty() || (pred_mjd > ttut1_mjd.back())) {
+
+            // Try to load delta T from the file
+            if (!ScanDouble(line, 24, 5, &delt)) {
+                // Reached end of useable fields in the file
+                break;
+            }
+
+            // Store the values into a vector
+            ttut1_mjd.push_back( pred_mjd );
+            ttut1_delt.push_back( delt );
+        }
+    }
+    if (ttut1_mjd.empty()) {
+        std::cerr << "ERROR Unable to load corrections from file: " 
+                  << hist_file << std::endl;
+        return nullptr;
+    }
+
+    // Keep the rows for the range of dates, plus a margin of rows either
+    // side for interpolating (the rows are not evenly spaced)
+    std::size_t first = 0;
+    std::size_t last  = ttut1_mjd.size();
+    if (range_min > -HUGE_VAL) {
+        first = std::lower_bound(ttut1_mjd.begin(), ttut1_mjd.end(), range_min)
+                - ttut1_mjd.begin();
+        first = (first > ttut1_margin) ? first - ttut1_margin : 0;
+    }
+    if (range_max < HUGE_VAL) {
+        last = std::upper_bound(ttut1_mjd.begin(), ttut1_mjd.end(), range_max)
+               - ttut1_mjd.begin();
+        last = std::min(last + ttut1_margin, ttut1_mjd.size());
+    }
+    if ((first > 0) && (last > first)) {
+        std::size_t edge = std::min(edge_rows, last - first - 1);
+        table->cover_min = std::min(range_min, ttut1_mjd[first + edge]);
+    }
+    if ((last < ttut1_mjd.size()) && (last > first)) {
+        std::size_t edge = std::min(edge_rows, last - first - 1);
+        table->cover_max = std::max(range_max, ttut1_mjd[last - 1 - edge]);
+    }
+
+    // Pack the columns into the table
+    table->size = last - first;
+    table->data.reserve(2 * table->size);
+    table->data.insert(table->data.end(), ttut1_mjd.begin() + first,
+                                          ttut1_mjd.begin() + last);
+    table->data.insert(table->data.end(), ttut1_delt.begin() + first,
+                                          ttut1_delt.begin() + last);
+    SetColumns(table.get(), table->data.data());
+    PrepareTable(table.get());
+    table->load_time = Seconds(start);
+
+    // Store the binary version for next time (unless there is no file, or
+    // the table only holds part of it)
+    if (!hist_embedded && !pred_embedded && (table->size == ttut1_mjd.size())) {
+        WriteBinaryTable(cache_file, sources, 2, 
+                         table->size, table->data.data());
+    }
+
+    return table;
+}
+
+
+/**********************************************************************//**
+ * Replace the nutation table with one read from the current file
+ * 
+ * @return Whether the table was replaced (true if it was never loaded)
+ *************************************************************************/
+bool CECorrections::ReloadNutation(void)
+{
+    // Get the file to read, nothing to do if the table isn't used yet
+    std::string filename;
+    double      range_min;
+    double      range_max;
+    {
+        std::lock_guard<std::mutex> lock(load_mutex_);
+        if (nutation_ == nullptr) {
+            return true;
+        }
+        filename  = nutation_file_;
+        range_min = range_min_;
+        range_max = range_max_;
+    }
+
+    // Parse the file while lookups continue on the current table
+    std::shared_ptr<const NutationTable> table;
+    try {
+        table = ReadNutation(filename, range_min, range_max);
+    } catch (std::exception& e) {
+        // Handled below
+        table = nullptr;
+    }
+    if (table == nullptr) {
+        std::cerr << "[ERROR] Unable to reload nutation corrections from "
+                  << filename << ", keeping the current values" << std::endl;
+        return false;
+    }
+    RecordLoad(&nutation_stats_, table->load_time, table->size);
+
+    // Swap in the new table. The old one is freed once lookups part way
+    // through it (and the lookup caches holding it) are done with it.
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    PublishNutation(table);
+    return true;
+}
+
+
+/**********************************************************************//**
+ * Replace the TT-UT1 table with one read from the current files
+ * 
+ * @return Whether the table was replaced (true if it was never loaded)
+ *************************************************************************/
+bool CECorrections::ReloadTtUt1(void)
+{
+    // Get the files to read, nothing to do if the table isn't used yet
+    std::string hist_file;
+    std::string pred_file;
+    double      range_min;
+    double      range_max;
+    {
+        std::lock_guard<std::mutex> lock(load_mutex_);
+        if (ttut1_ == nullptr) {
+            return true;
+        }
+        hist_file = ttut1_file_hist_;
+        pred_file = ttut1_file_pred_;
+        range_min = range_min_;
+        range_max = range_max_;
+    }
+
+    // Parse the files while lookups continue on the current table
+    std::shared_ptr<const TtUt1Table> table;
+    try {
+        table = ReadTtUt1(hist_file, pred_file, range_min, range_max);
+    } catch (std::exception& e) {
+        // Handled below
+        table = nullptr;
+    }
+    if (table == nullptr) {
+        std::cerr << "[ERROR] Unable to reload TT-UT1 corrections from "
+                  << hist_file << ", keeping the current values" << std::endl;
+        return false;
+    }
+    RecordLoad(&ttut1_stats_, table->load_time, table->size);
+
+    // Swap in the new table
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    PublishTtUt1(table);
+    return true;
+}
+
+
+/**********************************************************************//**
+ * Replace the published nutation table (the caller holds 'load_mutex_')
+ * 
+ * @param[in] table         New nutation table (nullptr to unload it)
+ *************************************************************************/
+void CECorrections::PublishNutation(const std::shared_ptr<const NutationTable>& table) const
+{
+    std::atomic_store(&nutation_, table);
+    nutation_ptr_.store(table.get(), std::memory_order_release);
+}
+
+
+/**********************************************************************//**
+ * Replace the published TT-UT1 table (the caller holds 'load_mutex_')
+ * 
+ * @param[in] table         New TT-UT1 table (nullptr to unload it)
+ *************************************************************************/
+void CECorrections::PublishTtUt1(const std::shared_ptr<const TtUt1Table>& table) const
+{
+    std::atomic_store(&ttut1_, table);
+    ttut1_ptr_.store(table.get(), std::memory_order_release);
+}
+
+
+/**********************************************************************//**
+ * Wait for a prefetch started by Prefetch() to finish (if any)
+ * 
+ * A failed prefetch is not reported here, the caller's own attempt to load
+ * the table reports the error.
+ *************************************************************************/
+void CECorrections::WaitPrefetch(void) const
+{
+    std::shared_future<bool> prefetch;
+    {
+        std::lock_guard<std::mutex> lock(load_mutex_);
+        prefetch = prefetch_;
+    }
+    if (prefetch.valid()) {
+        prefetch.wait();
+    }
+}
+
+
+/**********************************************************************//**
+ * Stop the file watching thread (if running)
+ *************************************************************************/
+void CECorrections::StopWatch(void)
+{
+    if (watch_thread_.joinable()) {
+        watch_stop_.store(true);
+        watch_thread_.join();
+    }
+}
+
+
+/**********************************************************************//**
+ * Body of the file watching thread
+ * 
+ * @param[in] started       Set once the files are watched (false on failure)
+ * 
+ * The directories holding the correction files are watched rather than
+ * the files themselves, so that files replaced by a rename are noticed.
+ *************************************************************************/
+void CECorrections::WatchLoop(std::promise<bool> started)
+{
+    #ifdef __linux__
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "[ERROR] Unable to watch the corrections files: "
+                  << std::strerror(errno) << std::endl;
+        started.set_value(false);
+        return;
+    }
+
+    // Files to watch and which table each of them belongs to
+    struct WatchedFile {
+        int         wd;
+        std::string name;
+        bool        nutation;
+    };
+    std::vector<WatchedFile> files;
+    std::vector<std::string> filenames;
+    {
+        std::lock_guard<std::mutex> lock(load_mutex_);
+        filenames = {nutation_file_, ttut1_file_hist_, ttut1_file_pred_};
+    }
+    for (std::size_t i=0; i<filenames.size(); i++) {
+        std::size_t slash = filenames[i].find_last_of('/');
+        std::string dir   = (slash == std::string::npos) ? 
+                            "." : filenames[i].substr(0, slash+1);
+        std::string name  = (slash == std::string::npos) ? 
+                            filenames[i] : filenames[i].substr(slash+1);
+        int wd = inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (wd >= 0) {
+            files.push_back({wd, name, i == 0});
+        }
+    }
+    if (files.empty()) {
+        std::cerr << "[ERROR] Unable to watch the corrections files: "
+                  << std::strerror(errno) << std::endl;
+        close(fd);
+        started.set_value(false);
+        return;
+    }
+    started.set_value(true);
+
+    // Wait for events, checking regularly whether to stop
+    alignas(struct inotify_event) char buffer[4096];
+    while (!watch_stop_.load()) {
+        struct pollfd pfd = {fd, POLLIN, 0};
+        if (poll(&pfd, 1, 100) <= 0) {
+            continue;
+        }
+
+        // Find which tables need reloading from all pending events
+        bool reload_nutation = false;
+        bool reload_ttut1    = false;
+        ssize_t len;
+        while ((len = read(fd, buffer, sizeof(buffer))) > 0) {
+            for (char* ptr=buffer; ptr<buffer+len; 
+                 ptr += sizeof(struct inotify_event) + 
+                        reinterpret_cast<struct inotify_event*>(ptr)->len) {
+                const struct inotify_event* event = 
+                    reinterpret_cast<struct inotify_event*>(ptr);
+                if (event->len == 0) {
+                    continue;
+                }
+                for (std::size_t i=0; i<files.size(); i++) {
+                    if ((event->wd == files[i].wd) && 
+                        (files[i].name == event->name)) {
+                        reload_nutation |= files[i].nutation;
+                        reload_ttut1    |= !files[i].nutation;
+                    }
+                }
+            }
+        }
+
+        if (reload_nutation) {
+            ReloadNutation();
+        }
+        if (reload_ttut1) {
+            ReloadTtUt1();
+        }
+    }
+
+    close(fd);
+    #else
+    started.set_value(false);
+    #endif
+}
+
+
+/**********************************************************************//**
+ * Point the columns of a nutation table at contiguous column storage
+ * 
+ * @param[in,out] table     Nutation table (with 'size' already set)
+ * @param[in]     columns   Start of the six contiguous columns
+ *************************************************************************/
+void CECorrections::SetColumns(NutationTable* table, const double* columns)
+{
+    table->mjd  = columns;
+    table->dut1 = columns + table->size;
+    table->xp   = columns + 2*table->size;
+    table->yp   = columns + 3*table->size;
+    table->deps = columns + 4*table->size;
+    table->dpsi = columns + 5*table->size;
+}
+
+
+/**********************************************************************//**
+ * Point the columns of a TT-UT1 table at contiguous column storage
+ * 
+ * @param[in,out] table     TT-UT1 table (with 'size' already set)
+ * @param[in]     columns   Start of the two contiguous columns
+ *************************************************************************/
+void CECorrections::SetColumns(TtUt1Table* table, const double* columns)
+{
+    table->mjd  = columns;
+    table->delt = columns + table->size;
+}
+
+
+/**********************************************************************//**
+ * Return the published nutation table, loading it if necessary
+ * 
+ * @param[in] mjd_min       First date that will be looked up
+ * @param[in] mjd_max       Last date that will be looked up
+ * @return Loaded nutation table
+ *************************************************************************/
+std::shared_ptr<const CECorrections::NutationTable>
+    CECorrections::Nutation(const double& mjd_min,
+                            const double& mjd_max) const
+{
+    // Check for an already published table covering the dates
+    std::shared_ptr<const NutationTable> table = std::atomic_load(&nutation_);
+
+    // Otherwise load it (or extend the dates it covers), after any prefetch
+    // which may already be loading it
+    if ((table == nullptr) || (mjd_min < table->cover_min) || (mjd_max > table->cover_max)) {
+        // The file name is copied while loading (it may be changed by
+        // another thread)
+        std::string filename;
+        WaitPrefetch();
+        LoadNutation(mjd_min, mjd_max, &filename);
+        table = std::atomic_load(&nutation_);
+        if (table == nullptr) {
+            std::string msg = "Unable to load corrections file: " + filename;
+            throw CEException::corr_file_load_error(__func__, msg);
+        }
+    }
+
+    return table;
+}
+
+
+/**********************************************************************//**
+ * Return the published TT-UT1 table, loading it if necessary
+ * 
+ * @param[in] mjd_min       First date that will be looked up
+ * @param[in] mjd_max       Last date that will be looked up
+ * @return Loaded TT-UT1 table
+ *************************************************************************/
+std::shared_ptr<const CECorrections::TtUt1Table>
+    CECorrections::TtUt1(const double& mjd_min,
+                         const double& mjd_max) const
+{
+    // Check for an already published table covering the dates
+    std::shared_ptr<const TtUt1Table> table = std::atomic_load(&ttut1_);
+
+    // Otherwise load it (or extend the dates it covers), after any prefetch
+    // which may already be loading it
+    if ((table == nullptr) || (mjd_min < table->cover_min) || (mjd_max > table->cover_max)) {
+        std::string filename;
+        WaitPrefetch();
+        LoadTtUt1(mjd_min, mjd_max, &filename);
+        table = std::atomic_load(&ttut1_);
+        if (table == nullptr) {
+            std::string msg = "Unable to load corrections file: " + filename;
+            throw CEException::corr_file_load_error(__func__, msg);
+        }
+    }
+
+    return table;
+}
+
+
+/**********************************************************************//**
+ * Return the published nutation table covering an array of dates
+ * 
+ * @param[in] mjd           Modified Julian dates that will be looked up
+ * @param[in] n             Number of dates
+ * @return Loaded nutation table
+ *************************************************************************/
+std::shared_ptr<const CECorrections::NutationTable>
+    CECorrections::Nutation(const double*      mjd,
+                            const std::size_t& n) const
+{
+    // A table covering all dates needs no check of the dates
+    std::shared_ptr<const NutationTable> table = std::atomic_load(&nutation_);
+    if ((table != nullptr) &&
+        (table->cover_min == -HUGE_VAL) && (table->cover_max == HUGE_VAL)) {
+        return table;
+    }
+
+    double mjd_min = HUGE_VAL;
+    double mjd_max = -HUGE_VAL;
+    for (std::size_t i=0; i<n; i++) {
+        mjd_min = std::min(mjd_min, mjd[i]);
+        mjd_max = std::max(mjd_max, mjd[i]);
+    }
+    return Nutation(mjd_min, mjd_max);
+}
+
+
+/**********************************************************************//**
+ * Return the published TT-UT1 table covering an array of dates
+ * 
+ * @param[in] mjd           Modified Julian dates that will be looked up
+ * @param[in] n             Number of dates
+ * @return Loaded TT-UT1 table
+ *************************************************************************/
+std::shared_ptr<const CECorrections::TtUt1Table>
+    CECorrections::TtUt1(const double*      mjd,
+                         const std::size_t& n) const
+{
+    // A table covering all dates needs no check of the dates
+    std::shared_ptr<const TtUt1Table> table = std::atomic_load(&ttut1_);
+    if ((table != nullptr) &&
+        (table->cover_min == -HUGE_VAL) && (table->cover_max == HUGE_VAL)) {
+        return table;
+    }
+
+    double mjd_min = HUGE_VAL;
+    double mjd_max = -HUGE_VAL;
+    for (std::size_t i=0; i<n; i++) {
+        mjd_min = std::min(mjd_min, mjd[i]);
+        mjd_max = std::max(mjd_max, mjd[i]);
+    }
+    return TtUt1(mjd_min, mjd_max);
 }
 
 
 /**********************************************************************//**
  * Recompute cached values of nutation valeus if necessary
  * 
- * @param[in] mjd       Modified Julian date for lookup
+ * @param[in] mjd       Modified Julian date for lookup
+ * @return Thread-local cache holding the values for @p mjd
+ *************************************************************************/
+const CECorrections::NutationCache& CECorrections::UpdateNutationCache(const double& mjd) const
+{
+    const NutationTable* current = nutation_ptr_.load(std::memory_order_acquire);
+    CEInterpType         interp  = interp_.load(std::memory_order_relaxed);
+    CEExtrapType         extrap  = extrap_.load(std::memory_order_relaxed);
+    NutationCache&       cache   = cache_nut_;
+
+    // Check if the nutation actually needs to be updated. The cache holds
+    // the table its values came from, so a matching pointer can only mean
+    // that the published table is still that same table.
+    if ((current == nullptr) || (current != cache.table.get()) || (id_ != cache.owner) ||
+        (mjd != cache.mjd) || (interp != cache.interp) || (extrap != cache.extrap)) {
+        // While the published table is the one held by the cache (which
+        // keeps it alive) and covers the date, it is read directly. Only a
+        // new table or a date it doesn't cover goes through Nutation(),
+        // which locks the shared pointer.
+        std::shared_ptr<const NutationTable> ref;
+        if ((current == nullptr) || (current != cache.table.get()) ||
+            (mjd < current->cover_min) || (mjd > current->cover_max)) {
+            ref     = Nutation(mjd, mjd);
+            current = ref.get();
+        }
+        const NutationTable& table = *current;
+
+        // Compute the closest index associated with the MJD
+        int indx = FindIndex(table.index, table.mjd, table.size, mjd);
+        bool outside = (indx < 0) || (indx >= int(table.size)-1);
+        CountMiss(&nutation_stats_, outside, interp);
+
+        // Make sure the MJD date is covered by stored correction values
+        if (outside && (extrap == CEExtrapType::NONE)) {
+            RangeError(__func__, mjd, table.mjd, table.size);
+        } 
+
+        // Otherwise extrapolate the values
+        else if (outside) {
+            cache.dut1 = ExtrapValue(table, table.dut1, mjd, extrap);
+            cache.xp   = ExtrapValue(table, table.xp,   mjd, extrap);
+            cache.yp   = ExtrapValue(table, table.yp,   mjd, extrap);
+            cache.deps = ExtrapValue(table, table.deps, mjd, extrap);
+            cache.dpsi = ExtrapValue(table, table.dpsi, mjd, extrap);
+        }
+
+        // Get the uninterpolated value
+        else if (interp == CEInterpType::NONE) {
+            cache.dut1 = table.dut1[indx];
+            cache.xp   = table.xp[indx];
+            cache.yp   = table.yp[indx];
+            cache.deps = table.deps[indx];
+            cache.dpsi = table.dpsi[indx];
+        } 
+        
+        // Evaluate the precomputed cubic splines
+        else if (interp == CEInterpType::CUBIC) {
+            double        t      = mjd - table.mjd[indx];
+            const double* coeffs = &table.spline[20*indx];
+            cache.dut1 = SplineValue(coeffs,    t);
+            cache.xp   = SplineValue(coeffs+4,  t);
+            cache.yp   = SplineValue(coeffs+8,  t);
+            cache.deps = SplineValue(coeffs+12, t);
+            cache.dpsi = SplineValue(coeffs+16, t);
+        }
+
+        // Otherwise interpolate between closest two values (a bit slower)
+        else {
+            double mjd_lower( table.mjd[indx] );
+            double mjd_upper( table.mjd[indx+1] );
+            
+            cache.dut1 = InterpValue(mjd, mjd_lower, mjd_upper,
+                                     table.dut1[indx], table.dut1[indx+1]);
+            cache.xp   = InterpValue(mjd, mjd_lower, mjd_upper,
+                                     table.xp[indx], table.xp[indx+1]);
+            cache.yp   = InterpValue(mjd, mjd_lower, mjd_upper,
+                                     table.yp[indx], table.yp[indx+1]);
+            cache.deps = InterpValue(mjd, mjd_lower, mjd_upper,
+                                     table.deps[indx], table.deps[indx+1]);
+            cache.dpsi = InterpValue(mjd, mjd_lower, mjd_upper,
+                                     table.dpsi[indx], table.dpsi[indx+1]);
+        }
+
+        if (ref != nullptr) {
+            cache.table = ref;
+        }
+        cache.mjd    = mjd;
+        cache.interp = interp;
+        cache.extrap = extrap;
+        cache.status = outside ? CELookupStatus::EXTRAPOLATED : CELookupStatus::TABLE;
+        if (cache.owner != id_) {
+            cache.owner = id_;
+            cache.hits  = ThreadHits();
+        }
+    } else {
+        cache.hits->nutation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return cache;
+}
+
+
+/**********************************************************************//**
+ * Recompute cached values of TT-UT1 valeus if necessary
+ * 
+ * @param[in] mjd       Modified Julian date for lookup
+ * @return Thread-local cache holding the values for @p mjd
+ *************************************************************************/
+const CECorrections::TtUt1Cache& CECorrections::UpdateTtUt1Cache(const double& mjd) const
+{
+    const TtUt1Table* current = ttut1_ptr_.load(std::memory_order_acquire);
+    CEInterpType      interp  = interp_.load(std::memory_order_relaxed);
+    CEExtrapType      extrap  = extrap_.load(std::memory_order_relaxed);
+    TtUt1Cache&       cache   = cache_ttut1_;
+
+    // Check if the TT-UT1 value actually needs to be updated
+    if ((current == nullptr) || (current != cache.table.get()) || (id_ != cache.owner) ||
+        (mjd != cache.mjd) || (interp != cache.interp) || (extrap != cache.extrap)) {
+        // Read the table held by the cache directly while it is still the
+        // published one and covers the date (see UpdateNutationCache())
+        std::shared_ptr<const TtUt1Table> ref;
+        if ((current == nullptr) || (current != cache.table.get()) ||
+            (mjd < current->cover_min) || (mjd > current->cover_max)) {
+            ref     = TtUt1(mjd, mjd);
+            current = ref.get();
+        }
+        const TtUt1Table& table = *current;
+
+        // Compute the closest index associated with the MJD
+        int indx = FindIndex(table.index, table.mjd, table.size, mjd);
+        bool outside = (indx < 0) || (indx >= int(table.size)-1);
+        CountMiss(&ttut1_stats_, outside, interp);
+
+        // Make sure the MJD date is covered by stored correction values
+        if (outside && (extrap == CEExtrapType::NONE)) {
+            RangeError(__func__, mjd, table.mjd, table.size);
+        } 
+
+        // Otherwise extrapolate the value
+        else if (outside) {
+            cache.delt = ExtrapValue(table, mjd, extrap);
+        }
+
+        // Get the uninterpolated value
+        else if (interp == CEInterpType::NONE) {
+            cache.delt = table.delt[indx];
+        }
+
+        // Evaluate the precomputed cubic spline
+        else if (interp == CEInterpType::CUBIC) {
+            cache.delt = SplineValue(&table.spline[4*indx], mjd - table.mjd[indx]);
+        }
+        
+        // Otherwise interpolate between closest two values (a bit slower)
+        else {
+            double mjd_lower( table.mjd[indx] );
+            double mjd_upper( table.mjd[indx+1] );
+            
+            cache.delt = InterpValue(mjd, mjd_lower, mjd_upper,
+                                     table.delt[indx], table.delt[indx+1]);
+        }
+
+        if (ref != nullptr) {
+            cache.table = ref;
+        }
+        cache.mjd    = mjd;
+        cache.interp = interp;
+        cache.extrap = extrap;
+        cache.status = outside ? CELookupStatus::EXTRAPOLATED : CELookupStatus::TABLE;
+        if (cache.owner != id_) {
+            cache.owner = id_;
+            cache.hits  = ThreadHits();
+        }
+    } else {
+        cache.hits->ttut1.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return cache;
+}
+
+
+/**********************************************************************//**
+ * Build the lookup structures of a nutation table once its columns are set
+ * 
+ * @param[in,out] table     Nutation table
+ * 
+ * The cubic spline coefficients of all five columns are stored together
+ * for each row, so a lookup touches a single contiguous block. DUT1 is
+ * not smoothed across leap seconds.
+ *************************************************************************/
+void CECorrections::PrepareTable(NutationTable* table)
+{
+    BuildIndex(&table->index, table->mjd, table->size);
+
+    table->spline.assign(20 * std::max(table->size, std::size_t(1)), 0.0);
+    BuildSpline(table->mjd, table->dut1, table->size, 0.5, &table->spline[0],  20);
+    BuildSpline(table->mjd, table->xp,   table->size, 0.0, &table->spline[4],  20);
+    BuildSpline(table->mjd, table->yp,   table->size, 0.0, &table->spline[8],  20);
+    BuildSpline(table->mjd, table->deps, table->size, 0.0, &table->spline[12], 20);
+    BuildSpline(table->mjd, table->dpsi, table->size, 0.0, &table->spline[16], 20);
+
+    // UT1-UTC drift over the last month, less any leap seconds and the
+    // seasonal variations (for extrapolating past the end of the table)
+    table->dut1_rate = 0.0;
+    if (table->size > 1) {
+        std::size_t last  = table->size - 1;
+        std::size_t first = last;
+        double      drift = 0.0;
+        while ((first > 0) && (table->mjd[last] - table->mjd[first] < 30.0)) {
+            double step = table->dut1[first] - table->dut1[first-1];
+            drift += step - std::round(step);
+            first--;
+        }
+        drift += SeasonalUT2UT1(table->mjd[last]) - SeasonalUT2UT1(table->mjd[first]);
+        table->dut1_rate = drift / (table->mjd[last] - table->mjd[first]);
+    }
+}
+
+
+/**********************************************************************//**
+ * Build the lookup structures of a TT-UT1 table once its columns are set
+ * 
+ * @param[in,out] table     TT-UT1 table
+ *************************************************************************/
+void CECorrections::PrepareTable(TtUt1Table* table)
+{
+    BuildIndex(&table->index, table->mjd, table->size);
+
+    table->spline.assign(4 * std::max(table->size, std::size_t(1)), 0.0);
+    BuildSpline(table->mjd, table->delt, table->size, 0.0, &table->spline[0], 4);
+
+    // TT-UT1 trend over the last year (for extrapolating past the end)
+    table->delt_rate = 0.0;
+    if (table->size > 1) {
+        std::size_t last  = table->size - 1;
+        std::size_t first = last;
+        while ((first > 0) && (table->mjd[last] - table->mjd[first] < 365.0)) {
+            first--;
+        }
+        table->delt_rate = (table->delt[last] - table->delt[first]) / 
+                           (table->mjd[last] - table->mjd[first]);
+    }
+}
+
+
+/**********************************************************************//**
+ * Compute the coefficients of a natural cubic spline
+ * 
+ * @param[in]  x            Row positions (strictly increasing)
+ * @param[in]  y            Row values
+ * @param[in]  size         Number of rows
+ * @param[in]  max_jump     Steps in @p y larger than this are treated as
+ *                          discontinuities (0 to disable)
+ * @param[out] coeffs       Coefficients of the first row
+ * @param[in]  stride       Distance between the coefficients of consecutive rows
+ * 
+ * For each interval [x[i], x[i+1]] the four coefficients c0..c3 give the
+ * value as c0 + t*(c1 + t*(c2 + t*c3)) with t = x - x[i]. Intervals that
+ * contain a discontinuity are interpolated linearly and the splines on
+ * either side of them are computed separately.
+ *************************************************************************/
+void CECorrections::BuildSpline(const double*      x,
+                                const double*      y,
+                                const std::size_t& size,
+                                const double&      max_jump,
+                                double*            coeffs,
+                                const std::size_t& stride)
+{
+    std::vector<double> m(size, 0.0);     // Second derivatives
+    std::vector<double> diag(size, 0.0);
+    std::vector<double> rhs(size, 0.0);
+
+    std::size_t first = 0;
+    while (first + 1 < size) {
+
+        // Intervals containing a discontinuity are interpolated linearly
+        if ((max_jump > 0.0) && (std::fabs(y[first+1] - y[first]) > max_jump)) {
+            double* c = coeffs + stride*first;
+            c[0] = y[first];
+            c[1] = (y[first+1] - y[first]) / (x[first+1] - x[first]);
+            c[2] = 0.0;
+            c[3] = 0.0;
+            first++;
+            continue;
+        }
+
+        // Find the end of the continuous segment
+        std::size_t last = first + 1;
+        while ((last + 1 < size) && 
+               !((max_jump > 0.0) && (std::fabs(y[last+1] - y[last]) > max_jump))) {
+            last++;
+        }
+
+        // Solve the tridiagonal system for the second derivatives of this
+        // segment (natural boundary conditions: m = 0 at either end)
+        for (std::size_t i=first+1; i<last; i++) {
+            double h0 = x[i] - x[i-1];
+            double h1 = x[i+1] - x[i];
+            diag[i] = 2.0*(h0 + h1);
+            rhs[i]  = 6.0*((y[i+1] - y[i])/h1 - (y[i] - y[i-1])/h0);
+            if (i > first+1) {
+                double w = h0 / diag[i-1];
+                diag[i] -= w*h0;
+                rhs[i]  -= w*rhs[i-1];
+            }
+        }
+        m[first] = 0.0;
+        m[last]  = 0.0;
+        for (std::size_t i=last-1; i>first; i--) {
+            m[i] = (rhs[i] - (x[i+1] - x[i])*m[i+1]) / diag[i];
+        }
+
+        // Coefficients of each interval in the segment
+        for (std::size_t i=first; i<last; i++) {
+            double  h = x[i+1] - x[i];
+            double* c = coeffs + stride*i;
+            c[0] = y[i];
+            c[1] = (y[i+1] - y[i])/h - h*(2.0*m[i] + m[i+1])/6.0;
+            c[2] = 0.5*m[i];
+            c[3] = (m[i+1] - m[i])/(6.0*h);
+        }
+        first = last;
+    }
+}
+
+
+/**********************************************************************//**
+ * Build the index used to look up rows of a table by MJD
+ * 
+ * @param[out] index        Index to build
+ * @param[in]  mjd          MJD column of the table (sorted)
+ * @param[in]  size         Number of rows in the table
+ * 
+ * Uniformly spaced tables (such as the daily nutation table) are indexed
+ * arithmetically. Other tables are split into buckets no wider than the
+ * smallest row spacing, so each bucket holds at most one row. Tables
+ * that cannot be indexed this way are left to a binary search.
+ *************************************************************************/
+void CECorrections::BuildIndex(MJDIndex*          index,
+                               const double*      mjd,
+                               const std::size_t& size)
+{
+    index->start    = (size > 0) ? mjd[0] : 0.0;
+    index->step     = 0.0;
+    index->inv_step = 0.0;
+    index->uniform  = false;
+    index->bucket.clear();
+    if (size < 2) {
+        return;
+    }
+
+    // Check the row spacing
+    double step     = mjd[1] - mjd[0];
+    double min_step = step;
+    bool   uniform  = true;
+    for (std::size_t i=1; i<size; i++) {
+        double spacing = mjd[i] - mjd[i-1];
+        if (!(spacing > 0.0)) {
+            // Not strictly increasing
+            return;
+        }
+        uniform  = uniform && (mjd[i] == mjd[0] + i*step);
+        min_step = std::min(min_step, spacing);
+    }
+
+    // Uniformly spaced rows only need the spacing
+    if (uniform) {
+        index->step     = step;
+        index->inv_step = 1.0 / step;
+        index->uniform  = true;
+        return;
+    }
+
+    // Otherwise store the first row at or after the start of each bucket
+    std::size_t nbuckets = std::size_t((mjd[size-1] - mjd[0]) / min_step) + 1;
+    if (nbuckets > 8*size) {
+        return;
+    }
+    index->bucket.resize(nbuckets);
+    std::size_t row = 0;
+    for (std::size_t b=0; b<nbuckets; b++) {
+        double edge = mjd[0] + b*min_step;
+        while ((row < size) && (mjd[row] < edge)) {
+            row++;
+        }
+        index->bucket[b] = row;
+    }
+    index->step     = min_step;
+    index->inv_step = 1.0 / min_step;
+}
+
+
+/**********************************************************************//**
+ * Find the last row of a table whose MJD is before a given MJD
+ * 
+ * @param[in] index         Index of the table (see BuildIndex())
+ * @param[in] mjd           MJD column of the table
+ * @param[in] size          Number of rows in the table
+ * @param[in] x             MJD to look up
+ * @return Index of the last row with an MJD less than @p x (-1 if there is none)
+ *************************************************************************/
+int CECorrections::FindIndex(const MJDIndex&    index,
+                             const double*      mjd,
+                             const std::size_t& size,
+                             const double&      x)
+{
+    std::size_t row;
+
+    // Tables without an index need a binary search
+    if (index.inv_step == 0.0) {
+        row = std::lower_bound(mjd, mjd + size, x) - mjd;
+    }
+
+    // Otherwise get a first guess from the index
+    else {
+        double pos = (x - index.start) * index.inv_step;
+        if (!(pos > 0.0)) {
+            row = 0;
+        } else if (index.uniform) {
+            row = (pos < double(size)) ? std::size_t(std::ceil(pos)) : size;
+        } else {
+            std::size_t b = (pos < double(index.bucket.size())) 
+                            ? std::size_t(pos) : index.bucket.size()-1;
+            row = index.bucket[b];
+        }
+
+        // Correct for any rounding in the guess
+        while ((row < size) && (mjd[row] < x)) {
+            row++;
+        }
+        while ((row > 0) && (mjd[row-1] >= x)) {
+            row--;
+        }
+    }
+
+    return int(row) - 1;
+}
+
+
+/**********************************************************************//**
+ * Look up one column of a table for an array of dates
+ * 
+ * @param[in]  table_mjd    MJD column of the table
+ * @param[in]  column       Column to look up
+ * @param[in]  size         Number of rows in the table
+ * @param[in]  index        Index of @p table_mjd
+ * @param[in]  spline       Cubic spline coefficients of the first row of @p column
+ * @param[in]  stride       Distance between the coefficients of consecutive rows
+ * @param[in]  mjd          Modified Julian dates
+ * @param[out] values       Value of @p column at each date
+ * @param[in]  n            Number of dates
+ * 
+ * The rows are found first (see FindRows()) and the values are then
+ * computed in a separate loop with no data dependent branches. The values
+ * are identical to those of the single date lookups.
+ * 
+ * Dates outside of the table are passed to @p extrap, or throw if it is
+ * empty (CEExtrapType::NONE).
+ *************************************************************************/
+void CECorrections::BatchLookup(const double*      table_mjd,
+                                const double*      column,
+                                const std::size_t& size,
+                                const MJDIndex&    index,
+                                const double*      spline,
+                                const std::size_t& stride,
+                                const double*      mjd,
+                                double*            values,
+                                const std::size_t& n,
+                                CELookupStatus*    status,
+                                const std::function<double(const double&)>& extrap,
+                                TableCounters*     counters) const
+{
+    if (n == 0) {
+        return;
+    }
+    CEInterpType interp = interp_.load(std::memory_order_relaxed);
+    counters->batch_lookups.fetch_add(n, std::memory_order_relaxed);
+
+    std::vector<int>         rows;
+    std::vector<std::size_t> outside;
+    FindRows(table_mjd, size, index, mjd, n, bool(extrap), counters, &rows, &outside);
+    FillColumn(table_mjd, column, size, spline, stride, interp, mjd, &rows[0], values, n);
+    CountInterpolations(counters, n - outside.size(), interp);
+
+    // Finally fill in the dates outside of the table
+    if (status != nullptr) {
+        std::fill(status, status + n, CELookupStatus::TABLE);
+    }
+    for (std::size_t i : outside) {
+        values[i] = extrap(mjd[i]);
+        if (status != nullptr) {
+            status[i] = CELookupStatus::EXTRAPOLATED;
+        }
+    }
+}
+
+
+/**********************************************************************//**
+ * Find the rows of a table for an array of dates
+ * 
+ * @param[in]  table_mjd    MJD column of the table
+ * @param[in]  size         Number of rows in the table
+ * @param[in]  index        Index of @p table_mjd
+ * @param[in]  mjd          Modified Julian dates
+ * @param[in]  n            Number of dates
+ * @param[in]  extrap       Whether dates outside of the table are allowed
+ * @param[in]  counters     Counters of the table
+ * @param[out] rows         Row before each date (0 for dates outside of the table)
+ * @param[out] outside      Indices of the dates outside of the table
+ * 
+ * Sorted dates are handled in a single sweep that moves through the table
+ * alongside the dates, otherwise each date is searched for. Dates outside
+ * of the table throw unless @p extrap is set.
+ *************************************************************************/
+void CECorrections::FindRows(const double*             table_mjd,
+                             const std::size_t&        size,
+                             const MJDIndex&           index,
+                             const double*             mjd,
+                             const std::size_t&        n,
+                             const bool&               extrap,
+                             TableCounters*            counters,
+                             std::vector<int>*         rows,
+                             std::vector<std::size_t>* outside) const
+{
+    rows->resize(n);
+    outside->clear();
+    bool sorted = std::is_sorted(mjd, mjd + n);
+    int  indx   = (n > 0) ? FindIndex(index, table_mjd, size, mjd[0]) : -1;
+    for (std::size_t i=0; i<n; i++) {
+        if (sorted) {
+            while ((indx+1 < int(size)) && (table_mjd[indx+1] < mjd[i])) {
+                indx++;
+            }
+        } else {
+            indx = FindIndex(index, table_mjd, size, mjd[i]);
+        }
+        // (the last check catches NaN dates)
+        if ((indx < 0) || (indx >= int(size)-1) || !(mjd[i] > table_mjd[indx])) {
+            counters->range_errors.fetch_add(1, std::memory_order_relaxed);
+            if (!extrap) {
+                RangeError(__func__, mjd[i], table_mjd, size);
+            }
+            outside->push_back(i);
+            (*rows)[i] = 0;
+        } else {
+            (*rows)[i] = indx;
+        }
+    }
+}
+
+
+/**********************************************************************//**
+ * Compute one column of a table at dates whose rows are known
+ * 
+ * @param[in]  table_mjd    MJD column of the table
+ * @param[in]  column       Column to look up
+ * @param[in]  size         Number of rows in the table
+ * @param[in]  spline       Cubic spline coefficients of the first row of @p column
+ * @param[in]  stride       Distance between the coefficients of consecutive rows
+ * @param[in]  interp       Interpolation type
+ * @param[in]  mjd          Modified Julian dates
+ * @param[in]  rows         Row of each date (see FindRows())
+ * @param[out] values       Value of @p column at each date
+ * @param[in]  n            Number of dates
+ *************************************************************************/
+void CECorrections::FillColumn(const double*       table_mjd,
+                               const double*       column,
+                               const std::size_t&  size,
+                               const double*       spline,
+                               const std::size_t&  stride,
+                               const CEInterpType& interp,
+                               const double*       mjd,
+                               const int*          rows,
+                               double*             values,
+                               const std::size_t&  n) const
+{
+    // (a single row table covers no dates)
+    if (size < 2) {
+    } else if (interp == CEInterpType::CUBIC) {
+        for (std::size_t i=0; i<n; i++) {
+            int r = rows[i];
+            values[i] = SplineValue(spline + stride*r, mjd[i] - table_mjd[r]);
+        }
+    } else if (interp == CEInterpType::LINEAR) {
+        for (std::size_t i=0; i<n; i++) {
+            int r = rows[i];
+            values[i] = (column[r]*(table_mjd[r+1] - mjd[i]) + column[r+1]*(mjd[i] - table_mjd[r]))
+                        / (table_mjd[r+1] - table_mjd[r]);
+        }
+    } else {
+        for (std::size_t i=0; i<n; i++) {
+            values[i] = column[rows[i]];
+        }
+    }
+}
+
+
+/**********************************************************************//**
+ * Return the extrapolation used by the batched lookups of a nutation column
+ * 
+ * @param[in] table         Nutation table
+ * @param[in] column        Column to extrapolate (one of the table columns)
+ * @param[in] extrap        Extrapolation type
+ * @return Extrapolation function (empty for CEExtrapType::NONE)
  *************************************************************************/
-void CECorrections::UpdateTtUt1Cache(const double& mjd) const
+std::function<double(const double&)> 
+    CECorrections::ExtrapFunction(const NutationTable& table,
+                                  const double*        column,
+                                  const CEExtrapType&  extrap)
 {
-    // Check if the nutation actually needs to be updated
-    if (mjd != cache_ttut1_mjd_) {
-        // Make sure nutation corrections are loaded
-        LoadTtUt1();
+    std::function<double(const double&)> fn;
+    if (extrap != CEExtrapType::NONE) {
+        fn = [&table, column, extrap](const double& x) {
+            return ExtrapValue(table, column, x, extrap);
+        };
+    }
+    return fn;
+}
 
-        // Compute the closest index associated with the MJD
-        int indx = (std::lower_bound(ttut1_mjd_.begin(), ttut1_mjd_.end(), mjd)
-                    - ttut1_mjd_.begin()) - 1;
 
-        // Make sure the MJD date is covered by stored correction values
-        if ((indx < 0) || (indx >= ttut1_mjd_.size()-1)) {
-            // TODO: Make this a warning message
-            std::string min_mjd(std::to_string(ttut1_mjd_.front()));
-            std::string max_mjd(std::to_string(ttut1_mjd_.back()));
-            std::string msg = "Invalid mjd: " + std::to_string(mjd) + ". Accepted " +
-                            "range is " + min_mjd + " - " + max_mjd;
-            throw CEException::invalid_value(__func__, msg);
-        } 
+/**********************************************************************//**
+ * Return the extrapolation used by the batched TT-UT1 lookups
+ * 
+ * @param[in] table         TT-UT1 table
+ * @param[in] extrap        Extrapolation type
+ * @return Extrapolation function (empty for CEExtrapType::NONE)
+ *************************************************************************/
+std::function<double(const double&)> 
+    CECorrections::ExtrapFunction(const TtUt1Table&   table,
+                                  const CEExtrapType& extrap)
+{
+    std::function<double(const double&)> fn;
+    if (extrap != CEExtrapType::NONE) {
+        fn = [&table, extrap](const double& x) {
+            return ExtrapValue(table, x, extrap);
+        };
+    }
+    return fn;
+}
 
-        // Get the uninterpolated value
-        else if (!interp_) {
-            cache_ttut1_delt_ = ttut1_delt_[indx];
-        }
-        
-        // Otherwise interpolate between closest two values (a bit slower)
-        else {
-            double mjd_lower( ttut1_mjd_[indx] );
-            double mjd_upper( ttut1_mjd_[indx+1] );
-            
-            cache_ttut1_delt_ = InterpValue(mjd, mjd_lower, mjd_upper,
-                                            ttut1_delt_[indx], 
-                                            ttut1_delt_[indx+1]);
+
+/**********************************************************************//**
+ * Extrapolate a column of the nutation table
+ * 
+ * @param[in] table         Nutation table
+ * @param[in] column        Column to extrapolate (one of the table columns)
+ * @param[in] mjd           Modified Julian date outside of the table
+ * @param[in] extrap        Extrapolation type
+ * @return Extrapolated value
+ * 
+ * Dates before the table always use the first row, since the Bulletin A
+ * formulae are predictions.
+ *************************************************************************/
+double CECorrections::ExtrapValue(const NutationTable& table,
+                                  const double*        column,
+                                  const double&        mjd,
+                                  const CEExtrapType&  extrap)
+{
+    std::size_t last = table.size - 1;
+    if (std::isnan(mjd)) {
+        return mjd;
+    } else if (!(mjd > table.mjd[last])) {
+        return column[0];
+    }
+
+    // Continue from the last row with the Bulletin A model
+    double value = column[last];
+    if (extrap == CEExtrapType::BULLETIN_A) {
+        double mjd0 = table.mjd[last];
+        if (column == table.dut1) {
+            value += table.dut1_rate * (mjd - mjd0) - 
+                     (SeasonalUT2UT1(mjd) - SeasonalUT2UT1(mjd0));
+        } else if ((column == table.xp) || (column == table.yp)) {
+            double xp, yp, xp0, yp0;
+            PolarMotionTerms(mjd,  &xp,  &yp);
+            PolarMotionTerms(mjd0, &xp0, &yp0);
+            value += (column == table.xp) ? (xp - xp0) : (yp - yp0);
         }
+    }
+    return value;
+}
+
+
+/**********************************************************************//**
+ * Extrapolate the TT-UT1 table
+ * 
+ * @param[in] table         TT-UT1 table
+ * @param[in] mjd           Modified Julian date outside of the table
+ * @param[in] extrap        Extrapolation type
+ * @return Extrapolated TT-UT1 (seconds)
+ *************************************************************************/
+double CECorrections::ExtrapValue(const TtUt1Table&   table,
+                                  const double&       mjd,
+                                  const CEExtrapType& extrap)
+{
+    std::size_t last = table.size - 1;
+    if (std::isnan(mjd)) {
+        return mjd;
+    } else if (!(mjd > table.mjd[last])) {
+        return table.delt[0];
+    }
+
+    // Continue the recent trend
+    double value = table.delt[last];
+    if (extrap == CEExtrapType::BULLETIN_A) {
+        value += table.delt_rate * (mjd - table.mjd[last]);
+    }
+    return value;
+}
+
+
+/**********************************************************************//**
+ * Throw the error for a date that is not covered by a table
+ * 
+ * @param[in] origin        Method that encountered the date
+ * @param[in] mjd           Modified Julian date
+ * @param[in] table_mjd     MJD column of the table
+ * @param[in] size          Number of rows in the table
+ *************************************************************************/
+void CECorrections::RangeError(const std::string& origin,
+                               const double&      mjd,
+                               const double*      table_mjd,
+                               const std::size_t& size)
+{
+    // TODO: Make this a warning message
+    std::string min_mjd(std::to_string(size ? table_mjd[0] : 0.0));
+    std::string max_mjd(std::to_string(size ? table_mjd[size-1] : 0.0));
+    std::string msg = "Invalid mjd: " + std::to_string(mjd) + ". Accepted " +
+                      "range is " + min_mjd + " - " + max_mjd;
+    throw CEException::invalid_value(origin, msg);
+}
+
+
+/**********************************************************************//**
+ * Add a table load to the usage statistics
+ * 
+ * @param[in,out] counters  Counters of the table
+ * @param[in]     load_time Time taken to load the table (seconds)
+ * @param[in]     rows      Number of rows in the table
+ *************************************************************************/
+void CECorrections::RecordLoad(TableCounters*     counters,
+                               const double&      load_time,
+                               const std::size_t& rows)
+{
+    counters->loads.fetch_add(1, std::memory_order_relaxed);
+    counters->load_ns.fetch_add(std::uint64_t(1.0e9 * load_time), 
+                                std::memory_order_relaxed);
+    counters->rows.fetch_add(rows, std::memory_order_relaxed);
+}
+
+
+/**********************************************************************//**
+ * Add a single date lookup that missed the cache to the usage statistics
+ * 
+ * @param[in,out] counters  Counters of the table
+ * @param[in]     outside   Whether the date is outside of the table
+ * @param[in]     interp    Interpolation type of the lookup
+ *************************************************************************/
+void CECorrections::CountMiss(TableCounters*      counters,
+                              const bool&         outside,
+                              const CEInterpType& interp)
+{
+    counters->cache_misses.fetch_add(1, std::memory_order_relaxed);
+    if (outside) {
+        counters->range_errors.fetch_add(1, std::memory_order_relaxed);
+    } else if (interp != CEInterpType::NONE) {
+        counters->interpolations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+
+/**********************************************************************//**
+ * Add the interpolated values of a batched lookup to the usage statistics
+ * 
+ * @param[in,out] counters  Counters of the table
+ * @param[in]     n         Number of dates inside of the table
+ * @param[in]     interp    Interpolation type of the lookup
+ *************************************************************************/
+void CECorrections::CountInterpolations(TableCounters*      counters,
+                                        const std::size_t&  n,
+                                        const CEInterpType& interp)
+{
+    if ((interp != CEInterpType::NONE) && (n > 0)) {
+        counters->interpolations.fetch_add(n, std::memory_order_relaxed);
+    }
+}
+
 
-        cache_ttut1_mjd_  = mjd;
+/**********************************************************************//**
+ * Return the cache hit counters of the calling thread
+ * 
+ * @return Hit counters of this object for the calling thread
+ * 
+ * Only called when a lookup cache is filled for a different object, the
+ * cache then keeps the pointer. The counters live until the object is
+ * destroyed (or assigned to).
+ *************************************************************************/
+CECorrections::HitCounters* CECorrections::ThreadHits(void) const
+{
+    std::thread::id             thread = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(hits_mutex_);
+    for (std::size_t i=0; i<hits_.size(); i++) {
+        if (hits_[i]->thread == thread) {
+            return hits_[i].get();
+        }
     }
 
-    return;
+    // First lookup of this thread
+    hits_.push_back(std::unique_ptr<HitCounters>(new HitCounters));
+    hits_.back()->thread = thread;
+    hits_.back()->nutation.store(0, std::memory_order_relaxed);
+    hits_.back()->ttut1.store(0, std::memory_order_relaxed);
+    return hits_.back().get();
+}
+
+
+/**********************************************************************//**
+ * Generate a new unique object identifier
+ * 
+ * @return Object identifier (never 0)
+ *************************************************************************/
+std::uint64_t CECorrections::NextObjectId(void)
+{
+    static std::atomic<std::uint64_t> next_id(1);
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+/**********************************************************************//**
+ * Read the usage statistics of a table
+ * 
+ * @param[in] counters      Counters of the table
+ * @param[in] cache_hits    Cache hits of the table summed over all threads
+ * @return Current values of the counters
+ *************************************************************************/
+CETableStats CECorrections::GetTableStats(const TableCounters& counters,
+                                          const std::uint64_t& cache_hits)
+{
+    CETableStats stats;
+    stats.loads          = counters.loads.load(std::memory_order_relaxed);
+    stats.load_time      = 1.0e-9 * counters.load_ns.load(std::memory_order_relaxed);
+    stats.rows           = counters.rows.load(std::memory_order_relaxed);
+    stats.cache_hits     = cache_hits;
+    stats.cache_misses   = counters.cache_misses.load(std::memory_order_relaxed);
+    stats.lookups        = counters.batch_lookups.load(std::memory_order_relaxed) +
+                           stats.cache_hits + stats.cache_misses;
+    stats.range_errors   = counters.range_errors.load(std::memory_order_relaxed);
+    stats.interpolations = counters.interpolations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+
+/**********************************************************************//**
+ * Reset the usage statistics of a table
+ * 
+ * @param[in,out] counters  Counters of the table
+ *************************************************************************/
+void CECorrections::ResetCounters(TableCounters* counters)
+{
+    counters->loads.store(0, std::memory_order_relaxed);
+    counters->load_ns.store(0, std::memory_order_relaxed);
+    counters->rows.store(0, std::memory_order_relaxed);
+    counters->batch_lookups.store(0, std::memory_order_relaxed);
+    counters->cache_misses.store(0, std::memory_order_relaxed);
+    counters->range_errors.store(0, std::memory_order_relaxed);
+    counters->interpolations.store(0, std::memory_order_relaxed);
 }
 
 
@@ -710,4 +2908,491 @@ double CECorrections::InterpValue(const double& x,
                                   const double& y0, const double& y1) const
 {
     return (y0*(x1 - x) + y1*(x - x0)) / (x1-x0);
-}
\ No newline at end of file
+}
+
+
+namespace {
+
+/**********************************************************************//**
+ * Get the size and modification time of a file
+ * 
+ * @param[in]  filename     Name of the file
+ * @param[out] stamp        Size and modification time of @p filename
+ * @return Whether the file exists
+ *************************************************************************/
+bool GetFileStamp(const std::string& filename, CEFileStamp* stamp)
+{
+    struct stat info;
+    if (stat(filename.c_str(), &info) != 0) {
+        return false;
+    }
+
+    stamp->size = info.st_size;
+    #ifdef __APPLE__
+    stamp->mtime_sec  = info.st_mtimespec.tv_sec;
+    stamp->mtime_nsec = info.st_mtimespec.tv_nsec;
+    #else
+    stamp->mtime_sec  = info.st_mtim.tv_sec;
+    stamp->mtime_nsec = info.st_mtim.tv_nsec;
+    #endif
+    return true;
+}
+
+
+/**********************************************************************//**
+ * Memory map a binary corrections cache
+ * 
+ * @param[in]  filename     Binary cache filename
+ * @param[in]  sources      Text files the cache was generated from
+ * @param[in]  ncols        Expected number of columns
+ * @param[out] nrows        Number of rows in each column
+ * @param[out] columns      Start of the contiguous columns
+ * @return Read-only mapping of the file (nullptr if the cache is missing,
+ *         malformed or out of date with respect to @p sources)
+ *************************************************************************/
+std::shared_ptr<const void> MapBinaryTable(const std::string&              filename,
+                                           const std::vector<std::string>& sources,
+                                           const std::size_t&              ncols,
+                                           std::size_t*                    nrows,
+                                           const double**                  columns)
+{
+    std::shared_ptr<const void> mapping;
+
+    // Get the current state of the source files
+    CEFileStamp stamps[2];
+    std::memset(stamps, 0, sizeof(stamps));
+    for (std::size_t i=0; i<sources.size() && i<2; i++) {
+        if (!GetFileStamp(sources[i], &stamps[i])) {
+            return mapping;
+        }
+    }
+
+    // Open and map the cache file
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return mapping;
+    }
+    struct stat info;
+    if ((fstat(fd, &info) != 0) || (std::size_t(info.st_size) < sizeof(CEBinaryHeader))) {
+        close(fd);
+        return mapping;
+    }
+    std::size_t length = info.st_size;
+    void* addr = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        return mapping;
+    }
+    mapping = std::shared_ptr<const void>(addr, [length](const void* ptr) {
+        munmap(const_cast<void*>(ptr), length);
+    });
+
+    // Make sure the cache is valid and describes the current source files
+    const CEBinaryHeader* header = static_cast<const CEBinaryHeader*>(addr);
+    if ((std::memcmp(header->magic, cache_magic, sizeof(cache_magic)) != 0) ||
+        (header->version    != cache_version) ||
+        (header->byte_order != cache_byte_order) ||
+        (header->ncols      != ncols) ||
+        (length != sizeof(CEBinaryHeader) + ncols * header->nrows * sizeof(double)) ||
+        (std::memcmp(header->sources, stamps, sizeof(stamps)) != 0)) {
+        mapping.reset();
+        return mapping;
+    }
+
+    *nrows   = header->nrows;
+    *columns = reinterpret_cast<const double*>(header + 1);
+    return mapping;
+}
+
+
+/**********************************************************************//**
+ * Write a binary corrections cache
+ * 
+ * @param[in] filename      Binary cache filename
+ * @param[in] sources       Text files the columns were parsed from
+ * @param[in] ncols         Number of columns
+ * @param[in] nrows         Number of rows in each column
+ * @param[in] columns       Start of the contiguous columns
+ * 
+ * The file is written under a temporary name and then renamed, so other
+ * processes never map a partially written cache. Failures (for instance
+ * a read-only corrections directory) are silently ignored since the cache
+ * is only an optimization.
+ *************************************************************************/
+void WriteBinaryTable(const std::string&              filename,
+                      const std::vector<std::string>& sources,
+                      const std::size_t&              ncols,
+                      const std::size_t&              nrows,
+                      const double*                   columns)
+{
+    // Fill the header
+    CEBinaryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+    header.version    = cache_version;
+    header.byte_order = cache_byte_order;
+    header.ncols      = ncols;
+    header.nrows      = nrows;
+    for (std::size_t i=0; i<sources.size() && i<2; i++) {
+        if (!GetFileStamp(sources[i], &header.sources[i])) {
+            return;
+        }
+    }
+
+    // Write the file
+    std::string tmpname = filename + ".tmp" + std::to_string(getpid());
+    std::FILE*  file    = std::fopen(tmpname.c_str(), "wb");
+    if (file == nullptr) {
+        return;
+    }
+    bool written = (std::fwrite(&header, sizeof(header), 1, file) == 1) &&
+                   (std::fwrite(columns, sizeof(double), ncols*nrows, file) == ncols*nrows);
+    written = (std::fclose(file) == 0) && written;
+
+    // Move it into place
+    if (!written || (std::rename(tmpname.c_str(), filename.c_str()) != 0)) {
+        std::remove(tmpname.c_str());
+    }
+}
+
+
+/**********************************************************************//**
+ * Read the full contents of a text file into memory
+ * 
+ * @param[in]  file         Open file
+ * @param[out] buffer       File contents
+ * @return Whether the file could be read
+ *************************************************************************/
+bool ReadTextFile(std::ifstream& file, std::vector<char>* buffer)
+{
+    file.seekg(0, std::ios::end);
+    std::streamoff length = file.tellg();
+    if (length < 0) {
+        return false;
+    }
+    file.seekg(0, std::ios::beg);
+    buffer->resize(std::size_t(length));
+    return file.read(buffer->data(), length).good() || (length == 0);
+}
+
+
+/**********************************************************************//**
+ * Get the copy of a corrections table compiled into the library
+ * 
+ * @param[in]  filename     Corrections file (only the name itself is used)
+ * @param[out] buffer       Content of the embedded table
+ * @return Whether there is an embedded table with the same name
+ *************************************************************************/
+bool GetEmbeddedFile(const std::string& filename, std::vector<char>* buffer)
+{
+    #ifdef CE_EMBED_CORRECTIONS
+    std::size_t slash = filename.find_last_of('/');
+    std::string name  = (slash == std::string::npos) ? 
+                        filename : filename.substr(slash+1);
+    for (std::size_t i=0; i<ce_embedded_count; i++) {
+        if (name == ce_embedded_names[i]) {
+            buffer->assign(ce_embedded_data[i], 
+                           ce_embedded_data[i] + ce_embedded_sizes[i]);
+            return true;
+        }
+    }
+    #endif
+    return false;
+}
+
+
+/**********************************************************************//**
+ * Get the next line from a text buffer
+ * 
+ * @param[in,out] pos       Start of the line (moved to the start of the next line)
+ * @param[in]     end       End of the buffer
+ * @param[out]    line      Extracted line (without the line ending)
+ * @return Whether a line was found
+ *************************************************************************/
+bool NextLine(const char** pos, const char* end, CETextLine* line)
+{
+    if (*pos >= end) {
+        return false;
+    }
+    const char* eol = static_cast<const char*>(std::memchr(*pos, '\n', end - *pos));
+    if (eol == nullptr) {
+        eol = end;
+    }
+    line->begin = *pos;
+    line->end   = ((eol > *pos) && (*(eol-1) == '\r')) ? eol - 1 : eol;
+    *pos        = (eol < end) ? eol + 1 : end;
+    return true;
+}
+
+
+/**********************************************************************//**
+ * Scan an integer from a fixed width column of a line
+ * 
+ * @param[in]  line         Line to scan
+ * @param[in]  start        First character of the column
+ * @param[in]  width        Width of the column
+ * @param[out] value        Scanned value
+ * @return Whether an integer was found
+ * 
+ * Like std::stoi, leading white space is skipped and anything following
+ * the number is ignored.
+ *************************************************************************/
+bool ScanInt(const CETextLine& line, const std::size_t& start,
+             const std::size_t& width, int* value)
+{
+    if (start >= std::size_t(line.end - line.begin)) {
+        return false;
+    }
+    const char* c   = line.begin + start;
+    const char* end = std::min(c + width, line.end);
+
+    // Skip white space and get the sign
+    while ((c < end) && (*c == ' ')) c++;
+    bool negative = (c < end) && (*c == '-');
+    if ((c < end) && ((*c == '-') || (*c == '+'))) c++;
+
+    // Accumulate the digits
+    const char* digits = c;
+    int         number = 0;
+    for (; (c < end) && (*c >= '0') && (*c <= '9'); c++) {
+        number = 10*number + (*c - '0');
+    }
+    if (c == digits) {
+        return false;
+    }
+
+    *value = negative ? -number : number;
+    return true;
+}
+
+
+/**********************************************************************//**
+ * Scan a floating point number from a fixed width column of a line
+ * 
+ * @param[in]  line         Line to scan
+ * @param[in]  start        First character of the column
+ * @param[in]  width        Width of the column
+ * @param[out] value        Scanned value
+ * @return Whether a number was found
+ * 
+ * Like std::stod, leading white space is skipped and anything following
+ * the number is ignored. Numbers with at most 15 significant digits and
+ * a small decimal exponent (which covers every column of the IERS files)
+ * are converted exactly with a single multiplication or division, other
+ * numbers are handed to std::strtod.
+ *************************************************************************/
+bool ScanDouble(const CETextLine& line, const std::size_t& start,
+                const std::size_t& width, double* value)
+{
+    static const double pow10[] = {1.0e0,  1.0e1,  1.0e2,  1.0e3,  1.0e4,
+                                   1.0e5,  1.0e6,  1.0e7,  1.0e8,  1.0e9,
+                                   1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14,
+                                   1.0e15, 1.0e16, 1.0e17, 1.0e18, 1.0e19,
+                                   1.0e20, 1.0e21, 1.0e22};
+
+    if (start >= std::size_t(line.end - line.begin)) {
+        return false;
+    }
+    const char* c   = line.begin + start;
+    const char* end = std::min(c + width, line.end);
+
+    // Skip white space and get the sign
+    while ((c < end) && (*c == ' ')) c++;
+    const char* first    = c;
+    bool        negative = (c < end) && (*c == '-');
+    if ((c < end) && ((*c == '-') || (*c == '+'))) c++;
+
+    // Accumulate the significant digits
+    std::uint64_t mantissa = 0;
+    int           ndigits  = 0;
+    int           exponent = 0;
+    int           nsig     = 0;
+    for (; (c < end) && (*c >= '0') && (*c <= '9'); c++, ndigits++) {
+        if ((mantissa != 0) || (*c != '0')) nsig++;
+        mantissa = 10*mantissa + (*c - '0');
+    }
+    if ((c < end) && (*c == '.')) {
+        for (c++; (c < end) && (*c >= '0') && (*c <= '9'); c++, ndigits++) {
+            if ((mantissa != 0) || (*c != '0')) nsig++;
+            mantissa = 10*mantissa + (*c - '0');
+            exponent--;
+        }
+    }
+    if (ndigits == 0) {
+        return false;
+    }
+
+    // Optional exponent
+    if ((c+1 < end) && ((*c == 'e') || (*c == 'E'))) {
+        const char* e   = c + 1;
+        bool        neg = (*e == '-');
+        if ((*e == '-') || (*e == '+')) e++;
+        if ((e < end) && (*e >= '0') && (*e <= '9')) {
+            int exp = 0;
+            for (; (e < end) && (*e >= '0') && (*e <= '9'); e++) {
+                exp = std::min(10*exp + (*e - '0'), 10000);
+            }
+            exponent += neg ? -exp : exp;
+            c = e;
+        }
+    }
+
+    // Exact conversion
+    if ((nsig <= 15) && (exponent >= -22) && (exponent <= 22)) {
+        double number = double(mantissa);
+        number = (exponent < 0) ? number / pow10[-exponent] : number * pow10[exponent];
+        *value = negative ? -number : number;
+        return true;
+    }
+
+    // Fall back on the C library for anything else
+    char        text[64];
+    std::size_t length = std::min(std::size_t(c - first), sizeof(text) - 1);
+    std::memcpy(text, first, length);
+    text[length] = '\0';
+    *value = std::strtod(text, nullptr);
+    return true;
+}
+
+
+/**********************************************************************//**
+ * Find the line for a given date in a text buffer with one line per day
+ *
+ * @param[in] begin         Start of the buffer
+ * @param[in] end           End of the buffer
+ * @param[in] start         First character of the MJD column
+ * @param[in] width         Width of the MJD column
+ * @param[in] mjd           Modified Julian date to find
+ * @return Start of the line for @p mjd (@p begin if it cannot be found)
+ *
+ * The line is located from the length of the first line, and is only
+ * returned if it holds the expected date. Otherwise the buffer has to be
+ * scanned from the start.
+ *************************************************************************/
+const char* FindDailyRow(const char* begin, const char* end,
+                         const std::size_t& start, const std::size_t& width,
+                         const double& mjd)
+{
+    // The first line gives the line length and the date of the first row
+    const char* next = begin;
+    CETextLine  line;
+    int         first_mjd;
+    if (!NextLine(&next, end, &line) ||
+        !ScanInt(line, start, width, &first_mjd)) {
+        return begin;
+    }
+    double row = std::floor(mjd - first_mjd);
+    if (!(row > 0.0) || (row >= double(end - begin) / (next - begin))) {
+        return begin;
+    }
+
+    // Check that the line holds the expected date
+    const char* pos = begin + std::size_t(row) * (next - begin);
+    int         row_mjd;
+    next = pos;
+    if (NextLine(&next, end, &line) &&
+        ScanInt(line, start, width, &row_mjd) &&
+        (row_mjd == first_mjd + int(row))) {
+        return pos;
+    }
+    return begin;
+}
+
+
+/**********************************************************************//**
+ * Format the usage statistics of a table as a JSON object
+ * 
+ * @param[in] stats         Table statistics
+ * @return JSON object (on a single line)
+ *************************************************************************/
+std::string TableStatsJSON(const CETableStats& stats)
+{
+    std::ostringstream json;
+    json << std::setprecision(9)
+         << "{\"loads\": "          << stats.loads
+         << ", \"load_time\": "     << stats.load_time
+         << ", \"rows\": "          << stats.rows
+         << ", \"lookups\": "       << stats.lookups
+         << ", \"cache_hits\": "    << stats.cache_hits
+         << ", \"cache_misses\": "  << stats.cache_misses
+         << ", \"range_errors\": "  << stats.range_errors
+         << ", \"interpolations\": " << stats.interpolations
+         << ", \"tables\": "        << stats.tables << "}";
+    return json.str();
+}
+
+
+/**********************************************************************//**
+ * Seasonal variation of UT1 used by IERS Bulletin A
+ * 
+ * @param[in] mjd           Modified Julian date
+ * @return UT2-UT1 (seconds)
+ *************************************************************************/
+double SeasonalUT2UT1(const double& mjd)
+{
+    // Only the fraction of the Besselian year matters
+    double t = D2PI * (mjd - 51544.03) / 365.2422;
+    return 0.022*std::sin(t) - 0.012*std::cos(t) 
+         - 0.006*std::sin(2.0*t) + 0.007*std::cos(2.0*t);
+}
+
+
+/**********************************************************************//**
+ * Periodic polar motion terms of the IERS Bulletin A prediction
+ * 
+ * @param[in]  mjd          Modified Julian date
+ * @param[out] xp           Annual and Chandler terms of x-polar motion (radians)
+ * @param[out] yp           Annual and Chandler terms of y-polar motion (radians)
+ * 
+ * The coefficients are refitted with every bulletin but change slowly.
+ * Since the prediction is anchored to the last row of the table only the
+ * periodic terms are needed.
+ *************************************************************************/
+void PolarMotionTerms(const double& mjd, double* xp, double* yp)
+{
+    double a = D2PI * (mjd - 60117.0) / 365.25;     // Annual
+    double c = D2PI * (mjd - 60117.0) / 435.0;      // Chandler
+    *xp = ( 0.1069*std::cos(a) - 0.0179*std::sin(a) 
+           -0.0019*std::cos(c) - 0.0143*std::sin(c)) * DAS2R;
+    *yp = (-0.0199*std::cos(a) - 0.0947*std::sin(a) 
+           -0.0143*std::cos(c) + 0.0019*std::sin(c)) * DAS2R;
+}
+
+
+/**********************************************************************//**
+ * Extend a range of dates so that it includes the requested dates
+ * 
+ * @param[in]     mjd_min   First date that needs to be covered
+ * @param[in]     mjd_max   Last date that needs to be covered
+ * @param[in,out] range_min Start of the range of dates
+ * @param[in,out] range_max End of the range of dates
+ * 
+ * The range grows by at least its own width (and at least the margin), so
+ * that dates moving steadily past the end of the range only reload the
+ * tables every so often rather than on every lookup.
+ *************************************************************************/
+void ExtendRange(const double& mjd_min, const double& mjd_max,
+                 double* range_min, double* range_max)
+{
+    double step = std::max(*range_max - *range_min, nutation_margin);
+    if (mjd_min < *range_min) {
+        *range_min = std::min(mjd_min, *range_min - step);
+    }
+    if (mjd_max > *range_max) {
+        *range_max = std::max(mjd_max, *range_max + step);
+    }
+}
+
+
+/**********************************************************************//**
+ * Get the time elapsed since a given time
+ * 
+ * @param[in] start         Start time
+ * @return Seconds elapsed since @p start
+ *************************************************************************/
+double Seconds(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
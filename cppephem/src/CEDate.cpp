@@ -27,14 +27,181 @@
   - GREGORIAN: Gregorian calendar date
  
  To set the date, use the CEDate::SetDate method.
+
+ The date is stored as a two-part Julian date (see the SOFA documentation
+ for why this is more precise than a single number). The Gregorian calendar
+ date is only computed the first time it is asked for, so that dates are
+ cheap to create and copy when only the (modified) Julian date is needed.
  */
 
+#include <cfloat>
 #include <cmath>
 #include <exception>
 #include <stdio.h>
+#include <thread>
 
 #include "CEDate.h"
 #include "CEException.h"
+#include "CELeapSeconds.h"
+#include "CETdbTt.h"
+
+namespace {
+
+    // Range of Julian dates accepted by iauJd2cal
+    const double jd2cal_min = -68569.5;
+    const double jd2cal_max = 1.0e9;
+
+    /**********************************************************************//**
+     * Single part Julian date -> Gregorian calendar date. This is iauJd2cal
+     * with the second part of the date fixed to zero, so the results are
+     * identical, written so that it can be inlined into the loops of the
+     * array converters.
+     *
+     * @return Whether the date is in the range accepted by iauJd2cal
+     *************************************************************************/
+    inline bool Jd2Cal(const double& dj,
+                       int*          iy,
+                       int*          im,
+                       int*          id,
+                       double*       fd)
+    {
+        if ((dj < jd2cal_min) || (dj > jd2cal_max)) {
+            *iy = 0;
+            *im = 0;
+            *id = 0;
+            *fd = 0.0;
+            return false;
+        }
+
+        // Separate day and fraction (where -0.5 <= fraction < 0.5)
+        double d  = (std::fabs(dj) < 0.5) ? 0.0 
+                  : ((dj < 0.0) ? std::ceil(dj - 0.5) : std::floor(dj + 0.5));
+        long   jd = long(d);
+
+        // Compensated summation of fraction+0.5 (the second part adds nothing)
+        double s  = 0.5 + (dj - d);
+        double cs = (0.5 - s) + (dj - d);
+        if (s >= 1.0) {
+            jd++;
+            s -= 1.0;
+        }
+        double f = s + cs;
+        cs = f - s;
+
+        // Deal with negative f
+        if (f < 0.0) {
+            f   = s + 1.0;
+            cs += (1.0 - f) + s;
+            s   = f;
+            f   = s + cs;
+            cs  = f - s;
+            jd--;
+        }
+
+        // Deal with f that is 1.0 or more (when rounded to double)
+        if ((f - 1.0) >= -DBL_EPSILON/4.0) {
+            double t = s - 1.0;
+            cs += (s - t) - 1.0;
+            s   = t;
+            f   = s + cs;
+            if (-DBL_EPSILON/2.0 < f) {
+                jd++;
+                f = (f > 0.0) ? f : 0.0;
+            }
+        }
+
+        // Express day in Gregorian calendar
+        long l = jd + 68569L;
+        long n = (4L * l) / 146097L;
+        l -= (146097L * n + 3L) / 4L;
+        long i = (4000L * (l + 1L)) / 1461001L;
+        l -= (1461L * i) / 4L - 31L;
+        long k = (80L * l) / 2447L;
+        *id = int(l - (2447L * k) / 80L);
+        l   = k / 11L;
+        *im = int(k + 2L - 12L * l);
+        *iy = int(100L * (n - 49L) + i + l);
+        *fd = f;
+        return true;
+    }
+
+
+    /**********************************************************************//**
+     * Gregorian calendar date -> Julian date, giving the same result as
+     * CEDate::GregorianVect2JD() (which uses iauCal2jd). As there, days
+     * outside of the month are accepted.
+     *
+     * @return Whether the year and month are accepted by iauCal2jd
+     *************************************************************************/
+    inline bool Cal2Jd(const int&    iy,
+                      const int&    im,
+                      const int&    id,
+                      const double& fd,
+                      double*       jd)
+    {
+        if ((iy < -4799) || (im < 1) || (im > 12)) {
+            *jd = 0.0;
+            return false;
+        }
+        int  my    = (im - 14) / 12;
+        long iypmy = long(iy + my);
+        double djm = double((1461L * (iypmy + 4800L)) / 4L
+                            + (367L * long(im - 2 - 12 * my)) / 12L
+                            - (3L * ((iypmy + 4900L) / 100L)) / 4L
+                            + long(id) - 2432076L);
+        *jd = DJM0 + djm + fd;
+        return true;
+    }
+
+
+    /**********************************************************************//**
+     * Split a Gregorian date formatted as YYYYMMDD.DD, as in
+     * CEDate::Gregorian2GregorianVect()
+     *************************************************************************/
+    inline void SplitGregorian(const double& gregorian,
+                               int*          iy,
+                               int*          im,
+                               int*          id,
+                               double*       fd)
+    {
+        double greg = std::fabs(gregorian);
+        double day  = int(std::floor(greg)) % 100;
+        double mon  = int(std::floor(greg - day)/100) % 100;
+        double year = int(std::floor(greg - day - 100*mon) / 10000);
+        *fd = greg - std::floor(greg);
+        *id = int(day);
+        *im = int(mon);
+        *iy = (gregorian < 0.0) ? -int(year) : int(year);
+    }
+
+
+    /**********************************************************************//**
+     * Join a Gregorian date into the YYYYMMDD.DD format, as in
+     * CEDate::GregorianVect2Gregorian()
+     *************************************************************************/
+    inline double JoinGregorian(const int&    iy,
+                                const int&    im,
+                                const int&    id,
+                                const double& fd)
+    {
+        double sign = (iy < 0) ? -1.0 : 1.0;
+        double ret  = std::fabs(double(iy)) * 10000 + im * 100.0 + id;
+        return sign * (ret + fd);
+    }
+
+
+    /**********************************************************************//**
+     * Report the dates that an array converter could not convert
+     *************************************************************************/
+    void WarnBadDates(const std::string& origin, const std::size_t& nbad)
+    {
+        if (nbad > 0) {
+            std::cerr << "[WARNING] " << origin << " :: " << nbad 
+                      << " bad date(s) were set to zero!" << std::endl;
+        }
+    }
+
+} // namespace
 
 /**********************************************************************//**
  * Constructor from some date format.
@@ -111,22 +278,26 @@ void CEDate::SetDate(const double&     date,
     // Fill the internal date storage objects based on the format of the input "date"
     if (time_format == CEDateType::JD) {
         // Save information based on julian date input
-        julian_date_ = date ;
-        mod_julian_date_ = JD2MJD(date) ;
-        gregorian_date_ = JD2Gregorian(date) ;
-        gregorian_date_vect_ = JD2GregorianVect(date) ;
+        jd1_ = date ;
+        jd2_ = 0.0 ;
+        gregorian_state_.store(CALENDAR_UNSET, std::memory_order_relaxed) ;
     } else if (time_format == CEDateType::MJD) {
         // Save information based on modified julian date input
-        julian_date_ = MJD2JD(date) ;
-        mod_julian_date_ = date ;
-        gregorian_date_ = MJD2Gregorian(date) ;
-        gregorian_date_vect_ = MJD2GregorianVect(date) ;
+        jd1_ = DJM0 ;
+        jd2_ = date ;
+        gregorian_state_.store(CALENDAR_UNSET, std::memory_order_relaxed) ;
     } else if (time_format == CEDateType::GREGORIAN) {
-        // Save information based on gregorian date input
-        julian_date_ = Gregorian2JD(date) ;
-        mod_julian_date_ = Gregorian2MJD(date) ;
+        // Save information based on gregorian date input, the calendar
+        // fields are already known in this case
+        std::vector<double> gregorian_vect = Gregorian2GregorianVect(date) ;
+        jd1_            = GregorianVect2JD(gregorian_vect) ;
+        jd2_            = 0.0 ;
         gregorian_date_ = date ;
-        gregorian_date_vect_ = Gregorian2GregorianVect(date) ;
+        year_           = int(gregorian_vect[0]) ;
+        month_          = int(gregorian_vect[1]) ;
+        day_            = int(gregorian_vect[2]) ;
+        day_fraction_   = gregorian_vect[3] ;
+        gregorian_state_.store(CALENDAR_SET, std::memory_order_release) ;
     } else {
         // Date type is invalid
         throw CEException::invalid_value("CEDate::SetDate()", 
@@ -148,6 +319,19 @@ void CEDate::SetDate(std::vector<double> date)
     SetDate(GregorianVect2JD(date)) ;
 }
 
+/**********************************************************************//**
+ * Set the date to the current time
+ * 
+ * Unlike SetDate() with its default argument, this keeps the current time
+ * as a two-part Julian date, so it is not rounded to the ~40 microsecond
+ * resolution of a single double holding a Julian date.
+ *************************************************************************/
+void CEDate::SetDateNow(void)
+{
+    CurrentJD(&jd1_, &jd2_) ;
+    gregorian_state_.store(CALENDAR_UNSET, std::memory_order_relaxed) ;
+}
+
 /**********************************************************************//**
  * Return the date in a given format
  * 
@@ -381,12 +565,13 @@ double CEDate::GregorianVect2MJD(std::vector<double> gregorian)
  *       ut11 and ut12.
  *    2) @p ut12 represents the UT1 in modified Julian date
  *    3) @p ut11 should be the conversion factor between JD and MJD
+ *    4) TAI-UTC is taken from the cached table in CELeapSeconds
  *************************************************************************/
 void CEDate::UTC2UT1(const double& mjd,
                      double*       ut11,
                      double*       ut12)
 {
-    iauUtcut1(CEDate::GetMJD2JDFactor(), mjd, CppEphem::dut1(mjd), ut11, ut12);
+    CELeapSeconds::UTC2UT1(mjd, CppEphem::dut1(mjd), ut11, ut12);
 }
 
 
@@ -407,10 +592,7 @@ void CEDate::UTC2TT(const double& mjd,
                     double*       tt1,
                     double*       tt2)
 {
-    // Convert UTC to UT1
-    CEDate::UTC2UT1(mjd, tt1, tt2);
-    // Convert UT1 to TT
-    iauUt1tt(*tt1, *tt2, CppEphem::ttut1(mjd), tt1, tt2) ;
+    CEDate::UTC2TT(mjd, CppEphem::eop(mjd), tt1, tt2);
 }
 
 
@@ -430,11 +612,65 @@ void CEDate::UTC2TT(const double& mjd,
 void CEDate::UTC2TDB(const double& mjd,
                      double*       tdb1,
                      double*       tdb2)
+{
+    CEDate::UTC2TDB(mjd, CppEphem::eop(mjd), tdb1, tdb2);
+}
+
+
+/**********************************************************************//**
+ * Convert the UTC MJD to UT1 JD using already known corrections
+ * 
+ * @param[in]  mjd          Input modified Julian date for computation
+ * @param[in]  eop          Earth orientation parameters at @p mjd
+ * @param[out] ut11         First part of returned UT1 in JD
+ * @param[out] ut12         Second part of returned UT1 in JD
+ *************************************************************************/
+void CEDate::UTC2UT1(const double& mjd,
+                     const CEEop&  eop,
+                     double*       ut11,
+                     double*       ut12)
+{
+    CELeapSeconds::UTC2UT1(mjd, eop.dut1, ut11, ut12);
+}
+
+
+/**********************************************************************//**
+ * Convert the UTC MJD to TT JD using already known corrections
+ * 
+ * @param[in]  mjd          Input modified Julian date for computation
+ * @param[in]  eop          Earth orientation parameters at @p mjd
+ * @param[out] tt1          First part of returned TT in JD
+ * @param[out] tt2          Second part of returned TT in JD
+ *************************************************************************/
+void CEDate::UTC2TT(const double& mjd,
+                    const CEEop&  eop,
+                    double*       tt1,
+                    double*       tt2)
+{
+    // Convert UTC to UT1
+    CEDate::UTC2UT1(mjd, eop, tt1, tt2);
+    // Convert UT1 to TT
+    iauUt1tt(*tt1, *tt2, eop.ttut1, tt1, tt2) ;
+}
+
+
+/**********************************************************************//**
+ * Convert the UTC MJD to TDB JD using already known corrections
+ * 
+ * @param[in]  mjd          Input modified Julian date for computation
+ * @param[in]  eop          Earth orientation parameters at @p mjd
+ * @param[out] tdb1         First part of returned TDB in JD
+ * @param[out] tdb2         Second part of returned TDB in JD
+ *************************************************************************/
+void CEDate::UTC2TDB(const double& mjd,
+                     const CEEop&  eop,
+                     double*       tdb1,
+                     double*       tdb2)
 {
     // Convert UTC to TT
-    CEDate::UTC2TT(mjd, tdb1, tdb2);
+    CEDate::UTC2TT(mjd, eop, tdb1, tdb2);
     // Convert TT to TDB
-    iauTttdb(*tdb1, *tdb2, 0.0, tdb1, tdb2) ;
+    iauTttdb(*tdb1, *tdb2, CETdbTt::TdbTt(*tdb1, *tdb2), tdb1, tdb2) ;
 }
 
 
@@ -463,7 +699,7 @@ double CEDate::dut1(const double&     date,
 double CEDate::dut1(void) const
 {
     // return the value associated with 'UT1-UTC'
-    return CppEphem::dut1(mod_julian_date_) ;
+    return CppEphem::dut1(CEDate::MJD()) ;
 }
 
 
@@ -481,7 +717,7 @@ double CEDate::dut1(void) const
 // double CEDate::dut1Error()
 // {
 //     // Return the error on the dut1 value
-//     return CppEphem::dut1Error(mod_julian_date_) ;
+//     return CppEphem::dut1Error(CEDate::MJD()) ;
 // }
 
 
@@ -507,7 +743,7 @@ double CEDate::xpolar(const double&     date,
  *************************************************************************/
 double CEDate::xpolar(void) const
 {
-    return CppEphem::xp( mod_julian_date_ ) ;
+    return CppEphem::xp( CEDate::MJD() ) ;
 }
 
 
@@ -533,7 +769,33 @@ double CEDate::ypolar(const double&     date,
  *************************************************************************/
 double CEDate::ypolar(void) const
 {
-    return CppEphem::yp( mod_julian_date_ ) ;
+    return CppEphem::yp( CEDate::MJD() ) ;
+}
+
+
+/**********************************************************************//**
+ * Earth orientation parameters for a given date
+ * 
+ * @param[in] date          Date object
+ * @param[in] date_type     Date format of @p date
+ * @return Earth orientation parameters for a given date
+ *************************************************************************/
+CEEop CEDate::eop(const double&     date, 
+                  const CEDateType& date_type)
+{
+    CEDate input_date(date, date_type) ;
+    return CppEphem::eop( input_date.MJD() ) ;
+}
+
+
+/**********************************************************************//**
+ * Earth orientation parameters for this date
+ * 
+ * @return DUT1, polar motion, nutation and TT-UT1 corrections for this date
+ *************************************************************************/
+CEEop CEDate::eop(void) const
+{
+    return CppEphem::eop( CEDate::MJD() ) ;
 }
 
 
@@ -582,6 +844,268 @@ std::vector<double> CEDate::Gregorian2GregorianVect(double gregorian)
 }
 
 
+/**********************************************************************//**
+ * Julian date -> modified Julian date conversion of an array of dates
+ * 
+ * @param[in]  jd               Julian dates
+ * @param[out] mjd              Modified Julian dates
+ * @param[in]  n                Number of dates
+ *************************************************************************/
+void CEDate::JD2MJD(const double* jd, double* mjd, const std::size_t& n)
+{
+    for (std::size_t i=0; i<n; i++) {
+        mjd[i] = jd[i] - DJM0;
+    }
+}
+
+
+/**********************************************************************//**
+ * Modified Julian date -> Julian date conversion of an array of dates
+ * 
+ * @param[in]  mjd              Modified Julian dates
+ * @param[out] jd               Julian dates
+ * @param[in]  n                Number of dates
+ *************************************************************************/
+void CEDate::MJD2JD(const double* mjd, double* jd, const std::size_t& n)
+{
+    for (std::size_t i=0; i<n; i++) {
+        jd[i] = mjd[i] + DJM0;
+    }
+}
+
+
+/**********************************************************************//**
+ * Julian date -> Gregorian calendar date conversion of an array of dates.
+ * Dates that iauJd2cal does not accept are set to zero.
+ * 
+ * @param[in]  jd               Julian dates
+ * @param[out] gregorian        Gregorian calendar dates formatted as YYYYMMDD.DD
+ * @param[in]  n                Number of dates
+ *************************************************************************/
+void CEDate::JD2Gregorian(const double* jd, double* gregorian, 
+                          const std::size_t& n)
+{
+    std::size_t nbad = 0;
+    for (std::size_t i=0; i<n; i++) {
+        int    iy, im, id;
+        double fd;
+        nbad += !Jd2Cal(jd[i], &iy, &im, &id, &fd);
+        gregorian[i] = JoinGregorian(iy, im, id, fd);
+    }
+    WarnBadDates("CEDate::JD2Gregorian()", nbad);
+}
+
+
+/**********************************************************************//**
+ * Modified Julian date -> Gregorian calendar date conversion of an array of
+ * dates. Dates that iauJd2cal does not accept are set to zero.
+ * 
+ * @param[in]  mjd              Modified Julian dates
+ * @param[out] gregorian        Gregorian calendar dates formatted as YYYYMMDD.DD
+ * @param[in]  n                Number of dates
+ *************************************************************************/
+void CEDate::MJD2Gregorian(const double* mjd, double* gregorian, 
+                           const std::size_t& n)
+{
+    std::size_t nbad = 0;
+    for (std::size_t i=0; i<n; i++) {
+        int    iy, im, id;
+        double fd;
+        nbad += !Jd2Cal(mjd[i] + DJM0, &iy, &im, &id, &fd);
+        gregorian[i] = JoinGregorian(iy, im, id, fd);
+    }
+    WarnBadDates("CEDate::MJD2Gregorian()", nbad);
+}
+
+
+/**********************************************************************//**
+ * Gregorian calendar date -> Julian date conversion of an array of dates.
+ * Dates with an invalid year or month are set to zero.
+ * 
+ * @param[in]  gregorian        Gregorian calendar dates formatted as YYYYMMDD.DD
+ * @param[out] jd               Julian dates
+ * @param[in]  n                Number of dates
+ *************************************************************************/
+void CEDate::Gregorian2JD(const double* gregorian, double* jd, 
+                          const std::size_t& n)
+{
+    std::size_t nbad = 0;
+    for (std::size_t i=0; i<n; i++) {
+        int    iy, im, id;
+        double fd;
+        SplitGregorian(gregorian[i], &iy, &im, &id, &fd);
+        nbad += !Cal2Jd(iy, im, id, fd, &jd[i]);
+    }
+    WarnBadDates("CEDate::Gregorian2JD()", nbad);
+}
+
+
+/**********************************************************************//**
+ * Gregorian calendar date -> modified Julian date conversion of an array
+ * of dates. Dates with an invalid year or month are set to -DJM0.
+ * 
+ * @param[in]  gregorian        Gregorian calendar dates formatted as YYYYMMDD.DD
+ * @param[out] mjd              Modified Julian dates
+ * @param[in]  n                Number of dates
+ *************************************************************************/
+void CEDate::Gregorian2MJD(const double* gregorian, double* mjd, 
+                           const std::size_t& n)
+{
+    Gregorian2JD(gregorian, mjd, n);
+    JD2MJD(mjd, mjd, n);
+}
+
+
+/**********************************************************************//**
+ * Julian date -> Gregorian calendar date conversion of an array of dates.
+ * Dates that iauJd2cal does not accept are set to zero.
+ * 
+ * @param[in]  jd               Julian dates
+ * @param[out] year             Gregorian calendar years
+ * @param[out] month            Gregorian calendar months
+ * @param[out] day              Gregorian calendar days
+ * @param[out] day_fraction     Gregorian calendar day fractions
+ * @param[in]  n                Number of dates
+ *************************************************************************/
+void CEDate::JD2GregorianVect(const double*      jd,
+                              int*               year,
+                              int*               month,
+                              int*               day,
+                              double*            day_fraction,
+                              const std::size_t& n)
+{
+    std::size_t nbad = 0;
+    for (std::size_t i=0; i<n; i++) {
+        nbad += !Jd2Cal(jd[i], &year[i], &month[i], &day[i], &day_fraction[i]);
+    }
+    WarnBadDates("CEDate::JD2GregorianVect()", nbad);
+}
+
+
+/**********************************************************************//**
+ * Modified Julian date -> Gregorian calendar date conversion of an array of
+ * dates. Dates that iauJd2cal does not accept are set to zero.
+ * 
+ * @param[in]  mjd              Modified Julian dates
+ * @param[out] year             Gregorian calendar years
+ * @param[out] month            Gregorian calendar months
+ * @param[out] day              Gregorian calendar days
+ * @param[out] day_fraction     Gregorian calendar day fractions
+ * @param[in]  n                Number of dates
+ *************************************************************************/
+void CEDate::MJD2GregorianVect(const double*      mjd,
+                               int*               year,
+                               int*               month,
+                               int*               day,
+                               double*            day_fraction,
+                               const std::size_t& n)
+{
+    std::size_t nbad = 0;
+    for (std::size_t i=0; i<n; i++) {
+        nbad += !Jd2Cal(mjd[i] + DJM0, &year[i], &month[i], &day[i], 
+                        &day_fraction[i]);
+    }
+    WarnBadDates("CEDate::MJD2GregorianVect()", nbad);
+}
+
+
+/**********************************************************************//**
+ * Gregorian calendar date -> Julian date conversion of an array of dates.
+ * Dates with an invalid year or month are set to zero.
+ * 
+ * @param[in]  year             Gregorian calendar years
+ * @param[in]  month            Gregorian calendar months
+ * @param[in]  day              Gregorian calendar days
+ * @param[in]  day_fraction     Gregorian calendar day fractions
+ * @param[out] jd               Julian dates
+ * @param[in]  n                Number of dates
+ *************************************************************************/
+void CEDate::GregorianVect2JD(const int*         year,
+                              const int*         month,
+                              const int*         day,
+                              const double*      day_fraction,
+                              double*            jd,
+                              const std::size_t& n)
+{
+    std::size_t nbad = 0;
+    for (std::size_t i=0; i<n; i++) {
+        nbad += !Cal2Jd(year[i], month[i], day[i], day_fraction[i], &jd[i]);
+    }
+    WarnBadDates("CEDate::GregorianVect2JD()", nbad);
+}
+
+
+/**********************************************************************//**
+ * Gregorian calendar date -> modified Julian date conversion of an array
+ * of dates. Dates with an invalid year or month are set to -DJM0.
+ * 
+ * @param[in]  year             Gregorian calendar years
+ * @param[in]  month            Gregorian calendar months
+ * @param[in]  day              Gregorian calendar days
+ * @param[in]  day_fraction     Gregorian calendar day fractions
+ * @param[out] mjd              Modified Julian dates
+ * @param[in]  n                Number of dates
+ *************************************************************************/
+void CEDate::GregorianVect2MJD(const int*         year,
+                               const int*         month,
+                               const int*         day,
+                               const double*      day_fraction,
+                               double*            mjd,
+                               const std::size_t& n)
+{
+    GregorianVect2JD(year, month, day, day_fraction, mjd, n);
+    JD2MJD(mjd, mjd, n);
+}
+
+
+/**********************************************************************//**
+ * Join arrays of Gregorian calendar years, months, days and day fractions
+ * into dates formatted as YYYYMMDD.DD
+ * 
+ * @param[in]  year             Gregorian calendar years
+ * @param[in]  month            Gregorian calendar months
+ * @param[in]  day              Gregorian calendar days
+ * @param[in]  day_fraction     Gregorian calendar day fractions
+ * @param[out] gregorian        Gregorian calendar dates formatted as YYYYMMDD.DD
+ * @param[in]  n                Number of dates
+ *************************************************************************/
+void CEDate::GregorianVect2Gregorian(const int*         year,
+                                     const int*         month,
+                                     const int*         day,
+                                     const double*      day_fraction,
+                                     double*            gregorian,
+                                     const std::size_t& n)
+{
+    for (std::size_t i=0; i<n; i++) {
+        gregorian[i] = JoinGregorian(year[i], month[i], day[i], day_fraction[i]);
+    }
+}
+
+
+/**********************************************************************//**
+ * Split an array of Gregorian dates formatted as YYYYMMDD.DD into years,
+ * months, days and day fractions
+ * 
+ * @param[in]  gregorian        Gregorian calendar dates formatted as YYYYMMDD.DD
+ * @param[out] year             Gregorian calendar years
+ * @param[out] month            Gregorian calendar months
+ * @param[out] day              Gregorian calendar days
+ * @param[out] day_fraction     Gregorian calendar day fractions
+ * @param[in]  n                Number of dates
+ *************************************************************************/
+void CEDate::Gregorian2GregorianVect(const double*      gregorian,
+                                     int*               year,
+                                     int*               month,
+                                     int*               day,
+                                     double*            day_fraction,
+                                     const std::size_t& n)
+{
+    for (std::size_t i=0; i<n; i++) {
+        SplitGregorian(gregorian[i], &year[i], &month[i], &day[i], &day_fraction[i]);
+    }
+}
+
+
 /**********************************************************************//**
  * Method for getting the number of seconds since midnight. Set the
  * 'utc_offset' in order to get local relative seconds since midnight.
@@ -632,20 +1156,33 @@ double CEDate::GetTime_UTC() const
  *************************************************************************/
 double CEDate::CurrentJD()
 {
-    // Get the current date information
-    time_t now ;
-    time (&now) ;
-    struct tm current_jd;
-    gmtime_r(&now, &current_jd) ;
-    
-    // Put this into a vector
-    std::vector<double> date_info = {current_jd.tm_year+1900.0,
-                                     current_jd.tm_mon+1.0,
-                                     current_jd.tm_mday*1.0,
-                                     CETime::CurrentUTC()/DAYSEC} ;
-    
-    // Convert the Gregorian date information into a Julian date
-    return GregorianVect2JD( date_info ) ;
+    double jd1;
+    double jd2;
+    CurrentJD(&jd1, &jd2) ;
+    return jd1 + jd2 ;
+}
+
+
+/**********************************************************************//**
+ * Static method for getting the current Julian date as a two-part date
+ * 
+ * @param[out] jd1          Julian date of the start of the current (MJD) day
+ * @param[out] jd2          Fraction of the day since midnight (UTC)
+ * 
+ * The system clock is read once, @p jd1 holds a whole number of days and
+ * @p jd2 keeps the time of day to nanosecond precision.
+ *************************************************************************/
+void CEDate::CurrentJD(double* jd1, double* jd2)
+{
+    // MJD of the Unix epoch (1970-01-01)
+    const std::int64_t unix_epoch_mjd(40587) ;
+
+    std::int64_t day ;
+    std::int64_t nanosec ;
+    CETime::CurrentUnixDay(&day, &nanosec) ;
+
+    *jd1 = DJM0 + double(unix_epoch_mjd + day) ;
+    *jd2 = double(nanosec) / (DAYSEC * 1.0e9) ;
 }
 
 
@@ -674,9 +1211,7 @@ CEDate::operator double() const
  * Free data members
  *************************************************************************/
 void CEDate::free_members(void)
-{
-    gregorian_date_vect_.clear();
-}
+{}
 
 
 /**********************************************************************//**
@@ -686,11 +1221,21 @@ void CEDate::free_members(void)
  *************************************************************************/
 void CEDate::copy_members(const CEDate& other)
 {
-    gregorian_date_vect_ = other.gregorian_date_vect_;
-    julian_date_         = other.julian_date_;
-    mod_julian_date_     = other.mod_julian_date_;
-    gregorian_date_      = other.gregorian_date_;
-    return_type_         = other.return_type_;
+    jd1_            = other.jd1_;
+    jd2_            = other.jd2_;
+    return_type_    = other.return_type_;
+
+    // The other date's Gregorian fields are only copied once they are set
+    if (other.gregorian_state_.load(std::memory_order_acquire) == CALENDAR_SET) {
+        gregorian_date_ = other.gregorian_date_;
+        year_           = other.year_;
+        month_          = other.month_;
+        day_            = other.day_;
+        day_fraction_   = other.day_fraction_;
+        gregorian_state_.store(CALENDAR_SET, std::memory_order_release);
+    } else {
+        gregorian_state_.store(CALENDAR_UNSET, std::memory_order_relaxed);
+    }
 }
 
 
@@ -699,9 +1244,47 @@ void CEDate::copy_members(const CEDate& other)
  *************************************************************************/
 void CEDate::init_members(void)
 {
-    gregorian_date_vect_ = std::vector<double>(4, 0.0);
-    julian_date_         = 0.0;
-    mod_julian_date_     = 0.0;
-    gregorian_date_      = 0.0;
-    return_type_         = CEDateType::JD ;
+    jd1_            = 0.0;
+    jd2_            = 0.0;
+    return_type_    = CEDateType::JD ;
+    gregorian_state_.store(CALENDAR_UNSET, std::memory_order_relaxed);
+    gregorian_date_ = 0.0;
+    year_           = 0;
+    month_          = 0;
+    day_            = 0;
+    day_fraction_   = 0.0;
+}
+
+
+/**********************************************************************//**
+ * Compute the Gregorian calendar fields from the stored Julian date.
+ * Calls the SOFA "iauJd2cal" function
+ * 
+ * Only one thread computes the fields, any other thread asking for them at
+ * the same time waits until they are set.
+ *************************************************************************/
+void CEDate::set_gregorian(void) const
+{
+    int state = CALENDAR_UNSET;
+    if (!gregorian_state_.compare_exchange_strong(state, CALENDAR_BUSY,
+                                                  std::memory_order_acquire)) {
+        while (gregorian_state_.load(std::memory_order_acquire) != CALENDAR_SET) {
+            std::this_thread::yield();
+        }
+        return;
+    }
+
+    if (iauJd2cal(jd1_, jd2_, &year_, &month_, &day_, &day_fraction_)) {
+        std::cerr << "[WARNING] CEDate::set_gregorian() :: Bad date (" << JD() << ")!" << std::endl ;
+        year_         = 0;
+        month_        = 0;
+        day_          = 0;
+        day_fraction_ = 0.0;
+    }
+
+    // Same format as CEDate::GregorianVect2Gregorian()
+    double sign     = (year_ < 0) ? -1.0 : 1.0;
+    gregorian_date_ = sign * (std::fabs(year_) * 10000.0 + month_ * 100.0 + 
+                              day_ + day_fraction_);
+    gregorian_state_.store(CALENDAR_SET, std::memory_order_release);
 }
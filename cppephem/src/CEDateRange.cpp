@@ -0,0 +1,370 @@
+/***************************************************************************
+ *  CEDateRange.cpp: CppEphem                                              *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+/** \class CEDateRange
+ CEDateRange is a sorted list of UTC dates (either evenly spaced or given
+ explicitly) together with each date in the other time scales used by SOFA
+ (UT1, TAI, TT and TDB) and the Earth rotation angle.
+
+ Stepping a CEDate through time and building a CETimeScales for each step
+ looks up the Earth orientation parameters one date at a time. This object
+ looks them up for the whole range at once using the batched lookups of
+ CECorrections (which walk each table once for sorted dates), then runs the
+ UTC -> UT1, TAI -> TT -> TDB chain over the range. The results are kept in one
+ array per time scale. As in CETimeScales, nothing is computed until one of
+ the time scales is first asked for, and a const range may be shared by
+ threads.
+
+ TimeScales() returns a single date of the range as an already computed
+ CETimeScales, which CESkyCoord, CEObserver, CEPlanet and CEBody accept
+ wherever they take a date. CEObservation::GetObservedCoords() computes the
+ observed coordinates for every date in a range.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include "CEDateRange.h"
+#include "CEException.h"
+#include "CELeapSeconds.h"
+#include "CESiderealTime.h"
+#include "CETdbTt.h"
+
+
+/**********************************************************************//**
+ * Default constructor (empty range)
+ *************************************************************************/
+CEDateRange::CEDateRange()
+{
+    init_members();
+}
+
+
+/**********************************************************************//**
+ * Constructor for evenly spaced dates
+ * 
+ * @param[in] start         First UTC date
+ * @param[in] stop          Last UTC date (included if it is on the grid)
+ * @param[in] step          Spacing of the dates (days)
+ * @param[in] date_format   Format of @p start and @p stop
+ *************************************************************************/
+CEDateRange::CEDateRange(const double&     start,
+                         const double&     stop,
+                         const double&     step,
+                         const CEDateType& date_format)
+{
+    init_members();
+
+    CEDate date_start(start, date_format);
+    double mjd_start = date_start.MJD();
+    double mjd_stop  = CEDate(stop, date_format).MJD();
+    if (!(step > 0.0)) {
+        throw CEException::invalid_value("CEDateRange::CEDateRange()",
+                                         "Step size must be positive");
+    } else if (mjd_stop < mjd_start) {
+        throw CEException::invalid_value("CEDateRange::CEDateRange()",
+                                         "Stop date is before the start date");
+    }
+
+    // The margin keeps a stop date that is on the grid. It has to allow for
+    // the rounding of a stop date computed as start + n*step (a relative
+    // error of ~1e-16 of the Julian date, which is ~1e-7 of a one minute
+    // step), so use Steps() when the number of dates is known.
+    std::size_t n = std::size_t(std::floor((mjd_stop - mjd_start)/step + 1.0e-6)) + 1;
+    set_steps(date_start, n, step);
+}
+
+
+/**********************************************************************//**
+ * Return a given number of evenly spaced dates
+ * 
+ * @param[in] start         First UTC date
+ * @param[in] n             Number of dates
+ * @param[in] step          Spacing of the dates (days)
+ * @param[in] date_format   Format of @p start
+ * @return Range of @p n dates starting at @p start
+ *************************************************************************/
+CEDateRange CEDateRange::Steps(const double&      start,
+                               const std::size_t& n,
+                               const double&      step,
+                               const CEDateType&  date_format)
+{
+    if (!(step > 0.0)) {
+        throw CEException::invalid_value("CEDateRange::Steps()",
+                                         "Step size must be positive");
+    }
+    CEDateRange range;
+    range.set_steps(CEDate(start, date_format), n, step);
+    return range;
+}
+
+
+/**********************************************************************//**
+ * Constructor from a list of dates
+ * 
+ * @param[in] dates         UTC dates (in increasing order)
+ * @param[in] date_format   Format of @p dates
+ *************************************************************************/
+CEDateRange::CEDateRange(const std::vector<double>& dates,
+                         const CEDateType&          date_format)
+{
+    init_members();
+
+    utc1_.resize(dates.size());
+    utc2_.resize(dates.size());
+    std::vector<double> mjd(dates.size());
+    for (std::size_t i=0; i<dates.size(); i++) {
+        CEDate date(dates[i], date_format);
+        utc1_[i] = date.JD1();
+        utc2_[i] = date.JD2();
+        mjd[i]   = date.MJD();
+    }
+    if (!std::is_sorted(mjd.begin(), mjd.end())) {
+        throw CEException::invalid_value("CEDateRange::CEDateRange()",
+                                         "Dates must be in increasing order");
+    }
+}
+
+
+/**********************************************************************//**
+ * Copy constructor
+ * 
+ * @param[in] other         CEDateRange object to copy
+ *************************************************************************/
+CEDateRange::CEDateRange(const CEDateRange& other)
+{
+    init_members();
+    copy_members(other);
+}
+
+
+/**********************************************************************//**
+ * Destructor
+ *************************************************************************/
+CEDateRange::~CEDateRange()
+{
+    free_members();
+}
+
+
+/**********************************************************************//**
+ * Copy assignment operator
+ * 
+ * @param[in] other         CEDateRange object to copy
+ * @return Reference to this object
+ *************************************************************************/
+CEDateRange& CEDateRange::operator=(const CEDateRange& other)
+{
+    if (this != &other) {
+        free_members();
+        init_members();
+        copy_members(other);
+    }
+    return *this;
+}
+
+
+/**********************************************************************//**
+ * Return date @p i of the range with all of its time scales computed
+ * 
+ * @param[in] i             Index of the date
+ * @return Time scales of date @p i
+ *************************************************************************/
+CETimeScales CEDateRange::TimeScales(const std::size_t& i) const
+{
+    if (i >= utc1_.size()) {
+        throw CEException::invalid_value("CEDateRange::TimeScales()",
+                                         "Index is outside of the date range");
+    }
+    if (state_.load(std::memory_order_acquire) != RANGE_SET) compute();
+
+    CETimeScales times;
+    times.SetDate(utc1_[i], utc2_[i], eop_[i]);
+    times.ut11_     = ut11_[i];
+    times.ut12_     = ut12_[i];
+    times.tai1_     = tai1_[i];
+    times.tai2_     = tai2_[i];
+    times.tt1_      = tt1_[i];
+    times.tt2_      = tt2_[i];
+    times.tdb1_     = tdb1_[i];
+    times.tdb2_     = tdb2_[i];
+    times.era_      = era_[i];
+    times.state_.store(CETimeScales::SCALES_SET, std::memory_order_release);
+    return times;
+}
+
+
+/**********************************************************************//**
+ * Compute the time scales for every date in the range
+ * 
+ * Only one thread computes the time scales, any other thread asking for
+ * them at the same time waits until they are set.
+ *************************************************************************/
+void CEDateRange::compute(void) const
+{
+    // Claim the computation, or wait for the thread that has claimed it
+    int state = RANGE_UNSET;
+    while (!state_.compare_exchange_weak(state, RANGE_BUSY,
+                                         std::memory_order_acquire)) {
+        if (state == RANGE_SET) {
+            return;
+        }
+        state = RANGE_UNSET;
+        std::this_thread::yield();
+    }
+
+    try {
+        compute_scales();
+    } catch (...) {
+        // Let the next caller try again (and see the error as well)
+        state_.store(RANGE_UNSET, std::memory_order_release);
+        throw;
+    }
+
+    state_.store(RANGE_SET, std::memory_order_release);
+}
+
+
+/**********************************************************************//**
+ * Fill in the time scales for every date in the range (see compute())
+ *************************************************************************/
+void CEDateRange::compute_scales(void) const
+{
+    std::size_t n = utc1_.size();
+    eop_.resize(n);
+    ut11_.resize(n);
+    ut12_.resize(n);
+    tai1_.resize(n);
+    tai2_.resize(n);
+    tt1_.resize(n);
+    tt2_.resize(n);
+    tdb1_.resize(n);
+    tdb2_.resize(n);
+    era_.resize(n);
+
+    if (n == 0) {
+        return;
+    }
+
+    // Look up the corrections for all dates at once
+    std::vector<double> mjd(n);
+    for (std::size_t i=0; i<n; i++) {
+        mjd[i] = MJD(i);
+    }
+    CppEphem::eop(&mjd[0], &eop_[0], n);
+
+    // Then the same chain as CETimeScales for each date
+    for (std::size_t i=0; i<n; i++) {
+        CELeapSeconds::UTC2TAI(utc1_[i], utc2_[i], &tai1_[i], &tai2_[i]);
+        CELeapSeconds::UTC2UT1(utc1_[i], utc2_[i], eop_[i].dut1, &ut11_[i], &ut12_[i]);
+        iauTaitt(tai1_[i], tai2_[i], &tt1_[i], &tt2_[i]);
+        iauTttdb(tt1_[i], tt2_[i], CETdbTt::TdbTt(tt1_[i], tt2_[i]), &tdb1_[i], &tdb2_[i]);
+    }
+
+    // Earth rotation angles for all dates at once
+    CESiderealTime::ERA(&ut11_[0], &ut12_[0], &era_[0], n);
+}
+
+
+/**********************************************************************//**
+ * Set evenly spaced dates
+ * 
+ * @param[in] start         First UTC date
+ * @param[in] n             Number of dates
+ * @param[in] step          Spacing of the dates (days)
+ *************************************************************************/
+void CEDateRange::set_steps(const CEDate&      start,
+                            const std::size_t& n,
+                            const double&      step)
+{
+    // Split the start date into whole days and a fraction of a day, so the
+    // steps are added to a small number and keep their resolution
+    double day1 = std::floor(start.JD1());
+    double day2 = std::floor(start.JD2());
+    double frac = (start.JD1() - day1) + (start.JD2() - day2);
+
+    // Each date is computed from the start (rather than by adding up the
+    // steps) so that rounding errors don't accumulate
+    utc1_.assign(n, day1 + day2);
+    utc2_.resize(n);
+    for (std::size_t i=0; i<n; i++) {
+        utc2_[i] = frac + i*step;
+    }
+    state_.store(RANGE_UNSET, std::memory_order_relaxed);
+}
+
+
+/**********************************************************************//**
+ * Free data members
+ *************************************************************************/
+void CEDateRange::free_members(void)
+{}
+
+
+/**********************************************************************//**
+ * Copy data members from another object
+ * 
+ * @param[in] other         CEDateRange object to copy from
+ *************************************************************************/
+void CEDateRange::copy_members(const CEDateRange& other)
+{
+    utc1_     = other.utc1_;
+    utc2_     = other.utc2_;
+
+    // The other range's time scales are only copied once they are set
+    if (other.state_.load(std::memory_order_acquire) == RANGE_SET) {
+        eop_  = other.eop_;
+        ut11_ = other.ut11_;
+        ut12_ = other.ut12_;
+        tai1_ = other.tai1_;
+        tai2_ = other.tai2_;
+        tt1_  = other.tt1_;
+        tt2_  = other.tt2_;
+        tdb1_ = other.tdb1_;
+        tdb2_ = other.tdb2_;
+        era_  = other.era_;
+        state_.store(RANGE_SET, std::memory_order_release);
+    } else {
+        state_.store(RANGE_UNSET, std::memory_order_relaxed);
+    }
+}
+
+
+/**********************************************************************//**
+ * Initialize the data members
+ *************************************************************************/
+void CEDateRange::init_members(void)
+{
+    utc1_.clear();
+    utc2_.clear();
+    state_.store(RANGE_UNSET, std::memory_order_relaxed);
+    eop_.clear();
+    ut11_.clear();
+    ut12_.clear();
+    tai1_.clear();
+    tai2_.clear();
+    tt1_.clear();
+    tt2_.clear();
+    tdb1_.clear();
+    tdb2_.clear();
+    era_.clear();
+}
@@ -0,0 +1,353 @@
+/***************************************************************************
+ *  CELeapSeconds.cpp: CppEphem                                            *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+/** \class CELeapSeconds
+ CELeapSeconds provides the UTC to TAI, UT1 and TT conversions using a
+ cached table of TAI-UTC (leap seconds) indexed by day.
+
+ SOFA's iauUtcut1 and iauUtctai look up TAI-UTC with iauDat, which scans
+ its list of leap seconds, up to three times per conversion. Here the
+ values given by iauDat are tabulated once for every day from 1972 (when
+ UTC switched to whole leap seconds) until the end of the period that the
+ linked SOFA release considers reliable, so each lookup is a single array
+ access. The arithmetic otherwise follows iauUtctai and iauTaiut1 exactly,
+ so the results are identical to calling SOFA directly. Dates outside of
+ the table (including the pre-1972 drifting UTC) are passed on to SOFA.
+ */
+
+#include "CELeapSeconds.h"
+#include "sofa.h"
+#include <sofam.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace {
+
+/**********************************************************************//**
+ * Split a two-part JD into the UTC day and the fraction of the day
+ * 
+ * @param[in]  u1           Larger part of the JD
+ * @param[in]  u2           Smaller part of the JD
+ * @param[out] day          Day (as an MJD)
+ * @param[out] fd           Fraction of the day
+ * 
+ * Gives the same day and fraction as iauJd2cal(u1, u2, ...), without the
+ * calendar conversion. For a date given as DJM0 + mjd the split is exact.
+ *************************************************************************/
+void SplitDay(const double& u1, const double& u2, double* day, double* fd)
+{
+    if (u1 == DJM0) {
+        *day = std::floor(u2);
+        *fd  = u2 - *day;
+        return;
+    }
+
+    // Compensated sum of the fractions, as in iauJd2cal
+    double jd   = std::round(u1) + std::round(u2);
+    double v[2] = {u1 - std::round(u1), u2 - std::round(u2)};
+    double s    = 0.5;
+    double cs   = 0.0;
+    for (int i = 0; i < 2; i++) {
+        double t = s + v[i];
+        cs += (std::fabs(s) >= std::fabs(v[i])) ? (s - t) + v[i]
+                                                : (v[i] - t) + s;
+        s = t;
+        if (s >= 1.0) {
+            jd += 1.0;
+            s  -= 1.0;
+        }
+    }
+    double f = s + cs;
+    cs = f - s;
+
+    // Fraction below zero: the date is in the previous day
+    if (f < 0.0) {
+        f   = s + 1.0;
+        cs += (1.0 - f) + s;
+        s   = f;
+        f   = s + cs;
+        cs  = f - s;
+        jd -= 1.0;
+    }
+
+    // Fraction rounding to one: the date is in the next day
+    if ((f - 1.0) >= -DBL_EPSILON / 4.0) {
+        double t = s - 1.0;
+        cs += (s - t) - 1.0;
+        s   = t;
+        f   = s + cs;
+        if (-DBL_EPSILON / 2.0 < f) {
+            jd += 1.0;
+            f   = std::max(f, 0.0);
+        }
+    }
+
+    *day = jd - (DJM0 + 0.5);
+    *fd  = f;
+}
+
+} // namespace
+
+
+/**********************************************************************//**
+ * Return TAI-UTC at the start of the UTC day containing a date
+ *
+ * @param[in] mjd           UTC modified Julian date
+ * @return TAI-UTC (seconds)
+ *************************************************************************/
+double CELeapSeconds::TaiUtc(const double& mjd)
+{
+    double tai1;
+    double tai2;
+    double dat;
+    if (!FastUTC2TAI(DJM0, mjd, &tai1, &tai2, &dat)) {
+        int    iy, im, id;
+        double fd;
+        iauJd2cal(DJM0, mjd, &iy, &im, &id, &fd);
+        iauDat(iy, im, id, 0.0, &dat);
+    }
+    return dat;
+}
+
+
+/**********************************************************************//**
+ * Convert a UTC MJD to TAI JD
+ *
+ * @param[in]  mjd          UTC modified Julian date
+ * @param[out] tai1         First part of returned TAI in JD (JD-MJD offset)
+ * @param[out] tai2         Second part of returned TAI in JD (TAI as MJD)
+ *************************************************************************/
+void CELeapSeconds::UTC2TAI(const double& mjd,
+                            double*       tai1,
+                            double*       tai2)
+{
+    UTC2TAI(DJM0, mjd, tai1, tai2);
+}
+
+
+/**********************************************************************//**
+ * Convert a two-part UTC JD to TAI JD
+ * 
+ * @param[in]  utc1         First part of the UTC quasi-JD
+ * @param[in]  utc2         Second part of the UTC quasi-JD
+ * @param[out] tai1         First part of returned TAI in JD
+ * @param[out] tai2         Second part of returned TAI in JD
+ * 
+ * Equivalent to iauUtctai(utc1, utc2, tai1, tai2). As in SOFA the larger
+ * part of the UTC date is returned unchanged as a part of the TAI date.
+ *************************************************************************/
+void CELeapSeconds::UTC2TAI(const double& utc1,
+                            const double& utc2,
+                            double*       tai1,
+                            double*       tai2)
+{
+    double dat;
+    if (!FastUTC2TAI(utc1, utc2, tai1, tai2, &dat)) {
+        iauUtctai(utc1, utc2, tai1, tai2);
+    }
+}
+
+
+/**********************************************************************//**
+ * Convert a UTC MJD to UT1 JD
+ *
+ * @param[in]  mjd          UTC modified Julian date
+ * @param[in]  dut1         UT1-UTC (seconds) at @p mjd
+ * @param[out] ut11         First part of returned UT1 in JD (JD-MJD offset)
+ * @param[out] ut12         Second part of returned UT1 in JD (UT1 as MJD)
+ *
+ * Equivalent to iauUtcut1(DJM0, mjd, dut1, ut11, ut12).
+ *************************************************************************/
+void CELeapSeconds::UTC2UT1(const double& mjd,
+                            const double& dut1,
+                            double*       ut11,
+                            double*       ut12)
+{
+    UTC2UT1(DJM0, mjd, dut1, ut11, ut12);
+}
+
+
+/**********************************************************************//**
+ * Convert a two-part UTC JD to UT1 JD
+ * 
+ * @param[in]  utc1         First part of the UTC quasi-JD
+ * @param[in]  utc2         Second part of the UTC quasi-JD
+ * @param[in]  dut1         UT1-UTC (seconds) at the date
+ * @param[out] ut11         First part of returned UT1 in JD
+ * @param[out] ut12         Second part of returned UT1 in JD
+ * 
+ * Equivalent to iauUtcut1(utc1, utc2, dut1, ut11, ut12).
+ *************************************************************************/
+void CELeapSeconds::UTC2UT1(const double& utc1,
+                            const double& utc2,
+                            const double& dut1,
+                            double*       ut11,
+                            double*       ut12)
+{
+    double tai1;
+    double tai2;
+    double dat;
+    if (FastUTC2TAI(utc1, utc2, &tai1, &tai2, &dat)) {
+        // TAI to UT1 (as in iauTaiut1)
+        double dtad = (dut1 - dat) / DAYSEC;
+        if (std::fabs(tai1) >= std::fabs(tai2)) {
+            *ut11 = tai1;
+            *ut12 = tai2 + dtad;
+        } else {
+            *ut11 = tai1 + dtad;
+            *ut12 = tai2;
+        }
+    } else {
+        iauUtcut1(utc1, utc2, dut1, ut11, ut12);
+    }
+}
+
+
+/**********************************************************************//**
+ * Convert a UTC MJD to TT JD using TT = TAI + 32.184s
+ *
+ * @param[in]  mjd          UTC modified Julian date
+ * @param[out] tt1          First part of returned TT in JD (JD-MJD offset)
+ * @param[out] tt2          Second part of returned TT in JD (TT as MJD)
+ *************************************************************************/
+void CELeapSeconds::UTC2TT(const double& mjd,
+                           double*       tt1,
+                           double*       tt2)
+{
+    double tai1;
+    double tai2;
+    UTC2TAI(mjd, &tai1, &tai2);
+    iauTaitt(tai1, tai2, tt1, tt2);
+}
+
+
+/**********************************************************************//**
+ * Return the first date covered by the cached table
+ *
+ * @return Modified Julian date of the first day in the table
+ *************************************************************************/
+double CELeapSeconds::FirstMJD(void)
+{
+    return GetTable().first_mjd;
+}
+
+
+/**********************************************************************//**
+ * Return the last date covered by the cached table
+ *
+ * @return Modified Julian date of the last day in the table
+ *
+ * Conversions for later dates are computed by SOFA directly.
+ *************************************************************************/
+double CELeapSeconds::LastMJD(void)
+{
+    const Table& table = GetTable();
+    return table.first_mjd + int(table.dat.size()) - 1;
+}
+
+
+/**********************************************************************//**
+ * Return the table of TAI-UTC values, building it on first use
+ *
+ * @return TAI-UTC table
+ *************************************************************************/
+const CELeapSeconds::Table& CELeapSeconds::GetTable(void)
+{
+    // Built once, initialization of a local static is thread safe
+    static const Table table = []() {
+        Table tab;
+        tab.first_mjd = 41317;      // 1972 January 1
+
+        // Tabulate every day until SOFA stops trusting its own values
+        int    iy, im, id;
+        double fd, dat;
+        for (int mjd=tab.first_mjd; ; mjd++) {
+            if ((iauJd2cal(DJM0, mjd, &iy, &im, &id, &fd) != 0) ||
+                (iauDat(iy, im, id, 0.0, &dat) != 0)) {
+                break;
+            }
+            tab.dat.push_back(static_cast<std::int8_t>(dat));
+        }
+        return tab;
+    }();
+
+    return table;
+}
+
+
+/**********************************************************************//**
+ * Convert UTC to TAI using the cached table
+ * 
+ * @param[in]  utc1         First part of the UTC quasi-JD
+ * @param[in]  utc2         Second part of the UTC quasi-JD
+ * @param[out] tai1         First part of returned TAI in JD
+ * @param[out] tai2         Second part of returned TAI in JD
+ * @param[out] dat          TAI-UTC at the start of the day (seconds)
+ * @return Whether the date (and the following day) is covered by the table
+ * 
+ * Follows iauUtctai. Since 1972 TAI-UTC does not drift during a day, so
+ * only a leap second at the end of the day needs to be accounted for.
+ *************************************************************************/
+bool CELeapSeconds::FastUTC2TAI(const double& utc1,
+                                const double& utc2,
+                                double*       tai1,
+                                double*       tai2,
+                                double*       dat)
+{
+    const Table& table = GetTable();
+
+    // Put the two parts in order of magnitude, as in iauUtctai
+    bool   big1 = (std::fabs(utc1) >= std::fabs(utc2));
+    double u1   = big1 ? utc1 : utc2;
+    double u2   = big1 ? utc2 : utc1;
+
+    // Split the date into the day (as an MJD) and fraction of the day
+    double day;
+    double fd;
+    SplitDay(u1, u2, &day, &fd);
+
+    // Today's and tomorrow's TAI-UTC (NaN fails the check as well)
+    double offset = day - table.first_mjd;
+    if (!((offset >= 0.0) && (offset + 1.0 < table.dat.size()))) {
+        return false;
+    }
+    std::size_t indx = static_cast<std::size_t>(offset);
+    double dat0  = table.dat[indx];
+    double dleap = table.dat[indx + 1] - dat0;
+
+    // Remove any scaling applied to spread a leap second into the day
+    fd *= (DAYSEC + dleap) / DAYSEC;
+
+    // Assemble the TAI, keeping the larger part of the UTC date
+    double a2 = DJM0 - u1;
+    a2 += day;
+    a2 += fd + dat0 / DAYSEC;
+    if (big1) {
+        *tai1 = u1;
+        *tai2 = a2;
+    } else {
+        *tai1 = a2;
+        *tai2 = u1;
+    }
+    *dat = dat0;
+    return true;
+}
@@ -103,6 +103,88 @@ void CppEphem::CorrectionsInterp(bool set_interp)
 }
 
 
+/**********************************************************************//**
+ * Set how the corrections object interpolates values
+ * 
+ * @param[in] interp_type       Interpolation type (see ::CEInterpType)
+ *************************************************************************/
+void CppEphem::CorrectionsInterp(const CEInterpType& interp_type)
+{
+    CppEphem::corrections.SetInterp(interp_type);
+}
+
+
+/**********************************************************************//**
+ * Set how the corrections object handles dates outside of its tables
+ * 
+ * @param[in] extrap_type       Extrapolation type (see ::CEExtrapType)
+ *************************************************************************/
+void CppEphem::CorrectionsExtrap(const CEExtrapType& extrap_type)
+{
+    CppEphem::corrections.SetExtrap(extrap_type);
+}
+
+
+/**********************************************************************//**
+ * Usage statistics of the corrections object (load times, lookups, etc.)
+ * 
+ * @return Statistics of the corrections object
+ *************************************************************************/
+CECorrectionsStats CppEphem::CorrectionsStats(void)
+{
+    return CppEphem::corrections.Stats();
+}
+
+
+/**********************************************************************//**
+ * Usage statistics of the corrections object as a JSON document
+ * 
+ * @return JSON object with the statistics of the corrections object
+ *************************************************************************/
+std::string CppEphem::CorrectionsStatsJSON(void)
+{
+    return CppEphem::corrections.StatsJSON();
+}
+
+
+/**********************************************************************//**
+ * Start loading the corrections tables on a background thread
+ * 
+ * @return Future holding whether the tables were loaded
+ * 
+ * Calling this early during start up keeps the cost of loading the tables
+ * out of the first conversion. Conversions that need the tables before
+ * they are loaded wait for the prefetch to finish.
+ *************************************************************************/
+std::shared_future<bool> CppEphem::PrefetchCorrections(void)
+{
+    return CppEphem::corrections.Prefetch();
+}
+
+
+/**********************************************************************//**
+ * Re-read the corrections files without interrupting ongoing lookups
+ * 
+ * @return Whether the loaded corrections could all be re-read
+ *************************************************************************/
+bool CppEphem::CorrectionsReload(void)
+{
+    return CppEphem::corrections.Reload();
+}
+
+
+/**********************************************************************//**
+ * Start or stop reloading the corrections whenever their files change
+ * 
+ * @param[in] watch             Whether to watch the corrections files
+ * @return Whether the files are now being watched (Linux only)
+ *************************************************************************/
+bool CppEphem::CorrectionsWatch(bool watch)
+{
+    return CppEphem::corrections.SetWatchFiles(watch);
+}
+
+
 /**********************************************************************//**
  * Return dut1 based on a given modified julian date (seconds)
  * 
@@ -200,6 +282,206 @@ double CppEphem::ttut1(const double& mjd)
 }
 
 
+/**********************************************************************//**
+ * Earth orientation parameters for a given MJD
+ * 
+ * @param[in] mjd       Modified Julian Date (MJD)
+ * @return DUT1, polar motion, nutation and TT-UT1 corrections for a given MJD
+ *************************************************************************/
+CEEop CppEphem::eop(const double& mjd)
+{
+    return corrections.eop(mjd);
+}
+
+
+/**********************************************************************//**
+ * DUT1 correction for a vector of modified julian dates (seconds)
+ * 
+ * @param[in] mjd       Modified Julian Dates (MJD)
+ * @return DUT1 correction for each MJD (seconds)
+ *************************************************************************/
+std::vector<double> CppEphem::dut1(const std::vector<double>& mjd)
+{
+    return corrections.dut1(mjd);
+}
+
+
+/**********************************************************************//**
+ * x-polar motion for a vector of modified julian dates (radians)
+ * 
+ * @param[in] mjd       Modified Julian Dates (MJD)
+ * @return x-polar motion for each MJD (radians)
+ *************************************************************************/
+std::vector<double> CppEphem::xp(const std::vector<double>& mjd)
+{
+    return corrections.xpolar(mjd);
+}
+
+
+/**********************************************************************//**
+ * y-polar motion for a vector of modified julian dates (radians)
+ * 
+ * @param[in] mjd       Modified Julian Dates (MJD)
+ * @return y-polar motion for each MJD (radians)
+ *************************************************************************/
+std::vector<double> CppEphem::yp(const std::vector<double>& mjd)
+{
+    return corrections.ypolar(mjd);
+}
+
+
+/**********************************************************************//**
+ * Earth obliquity correction for a vector of modified julian dates (radians)
+ * 
+ * @param[in] mjd       Modified Julian Dates (MJD)
+ * @return Earth obliquity correction for each MJD (radians)
+ *************************************************************************/
+std::vector<double> CppEphem::deps(const std::vector<double>& mjd)
+{
+    return corrections.deps(mjd);
+}
+
+
+/**********************************************************************//**
+ * Earth longitude correction for a vector of modified julian dates (radians)
+ * 
+ * @param[in] mjd       Modified Julian Dates (MJD)
+ * @return Earth longitude correction for each MJD (radians)
+ *************************************************************************/
+std::vector<double> CppEphem::dpsi(const std::vector<double>& mjd)
+{
+    return corrections.dpsi(mjd);
+}
+
+
+/**********************************************************************//**
+ * TT-UT1 correction for a vector of modified julian dates (seconds)
+ * 
+ * @param[in] mjd       Modified Julian Dates (MJD)
+ * @return TT-UT1 correction for each MJD (seconds)
+ *************************************************************************/
+std::vector<double> CppEphem::ttut1(const std::vector<double>& mjd)
+{
+    return corrections.ttut1(mjd);
+}
+
+
+/**********************************************************************//**
+ * Earth orientation parameters for a vector of modified julian dates
+ * 
+ * @param[in] mjd       Modified Julian Dates (MJD)
+ * @return DUT1, polar motion, nutation and TT-UT1 corrections for each MJD
+ *************************************************************************/
+std::vector<CEEop> CppEphem::eop(const std::vector<double>& mjd)
+{
+    return corrections.eop(mjd);
+}
+
+
+/**********************************************************************//**
+ * DUT1 correction for an array of modified julian dates (seconds)
+ * 
+ * @param[in]  mjd      Modified Julian Dates (MJD)
+ * @param[out] values   DUT1 correction for each MJD (seconds)
+ * @param[in]  n        Number of dates
+ * @param[out] status   Where each value came from (optional)
+ *************************************************************************/
+void CppEphem::dut1(const double* mjd, double* values, const std::size_t& n,
+                    CELookupStatus* status)
+{
+    corrections.dut1(mjd, values, n, status);
+}
+
+
+/**********************************************************************//**
+ * x-polar motion for an array of modified julian dates (radians)
+ * 
+ * @param[in]  mjd      Modified Julian Dates (MJD)
+ * @param[out] values   x-polar motion for each MJD (radians)
+ * @param[in]  n        Number of dates
+ * @param[out] status   Where each value came from (optional)
+ *************************************************************************/
+void CppEphem::xp(const double* mjd, double* values, const std::size_t& n,
+                  CELookupStatus* status)
+{
+    corrections.xpolar(mjd, values, n, status);
+}
+
+
+/**********************************************************************//**
+ * y-polar motion for an array of modified julian dates (radians)
+ * 
+ * @param[in]  mjd      Modified Julian Dates (MJD)
+ * @param[out] values   y-polar motion for each MJD (radians)
+ * @param[in]  n        Number of dates
+ * @param[out] status   Where each value came from (optional)
+ *************************************************************************/
+void CppEphem::yp(const double* mjd, double* values, const std::size_t& n,
+                  CELookupStatus* status)
+{
+    corrections.ypolar(mjd, values, n, status);
+}
+
+
+/**********************************************************************//**
+ * Earth obliquity correction for an array of modified julian dates (radians)
+ * 
+ * @param[in]  mjd      Modified Julian Dates (MJD)
+ * @param[out] values   Earth obliquity correction for each MJD (radians)
+ * @param[in]  n        Number of dates
+ * @param[out] status   Where each value came from (optional)
+ *************************************************************************/
+void CppEphem::deps(const double* mjd, double* values, const std::size_t& n,
+                    CELookupStatus* status)
+{
+    corrections.deps(mjd, values, n, status);
+}
+
+
+/**********************************************************************//**
+ * Earth longitude correction for an array of modified julian dates (radians)
+ * 
+ * @param[in]  mjd      Modified Julian Dates (MJD)
+ * @param[out] values   Earth longitude correction for each MJD (radians)
+ * @param[in]  n        Number of dates
+ * @param[out] status   Where each value came from (optional)
+ *************************************************************************/
+void CppEphem::dpsi(const double* mjd, double* values, const std::size_t& n,
+                    CELookupStatus* status)
+{
+    corrections.dpsi(mjd, values, n, status);
+}
+
+
+/**********************************************************************//**
+ * TT-UT1 correction for an array of modified julian dates (seconds)
+ * 
+ * @param[in]  mjd      Modified Julian Dates (MJD)
+ * @param[out] values   TT-UT1 correction for each MJD (seconds)
+ * @param[in]  n        Number of dates
+ * @param[out] status   Where each value came from (optional)
+ *************************************************************************/
+void CppEphem::ttut1(const double* mjd, double* values, const std::size_t& n,
+                     CELookupStatus* status)
+{
+    corrections.ttut1(mjd, values, n, status);
+}
+
+
+/**********************************************************************//**
+ * Earth orientation parameters for an array of modified julian dates
+ * 
+ * @param[in]  mjd      Modified Julian Dates (MJD)
+ * @param[out] values   DUT1, polar motion, nutation and TT-UT1 corrections
+ *                      for each MJD
+ * @param[in]  n        Number of dates
+ *************************************************************************/
+void CppEphem::eop(const double* mjd, CEEop* values, const std::size_t& n)
+{
+    corrections.eop(mjd, values, n);
+}
+
+
 /**********************************************************************//**
  * Method for splitting a string based on some delimiter into a vector of strings
  * 
@@ -0,0 +1,420 @@
+/***************************************************************************
+ *  CENanoTime.cpp: CppEphem                                               *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+/** \class CENanoTime
+ CENanoTime is a time stored as a whole number of TT nanoseconds since
+ J2000.0 (JD 2451545.0 TT) in a 64 bit integer.
+
+ A Julian date held in a single double only resolves about 40 microseconds
+ today, which is too coarse for nanosecond event timestamps. Here the time
+ is exact to the nanosecond and adding, differencing and comparing times
+ are single integer operations, so large arrays of them can be sorted and
+ binned as fast as plain integers (a CENanoTime is the size of an int64).
+ TT and TAI differ by exactly 32.184 s so both are exact. UTC is converted
+ with the leap second table of CELeapSeconds, including the leap seconds
+ themselves (23:59:60), and SOFA for the drifting UTC before 1972.
+
+ The two-part Julian dates handed to SOFA hold the whole days in the first
+ part and the fraction of the day in the second, which keeps the full
+ nanosecond resolution. Times between the years 1708 and 2292 (the range
+ of 64 bit nanoseconds from J2000) can be represented. UTC is converted
+ relative to the day of J2000, so this holds for UTC too; only POSIX time
+ (nanoseconds since 1970) is limited to 1678-2262, and UTC() throws for
+ times after 2262 that it cannot represent. FromUTC() throws for times
+ outside the range of CENanoTime.
+ */
+
+#include <cmath>
+#include <limits>
+
+#include "CENanoTime.h"
+#include "CEException.h"
+#include "CELeapSeconds.h"
+#include "CETime.h"
+#include "sofa.h"
+#include <sofam.h>
+
+namespace {
+
+    // TT-TAI (nanoseconds)
+    const std::int64_t tt_tai_ns = 32184000000LL;
+
+    // Modified Julian date of the Unix epoch (1970 January 1)
+    const std::int64_t unix_mjd = 40587;
+
+    // Modified Julian date of the day of J2000.0 (2000 January 1, 12h)
+    const std::int64_t j2000_mjd = 51544;
+
+    // Largest number of whole days whose nanoseconds fit in 64 bits
+    const std::int64_t max_days = std::numeric_limits<std::int64_t>::max() / 
+                                  CENanoTime::day_ns;
+
+    /**********************************************************************//**
+     * Return the sum of two nanosecond counts, throwing if it overflows
+     *************************************************************************/
+    std::int64_t AddNs(const std::int64_t& a,
+                       const std::int64_t& b,
+                       const std::string&  origin)
+    {
+        if (((b > 0) && (a > std::numeric_limits<std::int64_t>::max() - b)) ||
+            ((b < 0) && (a < std::numeric_limits<std::int64_t>::min() - b))) {
+            throw CEException::invalid_value(origin, 
+                        "Time is outside the range of 64 bit nanoseconds");
+        }
+        return a + b;
+    }
+
+    /**********************************************************************//**
+     * Return the nanoseconds of a number of days from a reference day plus
+     * a time of day, throwing if they don't fit in 64 bits
+     *************************************************************************/
+    std::int64_t DaysToNs(const std::int64_t& days,
+                          const std::int64_t& ns,
+                          const std::string&  origin)
+    {
+        if ((days < -max_days) || (days > max_days)) {
+            throw CEException::invalid_value(origin, 
+                        "Time is outside the range of 64 bit nanoseconds");
+        }
+        return AddNs(days * CENanoTime::day_ns, ns, origin);
+    }
+}
+
+constexpr std::int64_t CENanoTime::sec_ns;
+constexpr std::int64_t CENanoTime::day_ns;
+
+
+/**********************************************************************//**
+ * Return a time given as a two-part TT Julian date
+ *
+ * @param[in] tt1           First part of the TT Julian date
+ * @param[in] tt2           Second part of the TT Julian date
+ * @return Time (rounded to the nearest nanosecond)
+ *************************************************************************/
+CENanoTime CENanoTime::FromTT(const double& tt1,
+                              const double& tt2)
+{
+    // Days since J2000 (from the larger part), then the whole days of
+    // both parts and the sum of their fractions
+    double       d1 = (std::fabs(tt1) >= std::fabs(tt2)) ? tt1 - DJ00 : tt2 - DJ00;
+    double       d2 = (std::fabs(tt1) >= std::fabs(tt2)) ? tt2 : tt1;
+    double       i1 = std::floor(d1);
+    double       i2 = std::floor(d2);
+    std::int64_t ns = (std::int64_t(i1) + std::int64_t(i2)) * day_ns;
+    return CENanoTime(ns + std::llround(((d1 - i1) + (d2 - i2)) * day_ns));
+}
+
+
+/**********************************************************************//**
+ * Return a time given in TAI nanoseconds since J2000.0
+ *
+ * @param[in] ns            TAI nanoseconds since 2000 January 1, 12h TAI
+ * @return Time
+ * 
+ * @exception CEException::invalid_value
+ *            The time is outside the range of CENanoTime
+ *************************************************************************/
+CENanoTime CENanoTime::FromTAI(const std::int64_t& ns)
+{
+    return CENanoTime(AddNs(ns, tt_tai_ns, "CENanoTime::FromTAI"));
+}
+
+
+/**********************************************************************//**
+ * Return a time given as UTC nanoseconds since the Unix epoch
+ *
+ * @param[in] unix_ns       Nanoseconds since 1970 January 1, 0h UTC, not
+ *                          counting leap seconds (POSIX time)
+ * @return Time
+ * 
+ * @exception CEException::invalid_value
+ *            The time is before 1708 (outside the range of CENanoTime)
+ *************************************************************************/
+CENanoTime CENanoTime::FromUTC(const std::int64_t& unix_ns)
+{
+    std::int64_t day;
+    std::int64_t ns_of_day;
+    SplitDays(unix_ns, &day, &ns_of_day);
+    return FromUTC(day + unix_mjd, ns_of_day);
+}
+
+
+/**********************************************************************//**
+ * Return a time given as a UTC day and time of day
+ *
+ * @param[in] mjd           Modified Julian date of the UTC day
+ * @param[in] ns_of_day     Nanoseconds since the start of the day (which
+ *                          may reach 86401e9 on a day with a leap second)
+ * @return Time
+ * 
+ * @exception CEException::invalid_value
+ *            The time is outside the range of CENanoTime
+ *************************************************************************/
+CENanoTime CENanoTime::FromUTC(const std::int64_t& mjd,
+                               const std::int64_t& ns_of_day)
+{
+    const std::string origin = "CENanoTime::FromUTC";
+
+    // Days from the day of J2000 (checking the day first, so the
+    // difference cannot overflow)
+    if ((mjd < j2000_mjd - max_days - 1) || (mjd > j2000_mjd + max_days + 1)) {
+        throw CEException::invalid_value(origin, 
+                    "Time is outside the range of 64 bit nanoseconds");
+    }
+    std::int64_t days = mjd - j2000_mjd;
+
+    // Nanoseconds from 12h of the day of J2000, moving a day from the
+    // whole days to the time of day so that the whole days stay in range
+    std::int64_t shift = (days > 0) ? -1 : 1;
+    std::int64_t tai   = DaysToNs(days + shift, 
+                                  AddNs(ns_of_day, -shift*day_ns - day_ns/2, origin),
+                                  origin);
+    tai = AddNs(tai, TaiUtc(mjd, ns_of_day), origin);
+    return CENanoTime(AddNs(tai, tt_tai_ns, origin));
+}
+
+
+/**********************************************************************//**
+ * Return the current time
+ *
+ * @return Current time (from the system clock)
+ *************************************************************************/
+CENanoTime CENanoTime::Now(void)
+{
+    std::int64_t day;
+    std::int64_t ns_of_day;
+    CETime::CurrentUnixDay(&day, &ns_of_day);
+    return FromUTC(day + unix_mjd, ns_of_day);
+}
+
+
+/**********************************************************************//**
+ * Return TAI nanoseconds since J2000.0
+ *
+ * @return TAI nanoseconds since 2000 January 1, 12h TAI
+ * 
+ * @exception CEException::invalid_value
+ *            TAI is outside the range of 64 bit nanoseconds
+ *************************************************************************/
+std::int64_t CENanoTime::TAI(void) const
+{
+    return AddNs(tt_ns_, -tt_tai_ns, "CENanoTime::TAI");
+}
+
+
+/**********************************************************************//**
+ * Return UTC nanoseconds since the Unix epoch
+ *
+ * @return Nanoseconds since 1970 January 1, 0h UTC, not counting leap
+ *         seconds (POSIX time)
+ * 
+ * @exception CEException::invalid_value
+ *            The time is after 2262 (outside the range of POSIX nanoseconds)
+ * 
+ * POSIX time has no leap seconds, so a time during a leap second is given
+ * as the same value as the time one second later.
+ *************************************************************************/
+std::int64_t CENanoTime::UTC(void) const
+{
+    std::int64_t mjd;
+    std::int64_t ns_of_day;
+    UTC(&mjd, &ns_of_day);
+    return DaysToNs(mjd - unix_mjd, ns_of_day, "CENanoTime::UTC");
+}
+
+
+/**********************************************************************//**
+ * Return the UTC day and time of day
+ *
+ * @param[out] mjd          Modified Julian date of the UTC day
+ * @param[out] ns_of_day    Nanoseconds since the start of the day (at least
+ *                          86400e9 during a leap second)
+ *************************************************************************/
+void CENanoTime::UTC(std::int64_t* mjd,
+                     std::int64_t* ns_of_day) const
+{
+    // TAI as a day (MJD) and nanoseconds into it, kept apart so that
+    // nothing overflows near the ends of the range
+    std::int64_t tai_day;
+    std::int64_t tai_sod;
+    std::int64_t carry;
+    SplitDays(tt_ns_, &tai_day, &tai_sod);
+    SplitDays(tai_sod + day_ns / 2 - tt_tai_ns, &carry, &tai_sod);
+    tai_day += j2000_mjd + carry;
+
+    // Time of day on a given UTC day (TAI-UTC drifted during the day
+    // before 1972, so this is iterated for those dates)
+    auto time_of_day = [tai_day, tai_sod](const std::int64_t& day, std::int64_t sod) {
+        for (int i=0; i<2; i++) {
+            std::int64_t clamped = (sod < 0) ? 0 : ((sod > day_ns) ? day_ns : sod);
+            sod = (tai_day - day) * day_ns + tai_sod - TaiUtc(day, clamped);
+        }
+        return sod;
+    };
+
+    // Estimate the day from TAI-UTC at the start of the TAI day
+    std::int64_t day;
+    std::int64_t sod;
+    SplitDays(tai_sod - TaiUtc(tai_day, 0), &carry, &sod);
+    day = tai_day + carry;
+    sod = time_of_day(day, sod);
+
+    // The estimate can be a day out close to midnight
+    if (sod < 0) {
+        day -= 1;
+        sod  = time_of_day(day, sod + day_ns);
+    } else if (sod >= day_ns) {
+        // Unless this is a leap second, it is the next day
+        std::int64_t next = time_of_day(day + 1, sod - day_ns);
+        if (next >= 0) {
+            day += 1;
+            sod  = next;
+        }
+    }
+
+    *mjd       = day;
+    *ns_of_day = sod;
+}
+
+
+/**********************************************************************//**
+ * Return the time as a two-part TT Julian date
+ *
+ * @param[out] tt1          First part of the TT Julian date (whole days)
+ * @param[out] tt2          Second part of the TT Julian date (fraction of a day)
+ *************************************************************************/
+void CENanoTime::TT(double* tt1, double* tt2) const
+{
+    std::int64_t days;
+    std::int64_t rem;
+    SplitDays(tt_ns_, &days, &rem);
+    *tt1 = DJ00 + days;
+    *tt2 = double(rem) / double(day_ns);
+}
+
+
+/**********************************************************************//**
+ * Return the time as a two-part TAI Julian date
+ *
+ * @param[out] tai1         First part of the TAI Julian date (whole days)
+ * @param[out] tai2         Second part of the TAI Julian date (fraction of a day)
+ *************************************************************************/
+void CENanoTime::TAI(double* tai1, double* tai2) const
+{
+    std::int64_t days;
+    std::int64_t rem;
+    SplitDays(TAI(), &days, &rem);
+    *tai1 = DJ00 + days;
+    *tai2 = double(rem) / double(day_ns);
+}
+
+
+/**********************************************************************//**
+ * Return the time as a two-part UTC (quasi) Julian date
+ *
+ * @param[out] utc1         First part of the UTC Julian date (0h of the day)
+ * @param[out] utc2         Second part of the UTC Julian date (fraction of a day)
+ *
+ * As in SOFA, on a day with a leap second the fraction of the day is the
+ * fraction of its 86401 seconds, so the date can be passed to iauUtctai
+ * and the like.
+ *************************************************************************/
+void CENanoTime::UTC(double* utc1, double* utc2) const
+{
+    std::int64_t mjd;
+    std::int64_t ns_of_day;
+    UTC(&mjd, &ns_of_day);
+
+    // Length of the day (as iauUtctai, allowing for the drift before 1972)
+    std::int64_t dat0   = TaiUtc(mjd, 0);
+    std::int64_t dat12  = TaiUtc(mjd, day_ns / 2);
+    std::int64_t dat24  = TaiUtc(mjd + 1, 0);
+    std::int64_t dleap  = dat24 - (dat0 + 2 * (dat12 - dat0));
+
+    *utc1 = DJM0 + mjd;
+    *utc2 = double(ns_of_day) / double(day_ns + dleap);
+}
+
+
+/**********************************************************************//**
+ * Fill arrays with the two-part TT Julian dates of an array of times
+ *
+ * @param[in]  times        Times
+ * @param[out] tt1          First parts of the TT Julian dates
+ * @param[out] tt2          Second parts of the TT Julian dates
+ * @param[in]  n            Number of times
+ *************************************************************************/
+void CENanoTime::TT(const CENanoTime*  times,
+                    double*            tt1,
+                    double*            tt2,
+                    const std::size_t& n)
+{
+    for (std::size_t i=0; i<n; i++) {
+        times[i].TT(&tt1[i], &tt2[i]);
+    }
+}
+
+
+/**********************************************************************//**
+ * Split nanoseconds into whole days and the remainder
+ *
+ * @param[in]  ns           Nanoseconds
+ * @param[out] days         Whole days (rounded towards negative infinity)
+ * @param[out] rem          Remaining nanoseconds (0 to day_ns-1)
+ *************************************************************************/
+void CENanoTime::SplitDays(const std::int64_t& ns,
+                           std::int64_t*       days,
+                           std::int64_t*       rem)
+{
+    *days = ns / day_ns;
+    *rem  = ns - (*days) * day_ns;
+    if (*rem < 0) {
+        *days -= 1;
+        *rem  += day_ns;
+    }
+}
+
+
+/**********************************************************************//**
+ * Return TAI-UTC at a UTC time
+ *
+ * @param[in] mjd           Modified Julian date of the UTC day
+ * @param[in] ns_of_day     Nanoseconds since the start of the day
+ * @return TAI-UTC (nanoseconds)
+ *
+ * Since 1972 this is a whole number of seconds for the whole day, taken
+ * from the table of CELeapSeconds. Before that it drifted and is computed
+ * by iauDat.
+ *************************************************************************/
+std::int64_t CENanoTime::TaiUtc(const std::int64_t& mjd,
+                                const std::int64_t& ns_of_day)
+{
+    double dat;
+    if (mjd >= CELeapSeconds::FirstMJD()) {
+        dat = CELeapSeconds::TaiUtc(mjd);
+    } else {
+        int    iy, im, id;
+        double fd;
+        iauJd2cal(DJM0, double(mjd), &iy, &im, &id, &fd);
+        iauDat(iy, im, id, double(ns_of_day) / double(day_ns), &dat);
+    }
+    return std::llround(dat * sec_ns);
+}
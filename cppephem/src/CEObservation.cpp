@@ -156,6 +156,28 @@ void CEObservation::GetApparentXYCoordinate_Deg(double *apparent_X, double *appa
 }
 
 
+/**********************************************************************//**
+ * Get the observed coordinates of 'body_' as observed by 'observer_' on
+ * each date of a range (the date of this object is not used)
+ * 
+ * @param[in] dates         Dates of the observations
+ * @return Observed coordinates for each date
+ *************************************************************************/
+std::vector<CESkyCoord> CEObservation::GetObservedCoords(const CEDateRange& dates) const
+{
+    std::vector<CESkyCoord> coords;
+    if ((body_ == nullptr) || (observer_ == nullptr)) {
+        return coords;
+    }
+
+    coords.reserve(dates.size());
+    for (std::size_t i=0; i<dates.size(); i++) {
+        coords.push_back(body_->ObservedCoords(dates.TimeScales(i), *observer_));
+    }
+    return coords;
+}
+
+
 /**********************************************************************//**
  * Update the stored coordinates. Since all values need to be
  * computed at the same time, it only makes sense to update
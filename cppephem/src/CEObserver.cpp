@@ -31,13 +31,37 @@
  
  The above are used in the SOFA software to more accurately calculate
  the affect of refraction through the atmosphere.
+
+ The observer's position and velocity (as iauPvtob plus iauEpv00) are
+ cached for the last date. For streams of closely spaced dates (events,
+ or a CERunningDate loop) SetIncrementalUpdate() avoids most of the work:
+ within a set time (and UTC day) of the last full evaluation the Earth
+ rotation angle is advanced analytically from it using only the UTC
+ parts of the date, so its time scales are never computed, and the
+ slowly varying terms (polar motion, TIO locator, Earth's barycentric
+ position and velocity) are reused, with the position moved along the
+ Earth's velocity. The budget bounds the position error; the held
+ velocity is off by up to the Earth's acceleration times the step
+ (about 0.1 m/s at the 18 second step of a 1 m budget).
  */
 
 // C++ HEADERS
+#include <cmath>
 #include <stdio.h>
 
 // CPPEPHEM HEADERS
 #include "CEObserver.h"
+#include "CEException.h"
+
+namespace {
+
+    // Largest barycentric acceleration of the Earth (m/s^2), the Sun at
+    // perihelion (6.13e-3) plus the Moon at perigee (3.7e-5) and planets
+    const double earth_accel_max = 6.2e-3;
+
+    // Earth rotation rate (radians per UT1 day)
+    const double earth_rate = 1.00273781191135448 * D2PI;
+}
 
 
 /**********************************************************************//**
@@ -128,10 +152,10 @@ std::vector<double> CEObserver::PositionGeo(void) const
 
 /**********************************************************************//**
  * Get the position vector for this observer relative to CIRS (Earth center)
- * @param[in] date          Date object for computing position
+ * @param[in] date          Date (and its time scales) for computing position
  * @return Position vector relative to earth center position (AU)
  *************************************************************************/
-std::vector<double> CEObserver::PositionCIRS(const CEDate& date) const
+std::vector<double> CEObserver::PositionCIRS(const CETimeScales& date) const
 {
     UpdatePosVel(date);
     return pos_cirs_;
@@ -140,10 +164,10 @@ std::vector<double> CEObserver::PositionCIRS(const CEDate& date) const
 
 /**********************************************************************//**
  * Get the position vector for this observer relative to ICRS (solar system barycenter)
- * @param[in] date          Date object for computing position
+ * @param[in] date          Date (and its time scales) for computing position
  * @return Position vector relative to solar system barycenter position (AU)
  *************************************************************************/
-std::vector<double> CEObserver::PositionICRS(const CEDate& date) const
+std::vector<double> CEObserver::PositionICRS(const CETimeScales& date) const
 {
     UpdatePosVel(date);
     return pos_icrs_;
@@ -152,10 +176,10 @@ std::vector<double> CEObserver::PositionICRS(const CEDate& date) const
 
 /**********************************************************************//**
  * Get the velocity vector for this observer relative to CIRS (solar system barycenter)
- * @param[in] date          Date object for computing position
+ * @param[in] date          Date (and its time scales) for computing position
  * @return Velocity vector relative to Earth center position (AU)
  *************************************************************************/
-std::vector<double> CEObserver::VelocityCIRS(const CEDate& date) const
+std::vector<double> CEObserver::VelocityCIRS(const CETimeScales& date) const
 {
     UpdatePosVel(date);
     return vel_cirs_;
@@ -164,16 +188,55 @@ std::vector<double> CEObserver::VelocityCIRS(const CEDate& date) const
 
 /**********************************************************************//**
  * Get the velocity vector for this observer relative to ICRS (solar system barycenter)
- * @param[in] date          Date object for computing position
+ * @param[in] date          Date (and its time scales) for computing position
  * @return Velocity vector relative to solar system barycenter position (AU)
  *************************************************************************/
-std::vector<double> CEObserver::VelocityICRS(const CEDate& date) const
+std::vector<double> CEObserver::VelocityICRS(const CETimeScales& date) const
 {
     UpdatePosVel(date);
     return vel_icrs_;
 }
 
 
+/**********************************************************************//**
+ * Turn on (or off) incremental updates of the position and velocity
+ * 
+ * @param[in] max_error_m   Error budget (meters), zero turns them off
+ * 
+ * When on, the position and velocity are only fully evaluated when the
+ * date is more than IncrementalStep_s() from the last full evaluation.
+ * In between, the Earth rotation angle is advanced linearly with UT1
+ * (which is exact), while polar motion, the TIO locator and the Earth's
+ * barycentric velocity are held. The barycentric position moves along
+ * that velocity, so its error is at most half the Earth's acceleration
+ * (6.2e-3 m/s^2) times the square of the step, which sets the step from
+ * the budget (18 seconds for 1 m). The velocity error is the acceleration
+ * times the step (0.1 m/s for 1 m). The held polar motion adds well under
+ * a millimeter for budgets of up to a kilometer.
+ *************************************************************************/
+void CEObserver::SetIncrementalUpdate(const double& max_error_m)
+{
+    if (max_error_m < 0.0) {
+        throw CEException::invalid_value("CEObserver::SetIncrementalUpdate",
+                                         "Error budget must not be negative");
+    }
+    max_error_m_ = max_error_m;
+    ClearCache();
+}
+
+
+/**********************************************************************//**
+ * Return the largest step from a full evaluation of the position and
+ * velocity that stays within the error budget
+ * 
+ * @return Step (seconds), zero when incremental updates are off
+ *************************************************************************/
+double CEObserver::IncrementalStep_s(void) const
+{
+    return std::sqrt(2.0 * max_error_m_ / earth_accel_max);
+}
+
+
 /**********************************************************************//**
  * Returns a string containing information about this object
  * @return Formatted string containing information about this observer
@@ -219,11 +282,13 @@ void CEObserver::copy_members(const CEObserver& other)
     utc_offset_          = other.utc_offset_;
 
     // Copy cached parameters
-    cache_date_ = other.cache_date_;
-    pos_cirs_   = other.pos_cirs_;
-    pos_icrs_   = other.pos_icrs_;
-    vel_cirs_   = other.vel_cirs_;
-    vel_icrs_   = other.vel_icrs_;
+    cache_date_  = other.cache_date_;
+    pos_cirs_    = other.pos_cirs_;
+    pos_icrs_    = other.pos_icrs_;
+    vel_cirs_    = other.vel_cirs_;
+    vel_icrs_    = other.vel_icrs_;
+    max_error_m_ = other.max_error_m_;
+    ref_         = other.ref_;
 }
 
 
@@ -242,11 +307,14 @@ void CEObserver::init_members(void)
     utc_offset_          = CETime::SystemUTCOffset_hrs();
 
     // cached pos/vel parameters
-    cache_date_ = -1.0e30;
-    pos_cirs_   = std::vector<double>(3, 0.0);
-    pos_icrs_   = std::vector<double>(3, 0.0);
-    vel_cirs_   = std::vector<double>(3, 0.0);
-    vel_icrs_   = std::vector<double>(3, 0.0);
+    cache_date_  = -1.0e30;
+    pos_cirs_    = std::vector<double>(3, 0.0);
+    pos_icrs_    = std::vector<double>(3, 0.0);
+    vel_cirs_    = std::vector<double>(3, 0.0);
+    vel_icrs_    = std::vector<double>(3, 0.0);
+    max_error_m_ = 0.0;
+    ref_         = PosVelReference();
+    ref_.valid   = false;
 }
 
 
@@ -255,55 +323,74 @@ void CEObserver::init_members(void)
  * 
  * @param[in] date          Date for computation
  *************************************************************************/
-void CEObserver::UpdatePosVel(const CEDate& date) const
+void CEObserver::UpdatePosVel(const CETimeScales& date) const
 {
-    // Check if the cached date has changed
-    if (date.MJD() != cache_date_) {
-
-        // Convert UTC to UT1 and TDB
-        double ut11(0.0);
-        double ut12(0.0);
-        double tdb1(0.0);
-        double tdb2(0.0);
-        double tt1(0.0);
-        double tt2(0.0);
-        CEDate::UTC2UT1(date.MJD(), &ut11, &ut12);
-        CEDate::UTC2TDB(date.MJD(), &tdb1, &tdb2);
-        CEDate::UTC2TT(date.MJD(), &tt1, &tt2);
-
-        // Compute the Earth rotation angle at UT1
-        double theta = iauEra00(ut11, ut12);
-        double sp    = iauSp00(tt1, tt2);
-
-        // Vectors for intermediate position/velocities
-        double pvc[2][3];   // CIRS pos,vel
-
-        // Get the position and velocity values in CIRS
-        iauPvtob(longitude_, 
-                 latitude_, 
-                 elevation_m_, 
-                 date.xpolar(),
-                 date.ypolar(),
-                 sp,
-                 theta,
-                 pvc);
-
-        // Earth centric distance/velocity in ICRS (AU and AU/day)
-        double ebpv[2][3];
+    // Nothing to do if the cached values are for this date
+    if (date.MJD() == cache_date_) {
+        return;
+    }
+
+    // Time since the last full evaluation (UTC days). This only uses the
+    // UTC parts, so the incremental path never computes the time scales
+    // of the date (EOP, leap seconds, TDB-TT). Within a UTC day UT1-UTC
+    // drifts by under a microsecond over a step (under a millimeter of
+    // Earth rotation) and TDB-UTC by a few nanoseconds, so the same
+    // interval is used for UT1 and TDB.
+    double dt = (date.UTC1() - ref_.utc1) + (date.UTC2() - ref_.utc2);
+
+    double theta;
+    if (ref_.valid && (max_error_m_ > 0.0) && 
+        (std::floor(date.MJD()) == ref_.day) &&
+        (std::fabs(dt) * DAYSEC <= IncrementalStep_s())) {
+        // The Earth rotation angle is linear in UT1
+        theta = ref_.era + earth_rate * dt;
+    } else {
+        // Full evaluation (as iauPvtob): geodetic to geocentric (WGS84),
+        // then polar motion and the TIO locator (at TT)
+        const CEEop& eop = date.eop();
+        double xyzm[3];
+        double rpm[3][3];
+        iauGd2gc(1, longitude_, latitude_, elevation_m_, xyzm);
+        iauPom00(eop.xp, eop.yp, iauSp00(date.TT1(), date.TT2()), rpm);
+        iauTrxp(rpm, xyzm, ref_.xyz);
+
+        // Earth barycentric position and velocity (AU and AU/day)
         double ehpv[2][3];
-        iauEpv00(tdb1, tdb2, ehpv, ebpv);
-
-        // Get the CIRS and ICRS pos,vel
-        double mps_apd = CppEphem::sec_per_day() / CppEphem::m_per_au();
-        for (int i=0; i<3; i++) {
-            // CIRS
-            pos_cirs_[i] = pvc[0][i] / CppEphem::m_per_au();
-            vel_cirs_[i] = pvc[1][i] * mps_apd;
-
-            // ICRS (Earth barycenter + CIRS offset)
-            pos_icrs_[i] = ebpv[0][i] + pos_cirs_[i];
-            vel_icrs_[i] = ebpv[1][i] + vel_cirs_[i];
-        }
+        iauEpv00(date.TDB1(), date.TDB2(), ehpv, ref_.ebpv);
+
+        ref_.utc1  = date.UTC1();
+        ref_.utc2  = date.UTC2();
+        ref_.day   = std::floor(date.MJD());
+        ref_.era   = date.ERA();
+        ref_.valid = true;
+        theta      = ref_.era;
+        dt         = 0.0;
     }
-    return;
+
+    // Rotate by the Earth rotation angle to get the CIRS position and
+    // velocity (m and m/s, as iauPvtob)
+    const double om = earth_rate / DAYSEC;
+    double s = std::sin(theta);
+    double c = std::cos(theta);
+    double x = ref_.xyz[0];
+    double y = ref_.xyz[1];
+    double z = ref_.xyz[2];
+    double pvc[2][3] = {{c*x - s*y, s*x + c*y, z},
+                        {om * (-s*x - c*y), om * (c*x - s*y), 0.0}};
+
+    // Get the CIRS and ICRS pos,vel
+    double mps_apd = CppEphem::sec_per_day() / CppEphem::m_per_au();
+    for (int i=0; i<3; i++) {
+        // CIRS
+        pos_cirs_[i] = pvc[0][i] / CppEphem::m_per_au();
+        vel_cirs_[i] = pvc[1][i] * mps_apd;
+
+        // ICRS (Earth barycenter, moved along its velocity, + CIRS offset).
+        // The held velocity is off by the acceleration times the step
+        // (0.1 m/s at the 18 second step of a 1 m budget)
+        pos_icrs_[i] = ref_.ebpv[0][i] + ref_.ebpv[1][i] * dt + pos_cirs_[i];
+        vel_icrs_[i] = ref_.ebpv[1][i] + vel_cirs_[i];
+    }
+
+    cache_date_ = date.MJD();
 }
@@ -589,13 +589,13 @@ void CEPlanet::SetAscendingNodeLongitude(double ascending_node_lon,
  * @param[in] date              Date of observation
  * @return Distance in AU to the Earth's center
  *************************************************************************/
-double CEPlanet::EarthDist_AU(const CEDate& date)
+double CEPlanet::EarthDist_AU(const CETimeScales& date)
 {
     // Compute the position of the earth relative to the planet to account
     // for the time delay of the planet
     CEPlanet earth = CEPlanet::Earth();
     earth.SetAlgorithm(Algorithm());
-    earth.UpdatePosition(date.JD());
+    earth.UpdatePosition(date);
 
     std::vector<double> pos = pos_icrs_;
     double x = pos[0] - earth.GetXICRS();
@@ -614,7 +614,7 @@ double CEPlanet::EarthDist_AU(const CEDate& date)
  * @param[in] observer          Observer
  * @return Observed coordinates
  *************************************************************************/
-std::vector<double> CEPlanet::PositionICRS_Obs(const CEDate& date) const
+std::vector<double> CEPlanet::PositionICRS_Obs(const CETimeScales& date) const
 {
     // Make a copy of the planet so we dont need to reset values
     CEPlanet past(*this);
@@ -639,14 +639,30 @@ std::vector<double> CEPlanet::PositionICRS_Obs(const CEDate& date) const
  *************************************************************************/
 CESkyCoord CEPlanet::ObservedCoords(const CEDate&     date,
                                     const CEObserver& observer) const
+{
+    // Compute the time scales once for all of the steps below
+    return ObservedCoords(CETimeScales(date), observer);
+}
+
+
+/**********************************************************************//**
+ * Get the observed coordinates for a given observer on a date whose time
+ * scales are already known (i.e. one date of a CEDateRange)
+ * 
+ * @param[in] times             Date of observation
+ * @param[in] observer          Observer
+ * @return Observed coordinates
+ *************************************************************************/
+CESkyCoord CEPlanet::ObservedCoords(const CETimeScales& times,
+                                    const CEObserver&   observer) const
 {
     // Update planet position
-    UpdatePosition(date);
+    UpdatePosition(times);
 
     // Get the observer ICRS position on a given date and the time-delayed
     // position of the planet on that date
-    std::vector<double> offset  = observer.PositionICRS(date);
-    std::vector<double> pos_obs = PositionICRS_Obs(date);
+    std::vector<double> offset  = observer.PositionICRS(times);
+    std::vector<double> pos_obs = PositionICRS_Obs(times);
 
     // Compute the difference in coordinates
     for (int i=0; i<3; i++)
@@ -664,7 +680,7 @@ CESkyCoord CEPlanet::ObservedCoords(const CEDate&     date,
     }
     CESkyCoord coord(ra, dec, coordsys);
     
-    return coord.ConvertTo(CESkyCoordType::OBSERVED, date, observer);
+    return coord.ConvertTo(CESkyCoordType::OBSERVED, times, observer);
 }
 
 
@@ -681,10 +697,9 @@ void CEPlanet::UpdateCoordinates(double new_jd) const
     if ((new_jd < -1.0e29) || (new_jd == cached_jd_)) return;
 
     // Update the positions given the current julian date
-    UpdatePosition(new_jd);
-
-    CEDate date(new_jd, CEDateType::JD);
-    std::vector<double> pos_delayed = PositionICRS_Obs(date);
+    CETimeScales times(new_jd, CEDateType::JD);
+    UpdatePosition(times);
+    std::vector<double> pos_delayed = PositionICRS_Obs(times);
 
     // Now compute the actual sky coordinates in ICRS
     double x;
@@ -718,6 +733,24 @@ void CEPlanet::UpdatePosition(const double& jd) const
     }
 }
 
+
+/**********************************************************************//**
+ * Recomputes the spatial position for a planet based on chosen algorithm
+ * 
+ * @param[in] date          Date (and its time scales)
+ *************************************************************************/
+void CEPlanet::UpdatePosition(const CETimeScales& date) const
+{
+    // If the date hasnt changed, do nothing
+    if (date.JD() == cached_jd_) {
+        return ;
+    } else if (algorithm_type_ == CEPlanetAlgo::JPL) {
+        Update_JPL(date) ;
+    } else if (algorithm_type_ == CEPlanetAlgo::SOFA) {
+        Update_SOFA(date) ;
+    }
+}
+
 /**********************************************************************//**
  * Recomputes the coordinates of the planet based on the date
  * using the methods included in the sofa package (iauPlan94).
@@ -728,11 +761,20 @@ void CEPlanet::UpdatePosition(const double& jd) const
  *************************************************************************/
 void CEPlanet::Update_SOFA(double new_jd) const
 {
-    // Compute the TDB based on supplied jd
-    double tdb1(0.0);
-    double tdb2(0.0);
-    double mjd = new_jd - CEDate::GetMJD2JDFactor();
-    CEDate::UTC2TDB(mjd, &tdb1, &tdb2);
+    Update_SOFA(CETimeScales(new_jd, CEDateType::JD));
+}
+
+
+/**********************************************************************//**
+ * Recomputes the coordinates of the planet based on the date
+ * using the methods included in the sofa package (iauPlan94).
+ * 
+ * @param[in] date         Date (and its time scales)
+ *************************************************************************/
+void CEPlanet::Update_SOFA(const CETimeScales& date) const
+{
+    double tdb1 = date.TDB1();
+    double tdb2 = date.TDB2();
 
     // Compute the Earth relative corrections
     double pvb[2][3];
@@ -772,15 +814,23 @@ void CEPlanet::Update_SOFA(double new_jd) const
  * @param[in] new_jd       Julian date
  *************************************************************************/
 void CEPlanet::Update_JPL(double new_jd) const
+{
+    Update_JPL(CETimeScales(new_jd, CEDateType::JD));
+}
+
+
+/**********************************************************************//**
+ * Recomputes the coordinates of the planet based on the date
+ * using the keplerian method outlined by JPL
+ * 
+ * @param[in] date         Date (and its time scales)
+ *************************************************************************/
+void CEPlanet::Update_JPL(const CETimeScales& date) const
 {
     /* Date has changed, so we need to recompute the coordinates of this object */
 
     // Compute the number of centuries since J2000 epoch
-    double mjd = new_jd - CEDate::GetMJD2JDFactor();
-    double tdb1;
-    double tdb2;
-    CEDate::UTC2TDB(mjd, &tdb1, &tdb2);
-    double T = (tdb1+tdb2 - CppEphem::julian_date_J2000()) / DJC;
+    double T = (date.TDB1()+date.TDB2() - CppEphem::julian_date_J2000()) / DJC;
 
     // Compute the values
     double a = ComputeElement(semi_major_axis_au_, semi_major_axis_au_per_cent_, T) ;
@@ -31,6 +31,11 @@
   The speed of ellapsed time by be computed using the SetTimerSpeed method,
   thus allowing the user to speed up, slow down, or even reverse the passage
   of time for this object.
+
+  For real-time loops the date can be held at one instant with Freeze(), and
+  moved to the next instant once per frame with Tick(). Every query within a
+  frame then gets the same date and hits the caches that objects like
+  CEPlanet and CEObserver keep for the last date they were computed for.
  
  * The object may be evaluated in one of several ways to get the current value:
  * <ul>
@@ -100,6 +105,26 @@ double CERunningDate::JD() const
     return CEDate::JD() + (ScaledRunTime()/86400.0) ;
 }
 
+/**********************************************************************//**
+ * Get the first part of the current two-part Julian date.
+ * 
+ * @return First part of the instantaneous Julian date
+ *************************************************************************/
+double CERunningDate::JD1() const
+{
+    return CEDate::JD1() ;
+}
+
+/**********************************************************************//**
+ * Get the second part of the current two-part Julian date.
+ * 
+ * @return Second part of the instantaneous Julian date
+ *************************************************************************/
+double CERunningDate::JD2() const
+{
+    return CEDate::JD2() + (ScaledRunTime()/86400.0) ;
+}
+
 /**********************************************************************//**
  * Get the current modified Julian date.
  * 
@@ -123,8 +148,25 @@ double CERunningDate::Gregorian() const
 
 /**********************************************************************//**
  * Get the number of seconds since the creation of this object
+ * 
+ * If the date is frozen this is the time at the last Freeze() or Tick().
  *************************************************************************/
 double CERunningDate::RunTime() const
+{
+    return frozen_ ? frozen_runtime_ : LiveRunTime();
+}
+
+
+//-------------------------------------------------
+// PRIVATE METHODS
+//-------------------------------------------------
+
+
+/**********************************************************************//**
+ * Get the number of seconds since the creation of this object, as
+ * measured by the clock now
+ *************************************************************************/
+double CERunningDate::LiveRunTime() const
 {
     // Get the current system time in nanoseconds
     std::chrono::nanoseconds cur_time(std::chrono::high_resolution_clock::now().time_since_epoch());
@@ -135,11 +177,6 @@ double CERunningDate::RunTime() const
 }
 
 
-//-------------------------------------------------
-// PRIVATE METHODS
-//-------------------------------------------------
-
-
 /**********************************************************************//**
  * Copy data members from another object
  * 
@@ -149,6 +186,8 @@ void CERunningDate::copy_members(const CERunningDate& other)
 {
     start_              = other.start_;
     timer_speed_factor_ = other.timer_speed_factor_;
+    frozen_             = other.frozen_;
+    frozen_runtime_     = other.frozen_runtime_;
 }
 
 
@@ -159,6 +198,8 @@ void CERunningDate::init_members(void)
 {
     start_              = std::chrono::high_resolution_clock::now();
     timer_speed_factor_ = 1.0;
+    frozen_             = false;
+    frozen_runtime_     = 0.0;
 }
 
 
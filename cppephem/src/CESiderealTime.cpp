@@ -0,0 +1,315 @@
+/***************************************************************************
+ *  CESiderealTime.cpp: CppEphem                                           *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+/** \class CESiderealTime
+ CESiderealTime computes the Earth rotation angle and the Greenwich/local
+ sidereal times (IAU 2006/2000A) for single dates or whole arrays of them.
+
+ The Earth rotation angle and GMST are short expressions of UT1 and TT.
+ They are written out here (they are the same expressions as iauEra00 and
+ iauGmst06, so the results are identical) so that the array versions are
+ plain loops without any library calls.
+
+ The equation of the equinoxes needs the full nutation series, which takes
+ tens of microseconds per date. Like TDB-TT in CETdbTt it is fitted by
+ CEChebyshevCache, over 4 day segments, so it is only evaluated at the
+ Chebyshev nodes of a segment the first time a date in that segment is
+ needed, every other date is a short polynomial evaluation.
+ Note that this is the equation of the equinoxes of the IAU 2006/2000A
+ model, the observed nutation offsets (dpsi,deps) are not included.
+ */
+
+#include <cmath>
+
+#include "CESiderealTime.h"
+#include "CEChebyshevCache.h"
+#include "sofa.h"
+#include <sofam.h>
+
+namespace {
+
+    /**********************************************************************//**
+     * Normalize an angle into the range 0 to 2pi (same as iauAnp)
+     *************************************************************************/
+    inline double Anp(const double& a)
+    {
+        double w = std::fmod(a, D2PI);
+        return (w < 0.0) ? w + D2PI : w;
+    }
+
+    /**********************************************************************//**
+     * Earth rotation angle for a two part UT1 Julian date (same as iauEra00)
+     *************************************************************************/
+    inline double Era(const double& ut11,
+                      const double& ut12)
+    {
+        // Days since J2000, with the smaller part first
+        double d1 = (ut11 < ut12) ? ut11 : ut12;
+        double d2 = (ut11 < ut12) ? ut12 : ut11;
+        double t  = d1 + (d2 - DJ00);
+
+        // Fractional part of the day
+        double f = std::fmod(d1, 1.0) + std::fmod(d2, 1.0);
+
+        return Anp(D2PI * (f + 0.7790572732640 + 0.00273781191135448 * t));
+    }
+
+    /**********************************************************************//**
+     * Greenwich mean sidereal time less the Earth rotation angle for a two
+     * part TT Julian date (the polynomial of iauGmst06)
+     *************************************************************************/
+    inline double GmstEra(const double& tt1,
+                          const double& tt2)
+    {
+        // Julian centuries since J2000
+        double t = ((tt1 - DJ00) + tt2) / DJC;
+
+        return (    0.014506     +
+               (  4612.156534    +
+               (     1.3915817   +
+               (    -0.00000044  +
+               (    -0.000029956 +
+               (    -0.0000000368 )
+               * t) * t) * t) * t) * t) * DAS2R;
+    }
+}
+
+
+/**********************************************************************//**
+ * Return the Earth rotation angle
+ *
+ * @param[in] ut11          First part of the UT1 Julian date
+ * @param[in] ut12          Second part of the UT1 Julian date
+ * @return Earth rotation angle (radians, 0 to 2pi)
+ *************************************************************************/
+double CESiderealTime::ERA(const double& ut11,
+                           const double& ut12)
+{
+    return Era(ut11, ut12);
+}
+
+
+/**********************************************************************//**
+ * Fill an array with the Earth rotation angle for an array of dates
+ *
+ * @param[in]  ut11         First parts of the UT1 Julian dates
+ * @param[in]  ut12         Second parts of the UT1 Julian dates
+ * @param[out] era          Earth rotation angle for each date (radians)
+ * @param[in]  n            Number of dates
+ *************************************************************************/
+void CESiderealTime::ERA(const double*      ut11,
+                         const double*      ut12,
+                         double*            era,
+                         const std::size_t& n)
+{
+    for (std::size_t i=0; i<n; i++) {
+        era[i] = Era(ut11[i], ut12[i]);
+    }
+}
+
+
+/**********************************************************************//**
+ * Return the Greenwich mean sidereal time
+ *
+ * @param[in] ut11          First part of the UT1 Julian date
+ * @param[in] ut12          Second part of the UT1 Julian date
+ * @param[in] tt1           First part of the TT Julian date
+ * @param[in] tt2           Second part of the TT Julian date
+ * @return Greenwich mean sidereal time (radians, 0 to 2pi)
+ *************************************************************************/
+double CESiderealTime::GMST(const double& ut11,
+                            const double& ut12,
+                            const double& tt1,
+                            const double& tt2)
+{
+    return Anp(Era(ut11, ut12) + GmstEra(tt1, tt2));
+}
+
+
+/**********************************************************************//**
+ * Fill an array with the Greenwich mean sidereal time for an array of dates
+ *
+ * @param[in]  ut11         First parts of the UT1 Julian dates
+ * @param[in]  ut12         Second parts of the UT1 Julian dates
+ * @param[in]  tt1          First parts of the TT Julian dates
+ * @param[in]  tt2          Second parts of the TT Julian dates
+ * @param[out] gmst         Greenwich mean sidereal time for each date (radians)
+ * @param[in]  n            Number of dates
+ *************************************************************************/
+void CESiderealTime::GMST(const double*      ut11,
+                          const double*      ut12,
+                          const double*      tt1,
+                          const double*      tt2,
+                          double*            gmst,
+                          const std::size_t& n)
+{
+    for (std::size_t i=0; i<n; i++) {
+        gmst[i] = Anp(Era(ut11[i], ut12[i]) + GmstEra(tt1[i], tt2[i]));
+    }
+}
+
+
+/**********************************************************************//**
+ * Return the Greenwich apparent sidereal time
+ *
+ * @param[in] ut11          First part of the UT1 Julian date
+ * @param[in] ut12          Second part of the UT1 Julian date
+ * @param[in] tt1           First part of the TT Julian date
+ * @param[in] tt2           Second part of the TT Julian date
+ * @return Greenwich apparent sidereal time (radians, 0 to 2pi)
+ *************************************************************************/
+double CESiderealTime::GAST(const double& ut11,
+                            const double& ut12,
+                            const double& tt1,
+                            const double& tt2)
+{
+    return Anp(Era(ut11, ut12) + GmstEra(tt1, tt2) +
+               EquationOfEquinoxes(tt1, tt2));
+}
+
+
+/**********************************************************************//**
+ * Fill an array with the Greenwich apparent sidereal time for an array
+ * of dates
+ *
+ * @param[in]  ut11         First parts of the UT1 Julian dates
+ * @param[in]  ut12         Second parts of the UT1 Julian dates
+ * @param[in]  tt1          First parts of the TT Julian dates
+ * @param[in]  tt2          Second parts of the TT Julian dates
+ * @param[out] gast         Greenwich apparent sidereal time for each date (radians)
+ * @param[in]  n            Number of dates
+ *************************************************************************/
+void CESiderealTime::GAST(const double*      ut11,
+                          const double*      ut12,
+                          const double*      tt1,
+                          const double*      tt2,
+                          double*            gast,
+                          const std::size_t& n)
+{
+    for (std::size_t i=0; i<n; i++) {
+        gast[i] = Anp(Era(ut11[i], ut12[i]) + GmstEra(tt1[i], tt2[i]) +
+                      EquationOfEquinoxes(tt1[i], tt2[i]));
+    }
+}
+
+
+/**********************************************************************//**
+ * Return the local apparent sidereal time
+ *
+ * @param[in] ut11          First part of the UT1 Julian date
+ * @param[in] ut12          Second part of the UT1 Julian date
+ * @param[in] tt1           First part of the TT Julian date
+ * @param[in] tt2           Second part of the TT Julian date
+ * @param[in] longitude     Longitude (radians, east positive)
+ * @return Local apparent sidereal time (radians, 0 to 2pi)
+ *************************************************************************/
+double CESiderealTime::LAST(const double& ut11,
+                            const double& ut12,
+                            const double& tt1,
+                            const double& tt2,
+                            const double& longitude)
+{
+    return Anp(GAST(ut11, ut12, tt1, tt2) + longitude);
+}
+
+
+/**********************************************************************//**
+ * Fill an array with the local apparent sidereal time at one longitude
+ * for an array of dates
+ *
+ * @param[in]  ut11         First parts of the UT1 Julian dates
+ * @param[in]  ut12         Second parts of the UT1 Julian dates
+ * @param[in]  tt1          First parts of the TT Julian dates
+ * @param[in]  tt2          Second parts of the TT Julian dates
+ * @param[in]  longitude    Longitude (radians, east positive)
+ * @param[out] last         Local apparent sidereal time for each date (radians)
+ * @param[in]  n            Number of dates
+ *************************************************************************/
+void CESiderealTime::LAST(const double*      ut11,
+                          const double*      ut12,
+                          const double*      tt1,
+                          const double*      tt2,
+                          const double&      longitude,
+                          double*            last,
+                          const std::size_t& n)
+{
+    GAST(ut11, ut12, tt1, tt2, last, n);
+    for (std::size_t i=0; i<n; i++) {
+        last[i] = Anp(last[i] + longitude);
+    }
+}
+
+
+/**********************************************************************//**
+ * Fill an array with the local apparent sidereal time for arrays of dates
+ * and longitudes
+ *
+ * @param[in]  ut11         First parts of the UT1 Julian dates
+ * @param[in]  ut12         Second parts of the UT1 Julian dates
+ * @param[in]  tt1          First parts of the TT Julian dates
+ * @param[in]  tt2          Second parts of the TT Julian dates
+ * @param[in]  longitude    Longitude for each date (radians, east positive)
+ * @param[out] last         Local apparent sidereal time for each date (radians)
+ * @param[in]  n            Number of dates
+ *************************************************************************/
+void CESiderealTime::LAST(const double*      ut11,
+                          const double*      ut12,
+                          const double*      tt1,
+                          const double*      tt2,
+                          const double*      longitude,
+                          double*            last,
+                          const std::size_t& n)
+{
+    GAST(ut11, ut12, tt1, tt2, last, n);
+    for (std::size_t i=0; i<n; i++) {
+        last[i] = Anp(last[i] + longitude[i]);
+    }
+}
+
+
+/**********************************************************************//**
+ * Return the equation of the equinoxes (GAST - GMST)
+ *
+ * @param[in] tt1           First part of the TT Julian date
+ * @param[in] tt2           Second part of the TT Julian date
+ * @return Equation of the equinoxes (radians)
+ *************************************************************************/
+double CESiderealTime::EquationOfEquinoxes(const double& tt1,
+                                           const double& tt2)
+{
+    return CEChebyshevCache<&SeriesEquationOfEquinoxes, ncoeff_, segment_days_>::Value(tt1, tt2);
+}
+
+
+/**********************************************************************//**
+ * Return the equation of the equinoxes from the full nutation series
+ *
+ * @param[in] tt1           First part of the TT Julian date
+ * @param[in] tt2           Second part of the TT Julian date
+ * @return Equation of the equinoxes (radians)
+ *
+ * This calls iauEe06a directly, it is much slower than EquationOfEquinoxes().
+ *************************************************************************/
+double CESiderealTime::SeriesEquationOfEquinoxes(const double& tt1,
+                                                 const double& tt2)
+{
+    return iauEe06a(tt1, tt2);
+}
@@ -199,22 +199,17 @@ CEAngle CESkyCoord::AngularSeparation(const CEAngle& xcoord_first,
  * @param[out] out_icrs         Output ICRS coordinates
  * @param[in]  date             Date for conversion
  *************************************************************************/
-void CESkyCoord::CIRS2ICRS(const CESkyCoord& in_cirs, 
-                           CESkyCoord*       out_icrs,
-                           const CEDate&     date)
+void CESkyCoord::CIRS2ICRS(const CESkyCoord&   in_cirs,
+                           CESkyCoord*         out_icrs,
+                           const CETimeScales& date)
 {
     double eo; // Equation of the origins
 
-    // Compute the TDB date
-    double tdb1(0.0);
-    double tdb2(0.0);
-    CEDate::UTC2TDB(date.MJD(), &tdb1, &tdb2);
-
     // Use the SOFA library to compute the new date
     double return_ra(0.0);
     double return_dec(0.0);
     iauAtic13(in_cirs.XCoord(), in_cirs.YCoord(), 
-              tdb1, tdb2, 
+              date.TDB1(), date.TDB2(), 
               &return_ra, &return_dec, &eo);
 
     // Subtract the eo from RA if J2000 coordinates are desired
@@ -233,9 +228,9 @@ void CESkyCoord::CIRS2ICRS(const CESkyCoord& in_cirs,
  * @param[out] out_galactic     Output Galactic coordinates
  * @param[in]  date             Date for conversion
  *************************************************************************/
-void CESkyCoord::CIRS2Galactic(const CESkyCoord& in_cirs,
-                               CESkyCoord*       out_galactic,
-                               const CEDate&     date)
+void CESkyCoord::CIRS2Galactic(const CESkyCoord&   in_cirs,
+                               CESkyCoord*         out_galactic,
+                               const CETimeScales& date)
 {
     // In order to do this with the sofa package, we must first
     // convert from CIRS -> ICRS
@@ -256,12 +251,12 @@ void CESkyCoord::CIRS2Galactic(const CESkyCoord& in_cirs,
  * @param[out] observed_cirs    'Observed' CIRS coordinates
  * @param[out] hour_angle       Hour angle of coordinates for observer
  *************************************************************************/
-void CESkyCoord::CIRS2Observed(const CESkyCoord& in_cirs,
-                               CESkyCoord*       out_observed,
-                               const CEDate&     date,
-                               const CEObserver& observer,
-                               CESkyCoord*       observed_cirs,
-                               CEAngle*          hour_angle)
+void CESkyCoord::CIRS2Observed(const CESkyCoord&   in_cirs,
+                               CESkyCoord*         out_observed,
+                               const CETimeScales& date,
+                               const CEObserver&   observer,
+                               CESkyCoord*         observed_cirs,
+                               CEAngle*            hour_angle)
 {
     // Setup the observed RA, Dec and hour_angle variables
     double temp_ra(0.0);
@@ -271,14 +266,15 @@ void CESkyCoord::CIRS2Observed(const CESkyCoord& in_cirs,
     // Call the necessary sofa method
     double az(0.0);
     double zen(0.0);
+    const CEEop& eop = date.eop();
     int err_code = iauAtio13(in_cirs.XCoord(), 
                              in_cirs.YCoord(),
                              CEDate::GetMJD2JDFactor(), date.MJD(),
-                             date.dut1(),
+                             eop.dut1,
                              observer.Longitude_Rad(),
                              observer.Latitude_Rad(),
                              observer.Elevation_m(),
-                             date.xpolar(), date.ypolar(),
+                             eop.xp, eop.yp,
                              observer.Pressure_hPa(),
                              observer.Temperature_C(),
                              observer.RelativeHumidity(),
@@ -320,9 +316,9 @@ void CESkyCoord::CIRS2Observed(const CESkyCoord& in_cirs,
  * @param[out] out_ecliptic     Output ECLIPTIC coordinates
  * @param[in]  date             Date for conversion
  *************************************************************************/
-void CESkyCoord::CIRS2Ecliptic(const CESkyCoord& in_cirs,
-                               CESkyCoord*       out_ecliptic,
-                               const CEDate&     date)
+void CESkyCoord::CIRS2Ecliptic(const CESkyCoord&   in_cirs,
+                               CESkyCoord*         out_ecliptic,
+                               const CETimeScales& date)
 {
     // CIRS -> ICRS
     CESkyCoord tmp_icrs;
@@ -340,23 +336,20 @@ void CESkyCoord::CIRS2Ecliptic(const CESkyCoord& in_cirs,
  * @param[out] out_cirs         Output CIRS coordinates
  * @param[in]  date             Date for conversion
  *************************************************************************/
-void CESkyCoord::ICRS2CIRS(const CESkyCoord& in_icrs,
-                           CESkyCoord*       out_cirs,
-                           const CEDate&     date)
+void CESkyCoord::ICRS2CIRS(const CESkyCoord&   in_icrs,
+                           CESkyCoord*         out_cirs,
+                           const CETimeScales& date)
 {
     // Store the equation of the origins
     double eo; // Equation of the origins
     
     // Use the sofa library to convert these coordinates
-    double tdb1(0.0);
-    double tdb2(0.0);
-    CEDate::UTC2TDB(date.MJD(), &tdb1, &tdb2);
     double return_ra(0.0);
     double return_dec(0.0);
     iauAtci13(in_icrs.XCoord().Rad(), 
                 in_icrs.YCoord().Rad(),
                 0.0, 0.0, 0.0, 0.0, 
-                tdb1, tdb2, 
+                date.TDB1(), date.TDB2(), 
                 &return_ra, &return_dec, &eo);
     
     // Subtract the equation of the origins if J2000 coordinates are desired
@@ -405,12 +398,12 @@ void CESkyCoord::ICRS2Galactic(const CESkyCoord& in_icrs,
  * This method takes in an optional @p observed_cirs parameter that stores
  * the CIRS coordinates of a given object as they would be observed
  *************************************************************************/
-void CESkyCoord::ICRS2Observed(const CESkyCoord& in_icrs,
-                               CESkyCoord*       out_observed,
-                               const CEDate&     date,
-                               const CEObserver& observer,
-                               CESkyCoord*       observed_icrs,
-                               CEAngle*          hour_angle)
+void CESkyCoord::ICRS2Observed(const CESkyCoord&   in_icrs,
+                               CESkyCoord*         out_observed,
+                               const CETimeScales& date,
+                               const CEObserver&   observer,
+                               CESkyCoord*         observed_icrs,
+                               CEAngle*            hour_angle)
 {
     // First convert the ICRS coordinates to CIRS coordinates
     CESkyCoord tmp_cirs;
@@ -438,21 +431,16 @@ void CESkyCoord::ICRS2Observed(const CESkyCoord& in_icrs,
  * @param[out] out_ecliptic     Output ECLIPTIC coordinates
  * @param[in]  date             Date for conversion
  *************************************************************************/
-void CESkyCoord::ICRS2Ecliptic(const CESkyCoord& in_icrs,
-                               CESkyCoord*       out_ecliptic,
-                               const CEDate&     date)
+void CESkyCoord::ICRS2Ecliptic(const CESkyCoord&   in_icrs,
+                               CESkyCoord*         out_ecliptic,
+                               const CETimeScales& date)
 {
     // Use the sofa method to convert the coordinates
     double elon(0.0);
     double elat(0.0);
 
-    // Get the time in TT
-    double tt1(0.0);
-    double tt2(0.0);
-    CEDate::UTC2TT(date.MJD(), &tt1, &tt2);
-
     // Convert ICRS -> ECLIPTIC
-    iauEqec06(tt1, tt2, in_icrs.XCoord().Rad(), in_icrs.YCoord().Rad(), 
+    iauEqec06(date.TT1(), date.TT2(), in_icrs.XCoord().Rad(), in_icrs.YCoord().Rad(), 
               &elon, &elat);
     out_ecliptic->SetCoordinates(CEAngle::Rad(elon), 
                                  CEAngle::Rad(elat),
@@ -469,9 +457,9 @@ void CESkyCoord::ICRS2Ecliptic(const CESkyCoord& in_icrs,
  * @param[out] out_cirs         Output CIRS coordinates
  * @param[in]  date             Date for conversion
  *************************************************************************/
-void CESkyCoord::Galactic2CIRS(const CESkyCoord& in_galactic,
-                               CESkyCoord*       out_cirs,
-                               const CEDate&     date)
+void CESkyCoord::Galactic2CIRS(const CESkyCoord&   in_galactic,
+                               CESkyCoord*         out_cirs,
+                               const CETimeScales& date)
 {
     // Do the Galactic -> ICRS converstion
     CESkyCoord tmp_icrs;
@@ -518,12 +506,12 @@ void CESkyCoord::Galactic2ICRS(const CESkyCoord& in_galactic,
  * This method takes in an optional @p observed_galactic parameter that stores
  * the GALACTIC coordinates of a given object as they would be observed
  *************************************************************************/
-void CESkyCoord::Galactic2Observed(const CESkyCoord& in_galactic,
-                                   CESkyCoord*       out_observed,
-                                   const CEDate&     date,
-                                   const CEObserver& observer,
-                                   CESkyCoord*       observed_galactic,
-                                   CEAngle*          hour_angle)
+void CESkyCoord::Galactic2Observed(const CESkyCoord&   in_galactic,
+                                   CESkyCoord*         out_observed,
+                                   const CETimeScales& date,
+                                   const CEObserver&   observer,
+                                   CESkyCoord*         observed_galactic,
+                                   CEAngle*            hour_angle)
 {
     // Galactic -> CIRS
     CESkyCoord tmp_cirs;
@@ -550,9 +538,9 @@ void CESkyCoord::Galactic2Observed(const CESkyCoord& in_galactic,
  * @param[out] out_ecliptic      Output ECLIPTIC coordinates
  * @param[in]  date              Date for conversion
  *************************************************************************/
-void CESkyCoord::Galactic2Ecliptic(const CESkyCoord& in_galactic,
-                                   CESkyCoord*       out_ecliptic,
-                                   const CEDate&     date)
+void CESkyCoord::Galactic2Ecliptic(const CESkyCoord&   in_galactic,
+                                   CESkyCoord*         out_ecliptic,
+                                   const CETimeScales& date)
 {
     // Galactic -> ICRS
     CESkyCoord tmp_icrs;
@@ -571,25 +559,26 @@ void CESkyCoord::Galactic2Ecliptic(const CESkyCoord& in_galactic,
  * @param[in]  date              Date for conversion
  * @param[in]  observer          Observer information
  *************************************************************************/
-void CESkyCoord::Observed2CIRS(const CESkyCoord& in_observed,
-                               CESkyCoord*       out_cirs,
-                               const CEDate&     date,
-                               const CEObserver& observer)
+void CESkyCoord::Observed2CIRS(const CESkyCoord&   in_observed,
+                               CESkyCoord*         out_cirs,
+                               const CETimeScales& date,
+                               const CEObserver&   observer)
 {
     // Preliminary coordinates
     double ra(0.0);
     double dec(0.0);
 
     // Run the SOFA method
+    const CEEop& eop = date.eop();
     int err_code = iauAtoi13("A", 
                              in_observed.XCoord().Rad(), 
                              in_observed.YCoord().Rad(),
                              CEDate::GetMJD2JDFactor(), date.MJD(),
-                             date.dut1(),
+                             eop.dut1,
                              observer.Longitude_Rad(), 
                              observer.Latitude_Rad(),
                              observer.Elevation_m(),
-                             date.xpolar(), date.ypolar(),
+                             eop.xp, eop.yp,
                              observer.Pressure_hPa(),
                              observer.Temperature_C(),
                              observer.RelativeHumidity(),
@@ -619,10 +608,10 @@ void CESkyCoord::Observed2CIRS(const CESkyCoord& in_observed,
  * @param[in]  date              Date for conversion
  * @param[in]  observer          Observer information
  *************************************************************************/
-void CESkyCoord::Observed2ICRS(const CESkyCoord& in_observed,
-                               CESkyCoord*       out_icrs,
-                               const CEDate&     date,
-                               const CEObserver& observer)
+void CESkyCoord::Observed2ICRS(const CESkyCoord&   in_observed,
+                               CESkyCoord*         out_icrs,
+                               const CETimeScales& date,
+                               const CEObserver&   observer)
 {
     // Convert from Observed -> CIRS
     CESkyCoord tmp_cirs;
@@ -641,10 +630,10 @@ void CESkyCoord::Observed2ICRS(const CESkyCoord& in_observed,
  * @param[in]  date              Date for conversion
  * @param[in]  observer          Observer information
  *************************************************************************/
-void CESkyCoord::Observed2Galactic(const CESkyCoord& in_observed,
-                                   CESkyCoord*       out_galactic,
-                                   const CEDate&     date,
-                                   const CEObserver& observer)
+void CESkyCoord::Observed2Galactic(const CESkyCoord&   in_observed,
+                                   CESkyCoord*         out_galactic,
+                                   const CETimeScales& date,
+                                   const CEObserver&   observer)
 {
     // Convert from Observed -> ICRS
     CESkyCoord tmp_icrs;
@@ -663,10 +652,10 @@ void CESkyCoord::Observed2Galactic(const CESkyCoord& in_observed,
  * @param[in]  date              Date for conversion
  * @param[in]  observer          Observer information
  *************************************************************************/
-void CESkyCoord::Observed2Ecliptic(const CESkyCoord& in_observed,
-                                   CESkyCoord*       out_ecliptic,
-                                   const CEDate&     date,
-                                   const CEObserver& observer)
+void CESkyCoord::Observed2Ecliptic(const CESkyCoord&   in_observed,
+                                   CESkyCoord*         out_ecliptic,
+                                   const CETimeScales& date,
+                                   const CEObserver&   observer)
 {
     // Convert from Observed -> ICRS
     CESkyCoord tmp_icrs;
@@ -684,9 +673,9 @@ void CESkyCoord::Observed2Ecliptic(const CESkyCoord& in_observed,
  * @param[out] out_cirs          Output CIRS coordinates
  * @param[in]  date              Date for conversion
  *************************************************************************/
-void CESkyCoord::Ecliptic2CIRS(const CESkyCoord& in_ecliptic,
-                               CESkyCoord*       out_cirs,
-                               const CEDate&     date)
+void CESkyCoord::Ecliptic2CIRS(const CESkyCoord&   in_ecliptic,
+                               CESkyCoord*         out_cirs,
+                               const CETimeScales& date)
 {
     // ECLIPTIC -> ICRS
     CESkyCoord tmp_icrs;
@@ -704,21 +693,16 @@ void CESkyCoord::Ecliptic2CIRS(const CESkyCoord& in_ecliptic,
  * @param[out] out_icrs          Output ICRS coordinates
  * @param[in]  date              Date for conversion
  *************************************************************************/
-void CESkyCoord::Ecliptic2ICRS(const CESkyCoord& in_ecliptic,
-                               CESkyCoord*       out_icrs,
-                               const CEDate&     date)
+void CESkyCoord::Ecliptic2ICRS(const CESkyCoord&   in_ecliptic,
+                               CESkyCoord*         out_icrs,
+                               const CETimeScales& date)
 {
     // Create the variables used for returning ICRS
     double ra(0.0);
     double dec(0.0);
 
-    // Get current time in TT
-    double tt1(0.0);
-    double tt2(0.0);
-    CEDate::UTC2TT(date.MJD(), &tt1, &tt2);
-
     // Convert ECLIPTIC to ICRS
-    iauEceq06(tt1, tt2, 
+    iauEceq06(date.TT1(), date.TT2(), 
               in_ecliptic.XCoord().Rad(), in_ecliptic.YCoord().Rad(), 
               &ra, &dec);
 
@@ -735,9 +719,9 @@ void CESkyCoord::Ecliptic2ICRS(const CESkyCoord& in_ecliptic,
  * @param[out] out_galactic      Output GALACTIC coordinates
  * @param[in]  date              Date for conversion
  *************************************************************************/
-void CESkyCoord::Ecliptic2Galactic(const CESkyCoord& in_ecliptic,
-                                   CESkyCoord*       out_galactic,
-                                   const CEDate&     date)
+void CESkyCoord::Ecliptic2Galactic(const CESkyCoord&   in_ecliptic,
+                                   CESkyCoord*         out_galactic,
+                                   const CETimeScales& date)
 {
     // ECLIPTIC -> ICRS
     CESkyCoord tmp_icrs;
@@ -756,10 +740,10 @@ void CESkyCoord::Ecliptic2Galactic(const CESkyCoord& in_ecliptic,
  * @param[in]  date              Date for conversion
  * @param[in]  observer          Observer information
  *************************************************************************/
-void CESkyCoord::Ecliptic2Observed(const CESkyCoord& in_ecliptic,
-                                   CESkyCoord*       out_observed,
-                                   const CEDate&     date,
-                                   const CEObserver& observer)
+void CESkyCoord::Ecliptic2Observed(const CESkyCoord&   in_ecliptic,
+                                   CESkyCoord*         out_observed,
+                                   const CETimeScales& date,
+                                   const CEObserver&   observer)
 {
     // ECLIPTIC -> CIRS
     CESkyCoord tmp_cirs;
@@ -784,9 +768,9 @@ void CESkyCoord::Ecliptic2Observed(const CESkyCoord& in_ecliptic,
  * @param[in] date                 Julian date for conversion
  * @return Coordinates object that represents coordinates we're converting to
  *************************************************************************/
-CESkyCoord CESkyCoord::ConvertTo(const CESkyCoordType&  output_coord_type, 
-                                 const CEDate&     date,
-                                 const CEObserver& observer)
+CESkyCoord CESkyCoord::ConvertTo(const CESkyCoordType&  output_coord_type,
+                                 const CETimeScales&    date,
+                                 const CEObserver&      observer)
 {
     // Do conversion to CIRS
     CESkyCoord coord;
@@ -815,8 +799,8 @@ CESkyCoord CESkyCoord::ConvertTo(const CESkyCoordType&  output_coord_type,
  * Note that the @p date and @p observer parameters are only necessary if
  * they are need to convert this object
  *************************************************************************/
-CESkyCoord CESkyCoord::ConvertToCIRS(const CEDate&     date,
-                                     const CEObserver& observer)
+CESkyCoord CESkyCoord::ConvertToCIRS(const CETimeScales& date,
+                                     const CEObserver&   observer)
 {
     // Create the coordinate to be returned
     CESkyCoord cirs;
@@ -852,8 +836,8 @@ CESkyCoord CESkyCoord::ConvertToCIRS(const CEDate&     date,
  * Note that the @p date and @p observer parameters are only necessary if
  * they are need to convert this object
  *************************************************************************/
-CESkyCoord CESkyCoord::ConvertToICRS(const CEDate&     date,
-                                     const CEObserver& observer)
+CESkyCoord CESkyCoord::ConvertToICRS(const CETimeScales& date,
+                                     const CEObserver&   observer)
 {
     // Create return coordinate
     CESkyCoord icrs;
@@ -889,8 +873,8 @@ CESkyCoord CESkyCoord::ConvertToICRS(const CEDate&     date,
  * Note that the @p date and @p observer parameters are only necessary if
  * they are need to convert this object
  *************************************************************************/
-CESkyCoord CESkyCoord::ConvertToGalactic(const CEDate&     date,
-                                         const CEObserver& observer)
+CESkyCoord CESkyCoord::ConvertToGalactic(const CETimeScales& date,
+                                         const CEObserver&   observer)
 {
     // Create return coordiantes
     CESkyCoord galactic;
@@ -926,8 +910,8 @@ CESkyCoord CESkyCoord::ConvertToGalactic(const CEDate&     date,
  * Note that the @p date and @p observer parameters are only necessary if
  * they are need to convert this object
  *************************************************************************/
-CESkyCoord CESkyCoord::ConvertToObserved(const CEDate&     date,
-                                         const CEObserver& observer)
+CESkyCoord CESkyCoord::ConvertToObserved(const CETimeScales& date,
+                                         const CEObserver&   observer)
 {
     // Create return coordinates
     CESkyCoord observed;
@@ -963,8 +947,8 @@ CESkyCoord CESkyCoord::ConvertToObserved(const CEDate&     date,
  * Note that the @p date and @p observer parameters are only necessary if
  * they are need to convert this object
  *************************************************************************/
-CESkyCoord CESkyCoord::ConvertToEcliptic(const CEDate&     date,
-                                         const CEObserver& observer)
+CESkyCoord CESkyCoord::ConvertToEcliptic(const CETimeScales& date,
+                                         const CEObserver&   observer)
 {
     // Create return coordinates
     CESkyCoord ecliptic;
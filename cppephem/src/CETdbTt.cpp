@@ -0,0 +1,88 @@
+/***************************************************************************
+ *  CETdbTt.cpp: CppEphem                                                  *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+/** \class CETdbTt
+ CETdbTt provides TDB-TT at the geocenter, the periodic (~1.7 ms) offset
+ that iauTttdb needs to convert TT to TDB.
+
+ SOFA's iauDtdb evaluates the full Fairhead & Bretagnon series, which has
+ several hundred terms and takes microseconds per call. Here the series
+ is fitted over 16 day segments by CEChebyshevCache, so it is only
+ evaluated at the Chebyshev nodes of a segment the first time a date in
+ that segment is needed. Every other date is a short polynomial
+ evaluation. The fit agrees with the series to a few picoseconds, far
+ better than the series itself.
+ */
+
+#include "CETdbTt.h"
+#include "CEChebyshevCache.h"
+#include "sofa.h"
+#include <sofam.h>
+
+
+/**********************************************************************//**
+ * Return TDB-TT at the geocenter
+ *
+ * @param[in] tt1           First part of the TT Julian date
+ * @param[in] tt2           Second part of the TT Julian date
+ * @return TDB-TT (seconds)
+ *************************************************************************/
+double CETdbTt::TdbTt(const double& tt1,
+                      const double& tt2)
+{
+    return CEChebyshevCache<&SeriesTdbTt, ncoeff_, segment_days_>::Value(tt1, tt2);
+}
+
+
+/**********************************************************************//**
+ * Fill an array with TDB-TT at the geocenter for an array of dates
+ *
+ * @param[in]  tt1          First parts of the TT Julian dates
+ * @param[in]  tt2          Second parts of the TT Julian dates
+ * @param[out] dtr          TDB-TT for each date (seconds)
+ * @param[in]  n            Number of dates
+ *************************************************************************/
+void CETdbTt::TdbTt(const double*      tt1,
+                    const double*      tt2,
+                    double*            dtr,
+                    const std::size_t& n)
+{
+    for (std::size_t i=0; i<n; i++) {
+        dtr[i] = TdbTt(tt1[i], tt2[i]);
+    }
+}
+
+
+/**********************************************************************//**
+ * Return TDB-TT at the geocenter from the full series
+ *
+ * @param[in] tt1           First part of the TT Julian date
+ * @param[in] tt2           Second part of the TT Julian date
+ * @return TDB-TT (seconds)
+ *
+ * This calls iauDtdb directly (TT stands in for TDB as the argument, which
+ * makes no measurable difference), it is much slower than TdbTt().
+ *************************************************************************/
+double CETdbTt::SeriesTdbTt(const double& tt1,
+                            const double& tt2)
+{
+    return iauDtdb(tt1, tt2, 0.0, 0.0, 0.0, 0.0);
+}
@@ -27,7 +27,6 @@
 
 // C++ HEADERS
 #include <stdio.h>
-#include <chrono>
 #include <ctime>
 
 // CPPEPHEM HEADERS
@@ -117,6 +116,35 @@ CETime& CETime::operator=(const CETime& other)
 }
 
 
+/**********************************************************************//**
+ * Read the system clock as whole days since 1970-01-01 and the time since
+ * midnight (UTC) of that day
+ * 
+ * @param[out] day          Days since 1970-01-01
+ * @param[out] nanosec      Nanoseconds since midnight
+ * 
+ * The clock is read once and the split is done with integer arithmetic, so
+ * this is cheap enough to call many times per second. Unix time has no leap
+ * seconds, so every day is exactly 86400 seconds long.
+ *************************************************************************/
+void CETime::CurrentUnixDay(std::int64_t* day, std::int64_t* nanosec)
+{
+    const std::int64_t day_ns(86400LL * 1000000000LL);
+    
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    std::int64_t ns = std::int64_t(now.tv_sec) * 1000000000LL + now.tv_nsec;
+
+    // Round towards negative infinity so that 'nanosec' is never negative
+    *day = ns / day_ns;
+    *nanosec = ns - (*day) * day_ns;
+    if (*nanosec < 0) {
+        *day -= 1;
+        *nanosec += day_ns;
+    }
+}
+
+
 /**********************************************************************//**
  * Get the current UTC time as seconds since midnight
  * 
@@ -124,28 +152,13 @@ CETime& CETime::operator=(const CETime& other)
  *************************************************************************/
 double CETime::CurrentUTC()
 {
-    // Construct time_t of this moment
-    std::chrono::system_clock::time_point now(std::chrono::system_clock::now());
-    std::time_t now_t(std::chrono::system_clock::to_time_t(
-                        std::chrono::system_clock::time_point(now)));
-    
-    // Get the time at midnight
-    struct tm midnight;
-    gmtime_r(&now_t, &midnight) ;
-    midnight.tm_hour = 0 ;
-    midnight.tm_min = 0 ;
-    midnight.tm_sec = 0 ;
-
-    // Midnight object
-    auto millisec_start(std::chrono::system_clock::from_time_t(mktime(&midnight)));
-
-    double start = std::chrono::duration_cast<std::chrono::microseconds>(millisec_start.time_since_epoch()).count()/1000000.0 ;
-    double stop  = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count()/1000000.0 ;
-    
-    // Return seconds and fractions of a second since midnight
-    return stop-start-midnight.tm_gmtoff ;
+    std::int64_t day;
+    std::int64_t nanosec;
+    CurrentUnixDay(&day, &nanosec);
+    return nanosec * 1.0e-9;
 }
 
+
 /**********************************************************************//**
  * Get the current UTC time as a vector
  * 
@@ -0,0 +1,289 @@
+/***************************************************************************
+ *  CETimeScales.cpp: CppEphem                                             *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+/** \class CETimeScales
+ CETimeScales holds a UTC date together with the same moment in the other
+ time scales used by SOFA (UT1, TAI, TT and TDB) and the Earth rotation
+ angle.
+
+ The coordinate conversions need several of these for the same date, and
+ computing them separately repeats the Earth orientation lookup and the
+ UTC -> TAI -> TT chain for each of them. This object does the lookup and
+ the chain once, the first time any of the time scales is asked for, after
+ which every time scale is just a member access. Conversions that don't
+ depend on the date (e.g. ICRS -> Galactic) never pay for them.
+
+ CESkyCoord, CEObserver and CEPlanet accept a CETimeScales wherever they
+ take a date, and a CEDate converts to one implicitly.
+
+ The UTC date is kept as the two parts of the CEDate it was set from, so
+ a date given as a Julian date keeps its full resolution (rather than the
+ ~1 microsecond of a single modified Julian date). For a date given as a
+ modified Julian date UT1 and TAI are identical to those from
+ CEDate::UTC2UT1() and CELeapSeconds::UTC2TAI().
+
+ TT is TAI + 32.184 s (as in CELeapSeconds::UTC2TT() and CENanoTime), so
+ all of the time scales of one object are consistent with each other. It
+ differs from CEDate::UTC2TT(), which adds the tabulated TT-UT1 to UT1,
+ by the error of the table (up to a few hundredths of a second). The
+ TT-UT1 value is still available from eop() where a TT based on UT1 is
+ wanted.
+
+ A const object may be shared by threads: the first thread to ask for a
+ time scale computes them all, and any other thread asking at the same
+ time waits for it.
+ */
+
+#include <thread>
+
+#include "CETimeScales.h"
+#include "CELeapSeconds.h"
+#include "CESiderealTime.h"
+#include "CETdbTt.h"
+
+
+/**********************************************************************//**
+ * Constructor from some date format (see ::CEDateType)
+ * 
+ * @param[in] date          UTC date
+ * @param[in] date_format   Format of @p date
+ *************************************************************************/
+CETimeScales::CETimeScales(const double&     date, 
+                           const CEDateType& date_format)
+{
+    init_members();
+    SetDate(CEDate(date, date_format));
+}
+
+
+/**********************************************************************//**
+ * Constructor from a date object
+ * 
+ * @param[in] date          UTC date
+ *************************************************************************/
+CETimeScales::CETimeScales(const CEDate& date)
+{
+    init_members();
+    SetDate(date);
+}
+
+
+/**********************************************************************//**
+ * Constructor from a modified Julian date and already known corrections
+ * 
+ * @param[in] mjd           UTC modified Julian date
+ * @param[in] eop           Earth orientation parameters at @p mjd
+ *************************************************************************/
+CETimeScales::CETimeScales(const double& mjd, const CEEop& eop)
+{
+    init_members();
+    SetDate(mjd, eop);
+}
+
+
+/**********************************************************************//**
+ * Copy constructor
+ * 
+ * @param[in] other         CETimeScales object to copy
+ *************************************************************************/
+CETimeScales::CETimeScales(const CETimeScales& other)
+{
+    init_members();
+    copy_members(other);
+}
+
+
+/**********************************************************************//**
+ * Destructor
+ *************************************************************************/
+CETimeScales::~CETimeScales()
+{
+    free_members();
+}
+
+
+/**********************************************************************//**
+ * Copy assignment operator
+ * 
+ * @param[in] other         CETimeScales object to copy
+ * @return Reference to this object
+ *************************************************************************/
+CETimeScales& CETimeScales::operator=(const CETimeScales& other)
+{
+    if (this != &other) {
+        free_members();
+        init_members();
+        copy_members(other);
+    }
+    return *this;
+}
+
+
+/**********************************************************************//**
+ * Set the date, looking up the corrections for it
+ * 
+ * @param[in] date          UTC date
+ *************************************************************************/
+void CETimeScales::SetDate(const CEDate& date)
+{
+    // Keep the Julian date exactly as the date object gives it
+    utc1_    = date.JD1();
+    utc2_    = date.JD2();
+    has_eop_ = false;
+    state_.store(SCALES_UNSET, std::memory_order_relaxed);
+}
+
+
+/**********************************************************************//**
+ * Set the date using already known corrections
+ * 
+ * @param[in] mjd           UTC modified Julian date
+ * @param[in] eop           Earth orientation parameters at @p mjd
+ *************************************************************************/
+void CETimeScales::SetDate(const double& mjd, const CEEop& eop)
+{
+    SetDate(DJM0, mjd, eop);
+}
+
+
+/**********************************************************************//**
+ * Set a two-part Julian date using already known corrections
+ * 
+ * @param[in] utc1          First part of the UTC Julian date
+ * @param[in] utc2          Second part of the UTC Julian date
+ * @param[in] eop           Earth orientation parameters at the date
+ *************************************************************************/
+void CETimeScales::SetDate(const double& utc1, 
+                           const double& utc2, 
+                           const CEEop&  eop)
+{
+    utc1_    = utc1;
+    utc2_    = utc2;
+    eop_     = eop;
+    has_eop_ = true;
+    state_.store(SCALES_UNSET, std::memory_order_relaxed);
+}
+
+
+/**********************************************************************//**
+ * Compute the time scales (and look up the corrections if not given)
+ * 
+ * Only one thread computes the time scales, any other thread asking for
+ * them at the same time waits until they are set.
+ *************************************************************************/
+void CETimeScales::compute(void) const
+{
+    // Claim the computation, or wait for the thread that has claimed it
+    int state = SCALES_UNSET;
+    while (!state_.compare_exchange_weak(state, SCALES_BUSY,
+                                         std::memory_order_acquire)) {
+        if (state == SCALES_SET) {
+            return;
+        }
+        state = SCALES_UNSET;
+        std::this_thread::yield();
+    }
+
+    try {
+        if (!has_eop_) {
+            eop_ = CppEphem::eop(MJD());
+        }
+
+        // UTC -> TAI, UT1
+        CELeapSeconds::UTC2TAI(utc1_, utc2_, &tai1_, &tai2_);
+        CELeapSeconds::UTC2UT1(utc1_, utc2_, eop_.dut1, &ut11_, &ut12_);
+
+        // TAI -> TT -> TDB
+        iauTaitt(tai1_, tai2_, &tt1_, &tt2_);
+        iauTttdb(tt1_, tt2_, CETdbTt::TdbTt(tt1_, tt2_), &tdb1_, &tdb2_);
+
+        // Earth rotation angle
+        era_ = CESiderealTime::ERA(ut11_, ut12_);
+    } catch (...) {
+        // Let the next caller try again (and see the error as well)
+        state_.store(SCALES_UNSET, std::memory_order_release);
+        throw;
+    }
+
+    state_.store(SCALES_SET, std::memory_order_release);
+}
+
+
+/**********************************************************************//**
+ * Free data members
+ *************************************************************************/
+void CETimeScales::free_members(void)
+{}
+
+
+/**********************************************************************//**
+ * Copy data members from another object
+ * 
+ * @param[in] other         CETimeScales object to copy from
+ *************************************************************************/
+void CETimeScales::copy_members(const CETimeScales& other)
+{
+    utc1_    = other.utc1_;
+    utc2_    = other.utc2_;
+    has_eop_ = other.has_eop_;
+
+    // The other object's time scales are only copied once they are set
+    if (other.state_.load(std::memory_order_acquire) == SCALES_SET) {
+        eop_  = other.eop_;
+        ut11_ = other.ut11_;
+        ut12_ = other.ut12_;
+        tai1_ = other.tai1_;
+        tai2_ = other.tai2_;
+        tt1_  = other.tt1_;
+        tt2_  = other.tt2_;
+        tdb1_ = other.tdb1_;
+        tdb2_ = other.tdb2_;
+        era_  = other.era_;
+        state_.store(SCALES_SET, std::memory_order_release);
+    } else {
+        if (has_eop_) {
+            eop_ = other.eop_;
+        }
+        state_.store(SCALES_UNSET, std::memory_order_relaxed);
+    }
+}
+
+
+/**********************************************************************//**
+ * Initialize the data members
+ *************************************************************************/
+void CETimeScales::init_members(void)
+{
+    utc1_    = 0.0;
+    utc2_    = 0.0;
+    has_eop_ = false;
+    state_.store(SCALES_UNSET, std::memory_order_relaxed);
+    eop_     = CEEop();
+    ut11_    = 0.0;
+    ut12_    = 0.0;
+    tai1_    = 0.0;
+    tai2_    = 0.0;
+    tt1_     = 0.0;
+    tt2_     = 0.0;
+    tdb1_    = 0.0;
+    tdb2_    = 0.0;
+    era_     = 0.0;
+}
@@ -132,7 +132,7 @@ int main(int argc, char** argv)
         usleep(update_freq*1000);
         
         // Update the date to the current time
-        date.SetDate() ;
+        date.SetDateNow() ;
         // Compute tdb
         double jd_tdb = CEDate::UTC2TDB( date ) ;
         
@@ -19,8 +19,15 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <thread>
+
 #include "test_CEDate.h"
 #include "CENamespace.h"
+#include "CELeapSeconds.h"
+#include "CETdbTt.h"
 
 
 /**********************************************************************//**
@@ -56,8 +63,12 @@ bool test_CEDate::runtests()
     test_SetDate_JD();
     test_SetDate_MJD();
     test_Gregorian();
+    test_LazyGregorian();
+    test_ArrayConversions();
+    test_CurrentJD();
     test_ReturnType();
     test_support_methods();
+    test_LeapSeconds();
 
     return pass();
 }
@@ -170,6 +181,178 @@ bool test_CEDate::test_Gregorian()
 }
 
 
+/**********************************************************************//**
+ * Test that the Gregorian date computed on demand matches the converters
+ *************************************************************************/
+bool test_CEDate::test_LazyGregorian(void)
+{
+    // A modified Julian date with a non-zero day fraction
+    double mjd = 58849.75;
+    std::vector<double> greg_vect = CEDate::MJD2GregorianVect(mjd);
+    CEDate test1(mjd, CEDateType::MJD);
+    test_double(test1.MJD(), mjd, __func__, __LINE__);
+    test_double(test1.JD(), mjd + DJM0, __func__, __LINE__);
+
+    // Copies made before the Gregorian date is computed must compute it too
+    CEDate test2(test1);
+    test_int(test1.Year(), int(greg_vect[0]), __func__, __LINE__);
+    test_int(test1.Month(), int(greg_vect[1]), __func__, __LINE__);
+    test_int(test1.Day(), int(greg_vect[2]), __func__, __LINE__);
+    test_double(test1.DayFraction(), greg_vect[3], __func__, __LINE__);
+    test_double(test1.Gregorian(), CEDate::MJD2Gregorian(mjd), __func__, __LINE__);
+    test_vect(test2.GregorianVect(), greg_vect, __func__, __LINE__);
+
+    // Setting a new date must not return the previous Gregorian date
+    test1.SetDate(base_date_.JD(), CEDateType::JD);
+    test_double(test1.Gregorian(), base_date_.Gregorian(), __func__, __LINE__);
+    test_double(test1.Gregorian(), 20000101.5, __func__, __LINE__);
+
+    // Copy initialization keeps the return type of the copied date
+    test1.SetReturnType(CEDateType::MJD);
+    CEDate test3 = test1;
+    test_double(test3, base_date_.MJD(), __func__, __LINE__);
+
+    // Threads sharing a date all get the same Gregorian date
+    const CEDate shared(mjd, CEDateType::MJD);
+    std::vector<double>      greg(4, 0.0);
+    std::vector<std::thread> threads;
+    for (std::size_t i=0; i<greg.size(); i++) {
+        threads.push_back(std::thread([&shared, &greg, i]() {
+            greg[i] = shared.Gregorian();
+        }));
+    }
+    for (std::size_t i=0; i<threads.size(); i++) {
+        threads[i].join();
+    }
+    test_vect(greg, std::vector<double>(4, CEDate::MJD2Gregorian(mjd)), __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test that the array converters match the single date converters
+ *************************************************************************/
+bool test_CEDate::test_ArrayConversions(void)
+{
+    // Julian dates at the start, middle and end of days, around leap days,
+    // before the Gregorian calendar and one that iauJd2cal rejects
+    std::vector<double> jd = {2451545.0, 2451544.5, 2451544.4999999, 
+                              2451604.5, 2451603.75, 2458849.5 + 1.0e-9,
+                              2299160.25, 0.0, -1.0e6};
+    std::size_t n = jd.size();
+    std::vector<double> mjd(n), greg(n), back(n), fd(n);
+    std::vector<int>    iy(n), im(n), id(n);
+
+    // JD <-> MJD
+    CEDate::JD2MJD(&jd[0], &mjd[0], n);
+    CEDate::MJD2JD(&mjd[0], &back[0], n);
+    for (std::size_t i=0; i<n; i++) {
+        test_double(mjd[i], CEDate::JD2MJD(jd[i]), __func__, __LINE__);
+        test_double(back[i], CEDate::MJD2JD(mjd[i]), __func__, __LINE__);
+    }
+
+    // JD, MJD -> Gregorian
+    CEDate::JD2GregorianVect(&jd[0], &iy[0], &im[0], &id[0], &fd[0], n);
+    for (std::size_t i=0; i<n; i++) {
+        std::vector<double> vect = CEDate::JD2GregorianVect(jd[i]);
+        test_bool((iy[i] == vect[0]) && (im[i] == vect[1]) && (id[i] == vect[2]) &&
+                  (fd[i] == vect[3]), true, __func__, __LINE__);
+    }
+    CEDate::MJD2GregorianVect(&mjd[0], &iy[0], &im[0], &id[0], &fd[0], n);
+    for (std::size_t i=0; i<n; i++) {
+        std::vector<double> vect = CEDate::MJD2GregorianVect(mjd[i]);
+        test_bool((iy[i] == vect[0]) && (im[i] == vect[1]) && (id[i] == vect[2]) &&
+                  (fd[i] == vect[3]), true, __func__, __LINE__);
+    }
+    CEDate::JD2Gregorian(&jd[0], &greg[0], n);
+    for (std::size_t i=0; i<n; i++) {
+        test_bool(greg[i] == CEDate::JD2Gregorian(jd[i]), true, __func__, __LINE__);
+    }
+    CEDate::MJD2Gregorian(&mjd[0], &back[0], n);
+    for (std::size_t i=0; i<n; i++) {
+        test_bool(back[i] == CEDate::MJD2Gregorian(mjd[i]), true, __func__, __LINE__);
+    }
+
+    // Gregorian -> JD, MJD (including an invalid month)
+    greg[n-1] = 20001301.5;
+    CEDate::Gregorian2JD(&greg[0], &back[0], n);
+    for (std::size_t i=0; i<n; i++) {
+        test_bool(back[i] == CEDate::Gregorian2JD(greg[i]), true, __func__, __LINE__);
+    }
+    CEDate::Gregorian2MJD(&greg[0], &back[0], n);
+    for (std::size_t i=0; i<n; i++) {
+        test_bool(back[i] == CEDate::Gregorian2MJD(greg[i]), true, __func__, __LINE__);
+    }
+
+    // Gregorian <-> Gregorian vector
+    CEDate::Gregorian2GregorianVect(&greg[0], &iy[0], &im[0], &id[0], &fd[0], n);
+    for (std::size_t i=0; i<n; i++) {
+        std::vector<double> vect = CEDate::Gregorian2GregorianVect(greg[i]);
+        test_bool((iy[i] == vect[0]) && (im[i] == vect[1]) && (id[i] == vect[2]) &&
+                  (fd[i] == vect[3]), true, __func__, __LINE__);
+    }
+    CEDate::GregorianVect2Gregorian(&iy[0], &im[0], &id[0], &fd[0], &back[0], n);
+    for (std::size_t i=0; i<n; i++) {
+        std::vector<double> vect = {double(iy[i]), double(im[i]), double(id[i]), fd[i]};
+        test_bool(back[i] == CEDate::GregorianVect2Gregorian(vect), true, __func__, __LINE__);
+    }
+
+    // Gregorian vector -> JD, MJD
+    CEDate::GregorianVect2JD(&iy[0], &im[0], &id[0], &fd[0], &back[0], n);
+    for (std::size_t i=0; i<n; i++) {
+        std::vector<double> vect = {double(iy[i]), double(im[i]), double(id[i]), fd[i]};
+        test_bool(back[i] == CEDate::GregorianVect2JD(vect), true, __func__, __LINE__);
+    }
+    CEDate::GregorianVect2MJD(&iy[0], &im[0], &id[0], &fd[0], &back[0], n);
+    for (std::size_t i=0; i<n; i++) {
+        std::vector<double> vect = {double(iy[i]), double(im[i]), double(id[i]), fd[i]};
+        test_bool(back[i] == CEDate::GregorianVect2MJD(vect), true, __func__, __LINE__);
+    }
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test the current date against the clock of the C library
+ *************************************************************************/
+bool test_CEDate::test_CurrentJD(void)
+{
+    // Julian date of the current time according to time()
+    double jd_time = 2440587.5 + std::time(nullptr)/DAYSEC;
+
+    // The two-part date is a whole (MJD) day plus the fraction of the day
+    double jd1;
+    double jd2;
+    CEDate::CurrentJD(&jd1, &jd2);
+    test_double(jd1 - DJM0, std::floor(jd1 - DJM0), __func__, __LINE__);
+    test_bool(jd2 >= 0.0, true, __func__, __LINE__);
+    test_lessthan(jd2, 1.0, __func__, __LINE__);
+
+    // All of them should agree to within a few seconds
+    test_lessthan(std::fabs(jd1 + jd2 - jd_time), 5.0/DAYSEC, __func__, __LINE__);
+    test_lessthan(std::fabs(CEDate::CurrentJD() - jd_time), 5.0/DAYSEC, __func__, __LINE__);
+
+    // Setting the date to now keeps both parts
+    CEDate test1(base_date_);
+    test1.SetDateNow();
+    test_lessthan(std::fabs(test1.JD() - jd_time), 5.0/DAYSEC, __func__, __LINE__);
+    test_lessthan(std::fabs(test1.MJD() - (jd_time - DJM0)), 5.0/DAYSEC, __func__, __LINE__);
+    test_int(test1.Year(), int(CEDate::JD2GregorianVect(test1.JD())[0]), __func__, __LINE__);
+
+    // Time of day from CETime should agree with the date
+    double seconds = std::fmod(std::time(nullptr), DAYSEC);
+    double utc     = CETime::CurrentUTC();
+    test_bool(utc >= 0.0, true, __func__, __LINE__);
+    test_lessthan(utc, DAYSEC, __func__, __LINE__);
+    test_lessthan(std::min(std::fabs(utc - seconds), DAYSEC - std::fabs(utc - seconds)), 
+                  5.0, __func__, __LINE__);
+
+    return pass();
+}
+
+
 /**********************************************************************//**
  * Test ability set the return type
  *************************************************************************/
@@ -229,6 +412,16 @@ bool test_CEDate::test_support_methods(void)
     test_double(CEDate::xpolar(mjd, CEDateType::MJD), xpolar, __func__, __LINE__);
     test_double(CEDate::ypolar(mjd, CEDateType::MJD), ypolar, __func__, __LINE__);
 
+    // Test the bundled Earth orientation parameters
+    CEEop eop = base_date_.eop();
+    test_double(eop.dut1, dut1, __func__, __LINE__);
+    test_double(eop.xp, xpolar, __func__, __LINE__);
+    test_double(eop.yp, ypolar, __func__, __LINE__);
+    test_double(eop.dpsi, CppEphem::dpsi(mjd), __func__, __LINE__);
+    test_double(eop.deps, CppEphem::deps(mjd), __func__, __LINE__);
+    test_double(eop.ttut1, CppEphem::ttut1(mjd), __func__, __LINE__);
+    test_double(CEDate::eop(mjd, CEDateType::MJD).ttut1, eop.ttut1, __func__, __LINE__);
+
     // UTC -> UT1
     double test_ut1 = base_date_.MJD() + (base_date_.dut1() / CppEphem::sec_per_day());
     double ut11, ut12;
@@ -246,12 +439,57 @@ bool test_CEDate::test_support_methods(void)
 
     // UTC -> TDB
     // NOTE: This is not a good test without the correct corrections
-    double test_tdb(test_tt);
+    double test_tdb(test_tt + CETdbTt::SeriesTdbTt(tt1, tt2)/DAYSEC);
     double tdb1, tdb2;
     CEDate::UTC2TDB(base_date_.MJD(), &tdb1, &tdb2);
     test_double(tdb1, CEDate::GetMJD2JDFactor(), __func__, __LINE__);
     test_double(tdb2, test_tdb, __func__, __LINE__);
 
+    // Conversions using already known corrections should be identical
+    double tdb1_eop, tdb2_eop;
+    CEDate::UTC2TDB(base_date_.MJD(), eop, &tdb1_eop, &tdb2_eop);
+    test_double(tdb1_eop, tdb1, __func__, __LINE__);
+    test_double(tdb2_eop, tdb2, __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test the cached leap second table against SOFA
+ *************************************************************************/
+bool test_CEDate::test_LeapSeconds(void)
+{
+    // TAI-UTC either side of the leap second at the end of 2016
+    test_double(CELeapSeconds::TaiUtc(51544.5), 32.0, __func__, __LINE__);
+    test_double(CELeapSeconds::TaiUtc(57753.9), 36.0, __func__, __LINE__);
+    test_double(CELeapSeconds::TaiUtc(57754.0), 37.0, __func__, __LINE__);
+    test_double(CELeapSeconds::FirstMJD(), 41317.0, __func__, __LINE__);
+    test_greaterthan(CELeapSeconds::LastMJD(), 57754.0, __func__, __LINE__);
+
+    // Results must be identical to SOFA, including on the day of a leap
+    // second and for dates that are not in the table (before 1972)
+    double dut1 = 0.3;
+    std::vector<double> dates = {41317.0, 51544.5, 57753.25, 57753.9999,
+                                 57754.0, 58849.75, 40000.25,
+                                 CELeapSeconds::LastMJD() + 10.0};
+    for (double mjd : dates) {
+        double tai1, tai2, sofa_tai1, sofa_tai2;
+        CELeapSeconds::UTC2TAI(mjd, &tai1, &tai2);
+        iauUtctai(DJM0, mjd, &sofa_tai1, &sofa_tai2);
+        test_bool((tai1 == sofa_tai1) && (tai2 == sofa_tai2), true, __func__, __LINE__);
+
+        double ut11, ut12, sofa_ut11, sofa_ut12;
+        CELeapSeconds::UTC2UT1(mjd, dut1, &ut11, &ut12);
+        iauUtcut1(DJM0, mjd, dut1, &sofa_ut11, &sofa_ut12);
+        test_bool((ut11 == sofa_ut11) && (ut12 == sofa_ut12), true, __func__, __LINE__);
+
+        // TT = TAI + 32.184 seconds
+        double tt1, tt2;
+        CELeapSeconds::UTC2TT(mjd, &tt1, &tt2);
+        test_double(tt2, tai2 + 32.184/DAYSEC, __func__, __LINE__);
+    }
+
     return pass();
 }
 
@@ -38,8 +38,12 @@ public:
     virtual bool test_SetDate_JD(void);
     virtual bool test_SetDate_MJD(void);
     virtual bool test_Gregorian(void);
+    virtual bool test_LazyGregorian(void);
+    virtual bool test_ArrayConversions(void);
+    virtual bool test_CurrentJD(void);
     virtual bool test_ReturnType(void);
     virtual bool test_support_methods(void);
+    virtual bool test_LeapSeconds(void);
 
 private:
 
@@ -0,0 +1,274 @@
+/***************************************************************************
+ *  test_CEDateRange.cpp: CppEphem                                         *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <cmath>
+#include <thread>
+
+#include "test_CEDateRange.h"
+#include "CEException.h"
+#include "CENamespace.h"
+#include "CEObservation.h"
+#include "CEPlanet.h"
+
+
+/**********************************************************************//**
+ * Default constructor
+ *************************************************************************/
+test_CEDateRange::test_CEDateRange() :
+    CETestSuite()
+{
+    // Six hourly dates starting at the J2000 Julian date
+    base_date_.SetDate(2451545.000000);
+    base_ = CEDateRange(base_date_.JD(), base_date_.JD() + 2.0, 0.25);
+}
+
+
+/**********************************************************************//**
+ * Destructor
+ *************************************************************************/
+test_CEDateRange::~test_CEDateRange()
+{}
+
+
+/**********************************************************************//**
+ * Run tests
+ * 
+ * @return whether or not all tests succeeded
+ *************************************************************************/
+bool test_CEDateRange::runtests()
+{
+    std::cout << "\nTesting CEDateRange:\n";
+
+    // Run each of the tests
+    test_construct();
+    test_TimeScales();
+    test_ObservedCoords();
+    test_Threads();
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test constructors
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CEDateRange::test_construct(void)
+{
+    // The stop date is part of the range
+    test_int(base_.size(), 9, __func__, __LINE__);
+    test_double(base_.JD(0), base_date_.JD(), __func__, __LINE__);
+    test_double(base_.MJD(0), base_date_.MJD(), __func__, __LINE__);
+    test_double(base_.MJD(8), base_date_.MJD() + 2.0, __func__, __LINE__);
+
+    // Default constructor is empty
+    CEDateRange test1;
+    test_int(test1.size(), 0, __func__, __LINE__);
+
+    // Dates in other formats and stop dates between the steps
+    CEDateRange test2(base_date_.MJD(), base_date_.MJD() + 2.1, 0.25, CEDateType::MJD);
+    test_int(test2.size(), 9, __func__, __LINE__);
+    test_double(test2.JD(4), base_.JD(4), __func__, __LINE__);
+
+    // Stop dates computed from a step that isn't exact in binary are kept
+    double minute = 1.0/1440.0;
+    int    short_ranges = 0;
+    for (int k=0; k<200; k++) {
+        double jd = 2459000.5 + k*0.0371;
+        CEDateRange range(jd, jd + 500*minute, minute);
+        if (range.size() != 501) short_ranges++;
+    }
+    test_int(short_ranges, 0, __func__, __LINE__);
+
+    // A given number of dates
+    CEDateRange test6 = CEDateRange::Steps(base_date_.JD(), 91, minute);
+    test_int(test6.size(), 91, __func__, __LINE__);
+    test_double(test6.JD(90), base_date_.JD() + 90*minute, __func__, __LINE__);
+    test_double(CEDateRange::Steps(base_date_.JD(), 9, 0.25).TT2(8), base_.TT2(8),
+                __func__, __LINE__);
+
+    // A list of dates
+    std::vector<double> dates = {base_date_.JD(), base_date_.JD() + 0.3, base_date_.JD() + 1.0};
+    CEDateRange test3(dates);
+    test_int(test3.size(), 3, __func__, __LINE__);
+    test_double(test3.JD(1), dates[1], __func__, __LINE__);
+
+    // Copy constructor and assignment
+    CEDateRange test4(base_);
+    test_int(test4.size(), base_.size(), __func__, __LINE__);
+    test_double(test4.TT2(3), base_.TT2(3), __func__, __LINE__);
+    test1 = test3;
+    test_double(test1.MJD(2), test3.MJD(2), __func__, __LINE__);
+
+    // Steps that aren't positive, reversed ranges and unsorted dates
+    try {
+        CEDateRange test5(base_date_.JD(), base_date_.JD() + 1.0, 0.0);
+        test(false, __func__, __LINE__);
+    } catch (CEException::invalid_value& e) {
+        test(true, __func__, __LINE__);
+    }
+    try {
+        CEDateRange test5(base_date_.JD(), base_date_.JD() - 1.0, 0.25);
+        test(false, __func__, __LINE__);
+    } catch (CEException::invalid_value& e) {
+        test(true, __func__, __LINE__);
+    }
+    try {
+        CEDateRange test5({base_date_.JD() + 1.0, base_date_.JD()});
+        test(false, __func__, __LINE__);
+    } catch (CEException::invalid_value& e) {
+        test(true, __func__, __LINE__);
+    }
+
+    // Indices past the end
+    try {
+        base_.TimeScales(base_.size());
+        test(false, __func__, __LINE__);
+    } catch (CEException::invalid_value& e) {
+        test(true, __func__, __LINE__);
+    }
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test that the time scales match those of CETimeScales for each date
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CEDateRange::test_TimeScales(void)
+{
+    for (std::size_t i=0; i<base_.size(); i++) {
+        CETimeScales times;
+        times.SetDate(base_.UTC1(i), base_.UTC2(i), CppEphem::eop(base_.MJD(i)));
+        test_double(base_.UT11(i), times.UT11(), __func__, __LINE__);
+        test_double(base_.UT12(i), times.UT12(), __func__, __LINE__);
+        test_double(base_.TAI1(i), times.TAI1(), __func__, __LINE__);
+        test_double(base_.TAI2(i), times.TAI2(), __func__, __LINE__);
+        test_double(base_.TT1(i), times.TT1(), __func__, __LINE__);
+        test_double(base_.TT2(i), times.TT2(), __func__, __LINE__);
+        test_double(base_.TDB1(i), times.TDB1(), __func__, __LINE__);
+        test_double(base_.TDB2(i), times.TDB2(), __func__, __LINE__);
+        test_double(base_.ERA(i), times.ERA(), __func__, __LINE__);
+        test_double(base_.eop(i).dut1, times.eop().dut1, __func__, __LINE__);
+        test_double(base_.eop(i).xp, times.eop().xp, __func__, __LINE__);
+        test_double(base_.eop(i).deps, times.eop().deps, __func__, __LINE__);
+        test_double(base_.eop(i).ttut1, times.eop().ttut1, __func__, __LINE__);
+        test(base_.eop(i).status == times.eop().status, __func__, __LINE__);
+
+        // A single date of the range is already computed
+        CETimeScales range_times = base_.TimeScales(i);
+        test_double(range_times.MJD(), base_.MJD(i), __func__, __LINE__);
+        test_double(range_times.TDB2(), times.TDB2(), __func__, __LINE__);
+        test_double(range_times.ERA(), times.ERA(), __func__, __LINE__);
+    }
+
+    // Steps are kept to well below the resolution of a single modified
+    // Julian date (~1 microsecond)
+    double step = 1.0 / DAYSEC;
+    CEDateRange fine(base_date_.JD(), base_date_.JD() + 10.5*step, step);
+    test_int(fine.size(), 11, __func__, __LINE__);
+    for (std::size_t i=1; i<fine.size(); i++) {
+        test_lessthan(std::fabs((fine.TAI2(i) - fine.TAI2(0)) - i*step),
+                      1.0e-9 / DAYSEC, __func__, __LINE__);
+    }
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test observing objects over a range of dates
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CEDateRange::test_ObservedCoords(void)
+{
+    CEObserver observer(0.0, 0.0, 0.0, CEAngleType::DEGREES);
+    CEBody     body("test", CEAngle::Deg(83.663), CEAngle::Deg(22.0145), 
+                    CESkyCoordType::ICRS);
+    CEPlanet   planet = CEPlanet::Mars();
+    CEDate     date(base_date_);
+
+    // Observations of a fixed object and of a planet
+    CEObservation body_obs(&observer, &body, &date);
+    CEObservation planet_obs(&observer, &planet, &date);
+    std::vector<CESkyCoord> body_coords   = body_obs.GetObservedCoords(base_);
+    std::vector<CESkyCoord> planet_coords = planet_obs.GetObservedCoords(base_);
+    test_int(body_coords.size(), base_.size(), __func__, __LINE__);
+    test_int(planet_coords.size(), base_.size(), __func__, __LINE__);
+
+    // Should match the coordinates computed for each date separately
+    for (std::size_t i=0; i<base_.size(); i++) {
+        date.SetDate(base_.JD(i));
+        CESkyCoord body_i   = body.ObservedCoords(date, observer);
+        CESkyCoord planet_i = planet.ObservedCoords(date, observer);
+        test_double(body_coords[i].XCoord().Rad(), body_i.XCoord().Rad(), __func__, __LINE__);
+        test_double(body_coords[i].YCoord().Rad(), body_i.YCoord().Rad(), __func__, __LINE__);
+        test_double(planet_coords[i].XCoord().Rad(), planet_i.XCoord().Rad(), __func__, __LINE__);
+        test_double(planet_coords[i].YCoord().Rad(), planet_i.YCoord().Rad(), __func__, __LINE__);
+    }
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test that a const range can be shared by threads
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CEDateRange::test_Threads(void)
+{
+    const CEDateRange shared(base_date_.JD(), base_date_.JD() + 2.0, 0.25);
+
+    // Each thread asks for the (not yet computed) time scales
+    std::vector<double> era(4, 0.0);
+    std::vector<std::thread> threads;
+    for (std::size_t i=0; i<era.size(); i++) {
+        threads.push_back(std::thread([&shared, &era, i]() {
+            era[i] = shared.ERA(i);
+        }));
+    }
+    for (std::size_t i=0; i<threads.size(); i++) {
+        threads[i].join();
+    }
+
+    std::vector<double> expected(era.size());
+    for (std::size_t i=0; i<era.size(); i++) {
+        expected[i] = base_.ERA(i);
+    }
+    test_vect(era, expected, __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Main method that actually runs the tests
+ *************************************************************************/
+int main(int argc, char** argv) 
+{
+    test_CEDateRange tester;
+    return (!tester.runtests());
+}
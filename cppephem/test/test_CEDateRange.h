@@ -0,0 +1,48 @@
+/***************************************************************************
+ *  test_CEDateRange.h: CppEphem                                           *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef test_CEDateRange_h
+#define test_CEDateRange_h
+
+#include "CEDateRange.h"
+#include "CETestSuite.h"
+
+class test_CEDateRange : public CETestSuite {
+public:
+    test_CEDateRange();
+    virtual ~test_CEDateRange();
+
+    virtual bool runtests();
+
+    /****** METHODS ******/
+
+    virtual bool test_construct(void);
+    virtual bool test_TimeScales(void);
+    virtual bool test_ObservedCoords(void);
+    virtual bool test_Threads(void);
+
+private:
+    CEDate      base_date_;
+    CEDateRange base_;
+
+};
+
+#endif /* test_CEDateRange_h */
@@ -23,11 +23,102 @@
  Defines tests for CENamespace
  */
 
+#include <cstdio>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <thread>
 
 #include "test_CENamespace.h"
+#include "CEException.h"
 #include "CENamespace.h"
 
+namespace {
+
+    // Decides whether a line (given its number) is copied, and may edit it
+    typedef std::function<bool(const int&, std::string*)> LineFilter;
+
+    /**********************************************************************//**
+     * Return the lines of a file
+     *************************************************************************/
+    std::vector<std::string> ReadLines(const std::string& filename)
+    {
+        std::vector<std::string> lines;
+        std::ifstream infile(filename);
+        for (std::string line; std::getline(infile, line); ) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    /**********************************************************************//**
+     * Write a copy of a file with a suffix added to its name, keeping the
+     * lines accepted by the filter (all of them without one). The copy is
+     * moved into place whole, as an updater should.
+     * 
+     * @return Name of the copy
+     *************************************************************************/
+    std::string WriteCopy(const std::string& filename,
+                          const std::string& suffix,
+                          const LineFilter&  line_filter=LineFilter())
+    {
+        std::string copy     = filename + suffix;
+        std::string tmp_file = copy + ".tmp";
+        std::vector<std::string> lines = ReadLines(filename);
+        std::ofstream outfile(tmp_file);
+        for (std::size_t i=0; i<lines.size(); i++) {
+            if (!line_filter || line_filter(int(i), &lines[i])) {
+                outfile << lines[i] << "\n";
+            }
+        }
+        outfile.close();
+        std::rename(tmp_file.c_str(), copy.c_str());
+        return copy;
+    }
+
+    /**********************************************************************//**
+     * Write a copy of the default nutation file (see WriteCopy())
+     * 
+     * @return Name of the copy
+     *************************************************************************/
+    std::string WriteNutationCopy(const std::string& suffix,
+                                  const LineFilter&  line_filter=LineFilter())
+    {
+        return WriteCopy(CECorrections().NutationFile(), suffix, line_filter);
+    }
+
+    /**********************************************************************//**
+     * Removes copies of corrections files, and the binary caches built from
+     * them, when it goes out of scope (even if a test throws)
+     *************************************************************************/
+    class ScopedRemove {
+    public:
+        explicit ScopedRemove(const std::vector<std::string>& files) : 
+            files_(files) {}
+        explicit ScopedRemove(const std::string& file) : 
+            files_(1, file) {}
+        ~ScopedRemove() {
+            for (std::size_t i=0; i<files_.size(); i++) {
+                std::remove((files_[i] + ".bin").c_str());
+                std::remove(files_[i].c_str());
+            }
+        }
+
+    private:
+        std::vector<std::string> files_;
+    };
+
+    /**********************************************************************//**
+     * Return a filter keeping the first lines of a file
+     *************************************************************************/
+    LineFilter FirstLines(const std::size_t& nlines)
+    {
+        return [nlines](const int& nline, std::string*) {
+            return std::size_t(nline) < nlines;
+        };
+    }
+} // namespace
+
 
 /**********************************************************************//**
  * Default constructor
@@ -57,6 +148,19 @@ bool test_CENamespace::runtests()
     test_SeaLevelVals();
     test_Conversions();
     test_Corrections();
+    test_CorrectionsThreaded();
+    test_CorrectionsBinaryCache();
+    test_CorrectionsParser();
+    test_CorrectionsIndex();
+    test_CorrectionsBatch();
+    test_CorrectionsSpline();
+    test_CorrectionsReload();
+    test_CorrectionsEmbedded();
+    test_CorrectionsCopy();
+    test_CorrectionsRange();
+    test_CorrectionsExtrap();
+    test_CorrectionsStats();
+    test_CorrectionsPrefetch();
     test_StrOpt();
 
     return pass();
@@ -184,6 +288,661 @@ bool test_CENamespace::test_Corrections()
 }
 
 
+/**********************************************************************//**
+ * Tests that corrections can be queried from multiple threads at once
+ *  @return Status of tests
+ *************************************************************************/
+bool test_CENamespace::test_CorrectionsThreaded()
+{
+    // Reference values computed from a single thread
+    std::vector<double> mjds = {51540.0, 51544.5, 51545.25, 51550.75};
+    std::vector<double> dut1_ref;
+    std::vector<double> ttut1_ref;
+    for (double mjd : mjds) {
+        dut1_ref.push_back(CppEphem::dut1(mjd));
+        ttut1_ref.push_back(CppEphem::ttut1(mjd));
+    }
+
+    // Hammer the corrections from several threads, each cycling through
+    // the dates in a different order so the caches keep getting replaced
+    const int nthreads = 4;
+    std::vector<int> nfail(nthreads, 0);
+    std::vector<std::thread> threads;
+    for (int t=0; t<nthreads; t++) {
+        threads.push_back(std::thread([&, t]() {
+            for (int i=0; i<10000; i++) {
+                int j = (i + t) % mjds.size();
+                if ((CppEphem::dut1(mjds[j]) != dut1_ref[j]) ||
+                    (CppEphem::ttut1(mjds[j]) != ttut1_ref[j])) {
+                    nfail[t]++;
+                }
+            }
+        }));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // None of the threads should have seen a different value
+    for (int t=0; t<nthreads; t++) {
+        test_int(nfail[t], 0, __func__, __LINE__);
+    }
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Tests that parsed corrections are cached in a binary file which is
+ * ignored once the text file it was built from changes
+ *  @return Status of tests
+ *************************************************************************/
+bool test_CENamespace::test_CorrectionsBinaryCache()
+{
+    double mjd(51544.5);
+
+    // Loading the corrections should leave a binary cache behind
+    CECorrections parsed;
+    double dut1  = parsed.dut1(mjd);
+    double xp    = parsed.xpolar(mjd);
+    double dpsi  = parsed.dpsi(mjd);
+    double ttut1 = parsed.ttut1(mjd);
+    test_bool(std::ifstream(parsed.NutationCacheFile()).good(), true, __func__, __LINE__);
+    test_bool(std::ifstream(parsed.TtUt1CacheFile()).good(), true, __func__, __LINE__);
+
+    // A new object should load the same values from the binary cache
+    CECorrections mapped;
+    test_double(mapped.dut1(mjd), dut1, __func__, __LINE__);
+    test_double(mapped.xpolar(mjd), xp, __func__, __LINE__);
+    test_double(mapped.dpsi(mjd), dpsi, __func__, __LINE__);
+    test_double(mapped.ttut1(mjd), ttut1, __func__, __LINE__);
+
+    // Write a shortened copy of the nutation file
+    std::size_t  nlines   = ReadLines(parsed.NutationFile()).size();
+    std::string  nut_file = WriteNutationCopy(".cachetest", FirstLines(nlines/2));
+    ScopedRemove cleanup(nut_file);
+
+    // Load it so that its binary cache gets written, the last date
+    // should not be available
+    double last_mjd(51553.0);
+    CECorrections shortened;
+    shortened.SetNutationFile(nut_file);
+    bool threw = false;
+    try {
+        shortened.dut1(last_mjd);
+    } catch (CEException::invalid_value& e) {
+        threw = true;
+    }
+    test_bool(threw, true, __func__, __LINE__);
+
+    // Now write the full file, the stale binary cache must be ignored
+    WriteNutationCopy(".cachetest");
+    CECorrections full;
+    full.SetNutationFile(nut_file);
+    threw = false;
+    try {
+        test_double(full.dut1(last_mjd), parsed.dut1(last_mjd), __func__, __LINE__);
+    } catch (CEException::invalid_value& e) {
+        threw = true;
+    }
+    test_bool(threw, false, __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Tests parsing of the fixed width corrections files
+ *  @return Status of tests
+ *************************************************************************/
+bool test_CENamespace::test_CorrectionsParser()
+{
+    // Parse the full files, make sure every row was read
+    CECorrections corr;
+    std::remove(corr.NutationCacheFile().c_str());
+    std::remove(corr.TtUt1CacheFile().c_str());
+    test_int(corr.NutationRows(), 0, __func__, __LINE__);
+    corr.dut1(51544.5);
+    corr.ttut1(51544.5);
+    test_int(corr.NutationRows(), 21, __func__, __LINE__);
+    test_int(corr.TtUt1Rows(), 3 + 36, __func__, __LINE__);
+    test_greaterthan(corr.NutationLoadTime(), 0.0, __func__, __LINE__);
+    test_greaterthan(corr.TtUt1LoadTime(), 0.0, __func__, __LINE__);
+
+    // Historic TT-UT1 values are stored at the start of each month
+    test_double(corr.ttut1(51544.5), 63.8285, __func__, __LINE__);
+
+    // Strip the bulletin B columns, the bulletin A values should be used
+    std::string nut_file = WriteNutationCopy(".parsertest", 
+        [](const int&, std::string* line) {
+            *line = line->substr(0, 130);
+            return true;
+        });
+    ScopedRemove cleanup(nut_file);
+
+    CECorrections bulletin_a;
+    bulletin_a.SetNutationFile(nut_file);
+    test_double(bulletin_a.dut1(51534.5), 0.3668986, __func__, __LINE__);
+    test_double(bulletin_a.xpolar(51534.5), 0.036694 * DAS2R, __func__, __LINE__);
+    test_double(bulletin_a.ypolar(51534.5), 0.380852 * DAS2R, __func__, __LINE__);
+    test_double(bulletin_a.dpsi(51534.5), 0.283 * DMAS2R, __func__, __LINE__);
+    test_double(bulletin_a.deps(51534.5), -0.317 * DMAS2R, __func__, __LINE__);
+    test_int(bulletin_a.NutationRows(), 21, __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Tests looking up rows in regularly and irregularly spaced tables
+ *  @return Status of tests
+ *************************************************************************/
+bool test_CENamespace::test_CorrectionsIndex()
+{
+    // Daily nutation table, including dates exactly on a row
+    CECorrections full;
+    test_double(full.dut1(51544.5), 0.355499, __func__, __LINE__);
+    test_double(full.dut1(51545.0), 0.355499, __func__, __LINE__);
+    test_double(full.dut1(51553.999), full.dut1(51553.5), __func__, __LINE__);
+
+    // Monthly and quarterly TT-UT1 table
+    test_double(full.ttut1(51544.5), 63.8285, __func__, __LINE__);
+    test_double(full.ttut1(51575.0), 63.8285, __func__, __LINE__);
+    test_double(full.ttut1(51575.5), 63.8557, __func__, __LINE__);
+    test_double(full.ttut1(58500.0), 69.34, __func__, __LINE__);
+
+    // Remove a few days from the nutation table
+    std::string nut_file = WriteNutationCopy(".indextest", 
+        [](const int& nline, std::string*) {
+            return (nline < 4) || (nline > 6);
+        });
+    ScopedRemove cleanup(nut_file);
+
+    // Dates in the gap should use the last row before the gap
+    CECorrections gapped;
+    gapped.SetNutationFile(nut_file);
+    test_double(gapped.dut1(51539.5), full.dut1(51537.5), __func__, __LINE__);
+    test_double(gapped.dut1(51541.0), full.dut1(51537.5), __func__, __LINE__);
+    test_double(gapped.dut1(51541.5), full.dut1(51541.5), __func__, __LINE__);
+    test_double(gapped.xpolar(51550.25), full.xpolar(51550.25), __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Tests the batched corrections lookups
+ *  @return Status of tests
+ *************************************************************************/
+bool test_CENamespace::test_CorrectionsBatch()
+{
+    // Sorted and unsorted dates (including dates exactly on a table row)
+    std::vector<double> sorted   = {51535.5, 51540.0, 51540.25, 51544.5, 51544.5, 51553.9};
+    std::vector<double> unsorted = {51544.5, 51535.5, 51553.9, 51540.0, 51544.5, 51540.25};
+
+    for (auto interp : {CEInterpType::NONE, CEInterpType::LINEAR, CEInterpType::CUBIC}) {
+        CppEphem::CorrectionsInterp(interp);
+        for (auto mjd : {sorted, unsorted}) {
+            std::vector<double> dut1  = CppEphem::dut1(mjd);
+            std::vector<double> xp    = CppEphem::xp(mjd);
+            std::vector<double> yp    = CppEphem::yp(mjd);
+            std::vector<double> deps  = CppEphem::deps(mjd);
+            std::vector<double> dpsi  = CppEphem::dpsi(mjd);
+            std::vector<double> ttut1 = CppEphem::ttut1(mjd);
+            std::vector<CEEop>  eop   = CppEphem::eop(mjd);
+            test_int(dut1.size(), mjd.size(), __func__, __LINE__);
+            test_int(eop.size(), mjd.size(), __func__, __LINE__);
+
+            // Values should match the single date lookups exactly
+            int nfail = 0;
+            for (std::size_t i=0; i<mjd.size(); i++) {
+                if ((dut1[i]  != CppEphem::dut1(mjd[i]))  ||
+                    (xp[i]    != CppEphem::xp(mjd[i]))    ||
+                    (yp[i]    != CppEphem::yp(mjd[i]))    ||
+                    (deps[i]  != CppEphem::deps(mjd[i]))  ||
+                    (dpsi[i]  != CppEphem::dpsi(mjd[i]))  ||
+                    (ttut1[i] != CppEphem::ttut1(mjd[i]))) {
+                    nfail++;
+                }
+                CEEop single = CppEphem::eop(mjd[i]);
+                if ((eop[i].dut1 != single.dut1) || (eop[i].xp != single.xp) ||
+                    (eop[i].yp != single.yp) || (eop[i].deps != single.deps) ||
+                    (eop[i].dpsi != single.dpsi) || (eop[i].ttut1 != single.ttut1) ||
+                    (eop[i].status != single.status)) {
+                    nfail++;
+                }
+            }
+            test_int(nfail, 0, __func__, __LINE__);
+        }
+    }
+    CppEphem::CorrectionsInterp(false);
+
+    // Dates outside of the table should throw
+    for (auto mjd : {sorted, unsorted}) {
+        mjd.push_back(60000.0);
+        bool threw = false;
+        try {
+            CppEphem::dut1(mjd);
+        } catch (CEException::invalid_value& e) {
+            threw = true;
+        }
+        test_bool(threw, true, __func__, __LINE__);
+    }
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Tests the cubic spline interpolation of the corrections
+ *  @return Status of tests
+ *************************************************************************/
+bool test_CENamespace::test_CorrectionsSpline()
+{
+    CECorrections corr;
+    corr.SetInterp(CEInterpType::CUBIC);
+    test_bool(corr.InterpType() == CEInterpType::CUBIC, true, __func__, __LINE__);
+    corr.SetInterp(true);
+    test_bool(corr.InterpType() == CEInterpType::LINEAR, true, __func__, __LINE__);
+
+    // The spline passes through the tabulated values
+    CECorrections none;
+    corr.SetInterp(CEInterpType::CUBIC);
+    double eps(1.0e-7);
+    double old_tol = DblTol();
+    SetDblTol(1.0e-6);
+    test_double(corr.dut1(51544.0 + eps), none.dut1(51544.5), __func__, __LINE__);
+    test_double(corr.dut1(51545.0), none.dut1(51545.5), __func__, __LINE__);
+    test_double(corr.xpolar(51549.0 + eps), none.xpolar(51549.5), __func__, __LINE__);
+    test_double(corr.ttut1(51544.0 + eps), 63.8285, __func__, __LINE__);
+    test_double(corr.ttut1(51575.0), 63.8557, __func__, __LINE__);
+
+    // ... and is continuous across rows
+    test_double(corr.dut1(51547.0 - eps), corr.dut1(51547.0 + eps), __func__, __LINE__);
+    test_double(corr.ypolar(51547.0 - eps), corr.ypolar(51547.0 + eps), __func__, __LINE__);
+    SetDblTol(old_tol);
+
+    // Between rows it should be close to the linear interpolation
+    CECorrections linear;
+    linear.SetInterp(CEInterpType::LINEAR);
+    test_lessthan(std::fabs(corr.dut1(51544.5) - linear.dut1(51544.5)), 1.0e-3, __func__, __LINE__);
+    test_lessthan(std::fabs(corr.xpolar(51544.5) - linear.xpolar(51544.5)), 1.0e-3*DAS2R, __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Tests replacing the corrections tables with updated files
+ *  @return Status of tests
+ *************************************************************************/
+bool test_CENamespace::test_CorrectionsReload()
+{
+    // Start from a shortened copy of the nutation file
+    CECorrections full;
+    std::vector<std::string> lines = ReadLines(full.NutationFile());
+    auto write_file = [&](std::size_t nlines) {
+        return WriteNutationCopy(".reloadtest", FirstLines(nlines));
+    };
+    std::string  nut_file = write_file(lines.size()/2);
+    ScopedRemove cleanup(nut_file);
+
+    CECorrections corr;
+    corr.SetNutationFile(nut_file);
+    test_int(corr.NutationRows(), 0, __func__, __LINE__);
+    test_bool(corr.Reload(), true, __func__, __LINE__);
+    corr.dut1(51535.5);
+    test_int(corr.NutationRows(), lines.size()/2, __func__, __LINE__);
+
+    // Reload the full file while another thread is doing lookups
+    write_file(lines.size());
+    std::atomic<bool> done(false);
+    std::atomic<int>  nfail(0);
+    std::thread reader([&]() {
+        while (!done.load()) {
+            if (corr.dut1(51535.5) != full.dut1(51535.5)) {
+                nfail++;
+            }
+        }
+    });
+    test_bool(corr.Reload(), true, __func__, __LINE__);
+    done.store(true);
+    reader.join();
+    test_int(nfail.load(), 0, __func__, __LINE__);
+    test_int(corr.NutationRows(), lines.size(), __func__, __LINE__);
+    test_double(corr.dut1(51553.5), full.dut1(51553.5), __func__, __LINE__);
+
+    // Replaced tables are freed once no lookup is using them
+    std::uint64_t ntables = corr.Stats().nutation.tables;
+    for (int i=0; i<20; i++) {
+        test_bool(corr.Reload(), true, __func__, __LINE__);
+        corr.dut1(51535.5 + 0.5*i);
+    }
+    test_int(corr.Stats().nutation.tables, ntables, __func__, __LINE__);
+
+    // A missing file keeps the current values
+    std::remove(nut_file.c_str());
+    test_bool(corr.Reload(), false, __func__, __LINE__);
+    test_double(corr.dut1(51553.5), full.dut1(51553.5), __func__, __LINE__);
+
+    // Watching the file reloads it when it changes (Linux only)
+    write_file(lines.size());
+    if (corr.SetWatchFiles(true)) {
+        test_bool(corr.WatchFiles(), true, __func__, __LINE__);
+        write_file(lines.size()/2);
+        for (int i=0; (i<200) && (corr.NutationRows() != lines.size()/2); i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        test_int(corr.NutationRows(), lines.size()/2, __func__, __LINE__);
+        test_bool(corr.SetWatchFiles(false), false, __func__, __LINE__);
+    }
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Tests the corrections tables compiled into the library (only when
+ * CppEphem was configured with -Dembedcorr=ON)
+ *  @return Status of tests
+ *************************************************************************/
+bool test_CENamespace::test_CorrectionsEmbedded()
+{
+    #ifdef CE_EMBED_CORRECTIONS
+    // Missing default files should fall back to the embedded tables
+    std::string missing_dir = "/nonexistent/cppephem/";
+    CECorrections files;
+    CECorrections embedded;
+    embedded.SetNutationFile(missing_dir + "nutation.txt");
+    embedded.SetTtUt1HistFile(missing_dir + "ttut1_historic.txt");
+    embedded.SetTtUt1PredFile(missing_dir + "ttut1_predicted.txt");
+    test_double(embedded.dut1(51544.5), files.dut1(51544.5), __func__, __LINE__);
+    test_double(embedded.xpolar(51550.0), files.xpolar(51550.0), __func__, __LINE__);
+    test_double(embedded.dpsi(51540.0), files.dpsi(51540.0), __func__, __LINE__);
+    test_double(embedded.ttut1(58500.0), files.ttut1(58500.0), __func__, __LINE__);
+    test_int(embedded.NutationRows(), files.NutationRows(), __func__, __LINE__);
+    test_int(embedded.TtUt1Rows(), files.TtUt1Rows(), __func__, __LINE__);
+
+    // Other files have no embedded copy
+    CECorrections other;
+    other.SetNutationFile(missing_dir + "finals2000A.all");
+    bool threw = false;
+    try {
+        other.dut1(51544.5);
+    } catch (std::exception& e) {
+        threw = true;
+    }
+    test_bool(threw, true, __func__, __LINE__);
+    #endif
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Tests that copies share the loaded tables but not their settings
+ *  @return Status of tests
+ *************************************************************************/
+bool test_CENamespace::test_CorrectionsCopy()
+{
+    CECorrections orig;
+    double dut1 = orig.dut1(51544.75);
+
+    // Copies start out with the already loaded table
+    CECorrections copy(orig);
+    CECorrections assigned;
+    assigned = orig;
+    test_int(copy.NutationRows(), orig.NutationRows(), __func__, __LINE__);
+    test_int(assigned.NutationRows(), orig.NutationRows(), __func__, __LINE__);
+    test_double(copy.NutationLoadTime(), orig.NutationLoadTime(), __func__, __LINE__);
+    test_double(copy.dut1(51544.75), dut1, __func__, __LINE__);
+    test_double(assigned.dut1(51544.75), dut1, __func__, __LINE__);
+
+    // Interpolation is set per object, even though the table is shared
+    CECorrections linear;
+    linear.SetInterp(CEInterpType::LINEAR);
+    copy.SetInterp(CEInterpType::LINEAR);
+    test_bool(orig.InterpType() == CEInterpType::NONE, true, __func__, __LINE__);
+    test_double(copy.dut1(51544.75), linear.dut1(51544.75), __func__, __LINE__);
+    test_double(orig.dut1(51544.75), dut1, __func__, __LINE__);
+
+    // Reloading a copy from another file leaves the original alone
+    std::string  nut_file = WriteNutationCopy(".copytest", FirstLines(5));
+    ScopedRemove cleanup(nut_file);
+    copy.SetNutationFile(nut_file);
+    test_bool(copy.Reload(), true, __func__, __LINE__);
+    test_int(copy.NutationRows(), 5, __func__, __LINE__);
+    test_int(orig.NutationRows(), 21, __func__, __LINE__);
+    test_int(assigned.NutationRows(), 21, __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Tests restricting the corrections tables to a range of dates
+ *  @return Status of tests
+ *************************************************************************/
+bool test_CENamespace::test_CorrectionsRange()
+{
+    // Copy the files, since the binary caches of the originals are always
+    // used in full
+    CECorrections full;
+    full.SetInterp(CEInterpType::LINEAR);
+    std::vector<std::string> files = {WriteCopy(full.NutationFile(), ".rangetest"), 
+                                      WriteCopy(full.TtUt1HistFile(), ".rangetest"), 
+                                      WriteCopy(full.TtUt1PredFile(), ".rangetest")};
+    ScopedRemove cleanup(files);
+    CECorrections corr;
+    corr.SetInterp(CEInterpType::LINEAR);
+    corr.SetNutationFile(files[0]);
+    corr.SetTtUt1HistFile(files[1]);
+    corr.SetTtUt1PredFile(files[2]);
+
+    // Only the rows needed for the range are loaded
+    corr.SetMJDRange(51546.0, 51547.0);
+    test_double(corr.dut1(51546.5), full.dut1(51546.5), __func__, __LINE__);
+    test_int(corr.NutationRows(), 19, __func__, __LINE__);
+    corr.SetMJDRange(60000.0, 60100.0);
+    test_double(corr.ttut1(60050.0), full.ttut1(60050.0), __func__, __LINE__);
+    test_lessthan(corr.TtUt1Rows(), full.TtUt1Rows(), __func__, __LINE__);
+
+    // Dates outside of the range extend it
+    test_double(corr.dut1(51534.5), full.dut1(51534.5), __func__, __LINE__);
+    test_int(corr.NutationRows(), 21, __func__, __LINE__);
+    std::vector<double> mjd = {51520.0, 58500.0, 61600.0};
+    test_vect(corr.ttut1(mjd), full.ttut1(mjd), __func__, __LINE__);
+    test_int(corr.TtUt1Rows(), full.TtUt1Rows(), __func__, __LINE__);
+
+    // Dates moving past the end of the range don't reload on every lookup
+    // (without the binary cache written for the full table above)
+    std::remove(corr.NutationCacheFile().c_str());
+    CECorrections stream;
+    stream.SetInterp(CEInterpType::LINEAR);
+    stream.SetNutationFile(files[0]);
+    stream.SetMJDRange(51536.0, 51537.0);
+    for (int i=0; i<200; i++) {
+        stream.dut1(51537.0 + i/86400.0);
+    }
+    for (int i=0; i<160; i++) {
+        stream.dut1(51537.0 + 0.1*i);
+    }
+    test_lessthan(stream.Stats().nutation.loads, 3, __func__, __LINE__);
+    test_double(stream.dut1(51552.5), full.dut1(51552.5), __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Tests the handling of dates outside of the corrections tables
+ *  @return Status of tests
+ *************************************************************************/
+bool test_CENamespace::test_CorrectionsExtrap()
+{
+    CECorrections corr;
+    corr.SetInterp(CEInterpType::LINEAR);
+    test_bool(corr.ExtrapType() == CEExtrapType::NONE, true, __func__, __LINE__);
+
+    // By default dates after the table throw
+    bool threw = false;
+    try {
+        corr.dut1(51560.0);
+    } catch (CEException::invalid_value& e) {
+        threw = true;
+    }
+    test_bool(threw, true, __func__, __LINE__);
+
+    // Clamping uses the first or last row (51534 - 51554)
+    corr.SetExtrap(CEExtrapType::CLAMP);
+    double last_dut1 = corr.dut1(51554.0);
+    test_double(corr.dut1(51560.0), last_dut1, __func__, __LINE__);
+    test_double(corr.xpolar(51500.0), corr.xpolar(51534.0), __func__, __LINE__);
+    test_bool(corr.eop(51560.0).status == CELookupStatus::EXTRAPOLATED, true, 
+              __func__, __LINE__);
+    test_bool(corr.eop(51544.5).status == CELookupStatus::TABLE, true, 
+              __func__, __LINE__);
+
+    // Batched lookups report the status of each date (sorted or not)
+    std::vector<double>         mjd = {51540.0, 51560.0, 51545.0};
+    std::vector<double>         values(mjd.size());
+    std::vector<CELookupStatus> status(mjd.size());
+    corr.dut1(mjd.data(), values.data(), mjd.size(), status.data());
+    test_double(values[0], corr.dut1(51540.0), __func__, __LINE__);
+    test_double(values[1], last_dut1, __func__, __LINE__);
+    test_bool(status[0] == CELookupStatus::TABLE, true, __func__, __LINE__);
+    test_bool(status[1] == CELookupStatus::EXTRAPOLATED, true, __func__, __LINE__);
+    test_bool(status[2] == CELookupStatus::TABLE, true, __func__, __LINE__);
+    mjd = {51540.0, 51545.0, 51560.0};
+    corr.dut1(mjd.data(), values.data(), mjd.size(), status.data());
+    test_double(values[2], last_dut1, __func__, __LINE__);
+    test_bool(status[2] == CELookupStatus::EXTRAPOLATED, true, __func__, __LINE__);
+    std::vector<CEEop> eop = corr.eop(mjd);
+    test_double(eop[2].dut1, last_dut1, __func__, __LINE__);
+    test_double(eop[2].ttut1, corr.ttut1(51560.0), __func__, __LINE__);
+    test_bool(eop[1].status == CELookupStatus::TABLE, true, __func__, __LINE__);
+    test_bool(eop[2].status == CELookupStatus::EXTRAPOLATED, true, __func__, __LINE__);
+
+    // The Bulletin A model continues smoothly from the end of the table
+    corr.SetExtrap(CEExtrapType::BULLETIN_A);
+    test_lessthan(std::fabs(corr.dut1(51554.01) - last_dut1), 1.0e-4, __func__, __LINE__);
+    test_lessthan(std::fabs(corr.dut1(51644.0) - last_dut1), 0.5, __func__, __LINE__);
+    test_lessthan(std::fabs(corr.xpolar(51644.0)), 1.0 * DAS2R, __func__, __LINE__);
+    test_double(corr.dpsi(51644.0), corr.dpsi(51554.0), __func__, __LINE__);
+    test_greaterthan(corr.ttut1(62000.0), corr.ttut1(61680.0), __func__, __LINE__);
+    test_lessthan(corr.ttut1(62000.0), corr.ttut1(61680.0) + 1.0, __func__, __LINE__);
+
+    // The namespace corrections can also extrapolate
+    CppEphem::CorrectionsExtrap(CEExtrapType::CLAMP);
+    test_double(CppEphem::dut1(51560.0), CppEphem::dut1(51580.0), __func__, __LINE__);
+    CppEphem::CorrectionsExtrap(CEExtrapType::NONE);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Tests the usage statistics of the corrections
+ *  @return Status of tests
+ *************************************************************************/
+bool test_CENamespace::test_CorrectionsStats()
+{
+    CECorrections corr;
+    CECorrectionsStats stats = corr.Stats();
+    test_int(stats.nutation.loads, 0, __func__, __LINE__);
+    test_int(stats.nutation.lookups, 0, __func__, __LINE__);
+
+    // Single lookups either hit or miss the cache
+    corr.SetInterp(CEInterpType::LINEAR);
+    corr.dut1(51544.5);
+    corr.xpolar(51544.5);
+    corr.dut1(51545.5);
+    stats = corr.Stats();
+    test_int(stats.nutation.loads, 1, __func__, __LINE__);
+    test_int(stats.nutation.rows, 21, __func__, __LINE__);
+    test_int(stats.nutation.lookups, 3, __func__, __LINE__);
+    test_int(stats.nutation.cache_hits, 1, __func__, __LINE__);
+    test_int(stats.nutation.cache_misses, 2, __func__, __LINE__);
+    test_int(stats.nutation.interpolations, 2, __func__, __LINE__);
+    test_int(stats.ttut1.loads, 0, __func__, __LINE__);
+
+    // Batched lookups and dates outside of the table
+    corr.SetExtrap(CEExtrapType::CLAMP);
+    std::vector<double> mjd = {51540.0, 51541.0, 51600.0};
+    corr.dpsi(mjd);
+    corr.ttut1(51600.0);
+    stats = corr.Stats();
+    test_int(stats.nutation.lookups, 6, __func__, __LINE__);
+    test_int(stats.nutation.range_errors, 1, __func__, __LINE__);
+    test_int(stats.nutation.interpolations, 4, __func__, __LINE__);
+    test_int(stats.ttut1.loads, 1, __func__, __LINE__);
+    test_int(stats.ttut1.cache_misses, 1, __func__, __LINE__);
+
+    // Each thread counts its own cache hits
+    std::thread other([&]() {
+        corr.ttut1(51600.0);
+        corr.ttut1(51600.0);
+    });
+    other.join();
+    corr.ttut1(51600.0);
+    stats = corr.Stats();
+    test_int(stats.ttut1.cache_misses, 2, __func__, __LINE__);
+    test_int(stats.ttut1.cache_hits, 2, __func__, __LINE__);
+    test_int(stats.ttut1.lookups, 4, __func__, __LINE__);
+
+    // JSON document
+    std::string json = corr.StatsJSON();
+    test_bool(json.find("\"nutation\": {\"loads\": 1,") != std::string::npos, 
+              true, __func__, __LINE__);
+    test_bool(json.find("\"range_errors\": 1,") != std::string::npos, 
+              true, __func__, __LINE__);
+    test_bool(CppEphem::CorrectionsStatsJSON().find("\"downloads\": ") != std::string::npos, 
+              true, __func__, __LINE__);
+
+    // Reset
+    corr.ResetStats();
+    stats = corr.Stats();
+    test_int(stats.nutation.lookups, 0, __func__, __LINE__);
+    test_int(stats.ttut1.loads, 0, __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Tests loading the corrections tables in the background
+ *  @return Status of tests
+ *************************************************************************/
+bool test_CENamespace::test_CorrectionsPrefetch()
+{
+    // The tables are loaded once the future is ready
+    CECorrections corr;
+    std::shared_future<bool> prefetch = corr.Prefetch();
+    test_bool(prefetch.get(), true, __func__, __LINE__);
+    test_int(corr.NutationRows(), 21, __func__, __LINE__);
+    test_int(corr.TtUt1Rows(), 39, __func__, __LINE__);
+
+    // Lookups during a prefetch wait for it instead of loading again
+    CECorrections early;
+    prefetch = early.Prefetch();
+    test_double(early.dut1(51544.5), corr.dut1(51544.5), __func__, __LINE__);
+    test_double(early.ttut1(51544.5), corr.ttut1(51544.5), __func__, __LINE__);
+    test_bool(prefetch.get(), true, __func__, __LINE__);
+    test_int(early.Stats().nutation.loads, 1, __func__, __LINE__);
+    test_int(early.Stats().ttut1.loads, 1, __func__, __LINE__);
+
+    // Missing files are reported through the future
+    CECorrections missing;
+    missing.SetNutationFile("/nonexistent/cppephem/finals2000A.all");
+    test_bool(missing.Prefetch().get(), false, __func__, __LINE__);
+
+    // Prefetching loaded tables does nothing
+    test_bool(CppEphem::PrefetchCorrections().get(), true, __func__, __LINE__);
+
+    return pass();
+}
+
+
 /**********************************************************************//**
  * Tests the string operations
  * @return Whether the tests are passing or not
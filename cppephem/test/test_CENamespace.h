@@ -37,6 +37,19 @@ public:
     virtual bool test_SeaLevelVals(void);
     virtual bool test_Conversions(void);
     virtual bool test_Corrections(void);
+    virtual bool test_CorrectionsThreaded(void);
+    virtual bool test_CorrectionsBinaryCache(void);
+    virtual bool test_CorrectionsParser(void);
+    virtual bool test_CorrectionsIndex(void);
+    virtual bool test_CorrectionsBatch(void);
+    virtual bool test_CorrectionsSpline(void);
+    virtual bool test_CorrectionsReload(void);
+    virtual bool test_CorrectionsEmbedded(void);
+    virtual bool test_CorrectionsCopy(void);
+    virtual bool test_CorrectionsRange(void);
+    virtual bool test_CorrectionsExtrap(void);
+    virtual bool test_CorrectionsStats(void);
+    virtual bool test_CorrectionsPrefetch(void);
     virtual bool test_StrOpt(void);
 
 };
@@ -0,0 +1,305 @@
+/***************************************************************************
+ *  test_CENanoTime.cpp: CppEphem                                          *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "test_CENanoTime.h"
+#include "CENamespace.h"
+#include "CEException.h"
+
+
+/**********************************************************************//**
+ * Default constructor
+ *************************************************************************/
+test_CENanoTime::test_CENanoTime() :
+    CETestSuite()
+{}
+
+
+/**********************************************************************//**
+ * Destructor
+ *************************************************************************/
+test_CENanoTime::~test_CENanoTime()
+{}
+
+
+/**********************************************************************//**
+ * Run tests
+ * 
+ * @return whether or not all tests succeeded
+ *************************************************************************/
+bool test_CENanoTime::runtests()
+{
+    std::cout << "\nTesting CENanoTime:\n";
+
+    // Run each of the tests
+    test_TT();
+    test_UTC();
+    test_LeapSecond();
+    test_Arithmetic();
+    test_Range();
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test the TT and TAI representations
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CENanoTime::test_TT(void)
+{
+    // J2000.0 is the epoch
+    double tt1, tt2;
+    CENanoTime j2000;
+    j2000.TT(&tt1, &tt2);
+    test_double(tt1, DJ00, __func__, __LINE__);
+    test_bool(tt2 == 0.0, true, __func__, __LINE__);
+    test_bool(j2000.TAI() == -32184000000LL, true, __func__, __LINE__);
+
+    // A time one nanosecond after midnight TT, twenty years on
+    std::int64_t ns = 7305LL * CENanoTime::day_ns + CENanoTime::day_ns/2 + 1;
+    CENanoTime time = CENanoTime::FromTT(ns);
+    time.TT(&tt1, &tt2);
+    test_double(tt1, DJ00 + 7305.0, __func__, __LINE__);
+    test_double(tt2, 0.5 + 1.0/CENanoTime::day_ns, __func__, __LINE__);
+
+    // The nanosecond survives the round trip (but not a one part date)
+    test_bool(CENanoTime::FromTT(tt1, tt2) == time, true, __func__, __LINE__);
+    test_bool(CENanoTime::FromTT(tt2, tt1) == time, true, __func__, __LINE__);
+    test_bool(CENanoTime::FromTT(tt1 + tt2, 0.0) == time, false, __func__, __LINE__);
+
+    // Times before J2000
+    time = CENanoTime::FromTT(-123456789012345678LL);
+    time.TT(&tt1, &tt2);
+    test_greaterthan(tt2, -1.0e-15, __func__, __LINE__);
+    test_lessthan(tt2, 1.0, __func__, __LINE__);
+    test_bool(CENanoTime::FromTT(tt1, tt2) == time, true, __func__, __LINE__);
+
+    // TAI is 32.184 seconds behind TT
+    double tai1, tai2;
+    time.TAI(&tai1, &tai2);
+    double ttc1, ttc2;
+    iauTaitt(tai1, tai2, &ttc1, &ttc2);
+    test_lessthan(std::fabs(((ttc1 - tt1) + (ttc2 - tt2)) * DAYSEC), 1.0e-9, __func__, __LINE__);
+    test_bool(CENanoTime::FromTAI(time.TAI()) == time, true, __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test the UTC conversions against SOFA
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CENanoTime::test_UTC(void)
+{
+    // J2000.0 is 11:58:55.816 UTC
+    std::int64_t mjd, sod;
+    CENanoTime().UTC(&mjd, &sod);
+    test_int(int(mjd), 51544, __func__, __LINE__);
+    test_bool(sod == 43135816000000LL, true, __func__, __LINE__);
+
+    // Dates from the drifting UTC of the 1960s until today
+    for (std::int64_t day=37000; day<60000; day+=1371) {
+        std::int64_t ns_of_day = 12345678901234LL + day;
+        CENanoTime time = CENanoTime::FromUTC(day, ns_of_day);
+
+        // Compare TAI with SOFA
+        double utc1, utc2, tai1, tai2;
+        time.UTC(&utc1, &utc2);
+        iauUtctai(utc1, utc2, &tai1, &tai2);
+        double ntai1, ntai2;
+        time.TAI(&ntai1, &ntai2);
+        test_lessthan(std::fabs(((tai1 - ntai1) + (tai2 - ntai2)) * DAYSEC), 1.0e-8, 
+                      __func__, __LINE__);
+
+        // And the way back
+        time.UTC(&mjd, &sod);
+        test_int(int(mjd), int(day), __func__, __LINE__);
+        test_lessthan(std::fabs(double(sod - ns_of_day)), 1.5, __func__, __LINE__);
+        test_bool(CENanoTime::FromUTC(time.UTC()) == CENanoTime::FromUTC(day, sod), 
+                  true, __func__, __LINE__);
+    }
+
+    // Since 1972 the round trip is exact
+    std::int64_t unix_ns = 1700000000123456789LL;
+    test_bool(CENanoTime::FromUTC(unix_ns).UTC() == unix_ns, true, __func__, __LINE__);
+
+    // The current time
+    std::int64_t now = CENanoTime::Now().UTC();
+    test_lessthan(std::fabs(double(now/CENanoTime::sec_ns) - double(std::time(nullptr))), 2.0,
+                  __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test times around the leap second at the end of 2016
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CENanoTime::test_LeapSecond(void)
+{
+    // 2016 December 31 23:59:59.5, 23:59:60.5 and 2017 January 1 00:00:00.5
+    std::int64_t half = CENanoTime::sec_ns / 2;
+    CENanoTime before = CENanoTime::FromUTC(57753, CENanoTime::day_ns - half);
+    CENanoTime during = CENanoTime::FromUTC(57753, CENanoTime::day_ns + half);
+    CENanoTime after  = CENanoTime::FromUTC(57754, half);
+    test_bool((during - before) == CENanoTime::sec_ns, true, __func__, __LINE__);
+    test_bool((after - during) == CENanoTime::sec_ns, true, __func__, __LINE__);
+
+    // The leap second is given as 23:59:60
+    std::int64_t mjd, sod;
+    during.UTC(&mjd, &sod);
+    test_int(int(mjd), 57753, __func__, __LINE__);
+    test_bool(sod == CENanoTime::day_ns + half, true, __func__, __LINE__);
+    after.UTC(&mjd, &sod);
+    test_int(int(mjd), 57754, __func__, __LINE__);
+    test_bool(sod == half, true, __func__, __LINE__);
+
+    // The quasi Julian date matches SOFA's
+    double utc1, utc2, tai1, tai2;
+    during.UTC(&utc1, &utc2);
+    test_double(utc2, 86400.5/86401.0, __func__, __LINE__);
+    iauUtctai(utc1, utc2, &tai1, &tai2);
+    double ntai1, ntai2;
+    during.TAI(&ntai1, &ntai2);
+    test_lessthan(std::fabs(((tai1 - ntai1) + (tai2 - ntai2)) * DAYSEC), 1.0e-8, 
+                  __func__, __LINE__);
+
+    // POSIX time repeats a second
+    test_bool(during.UTC() == after.UTC(), true, __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test arithmetic, comparisons and the array conversion
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CENanoTime::test_Arithmetic(void)
+{
+    CENanoTime start = CENanoTime::FromUTC(1600000000000000000LL);
+    CENanoTime time  = start + 1500;
+    test_bool((time - start) == 1500, true, __func__, __LINE__);
+    test_bool(time > start, true, __func__, __LINE__);
+    test_bool(time >= start, true, __func__, __LINE__);
+    test_bool(start < time, true, __func__, __LINE__);
+    test_bool(start <= time, true, __func__, __LINE__);
+    test_bool(start != time, true, __func__, __LINE__);
+    time -= 1500;
+    test_bool(time == start, true, __func__, __LINE__);
+    time += 1;
+    test_bool((time - 1) == start, true, __func__, __LINE__);
+
+    // Arrays of times sort like integers
+    std::vector<CENanoTime> times;
+    for (int i=0; i<100; i++) {
+        times.push_back(start + ((i * 37) % 100) * 1000LL);
+    }
+    std::sort(times.begin(), times.end());
+    for (int i=0; i<100; i++) {
+        test_bool((times[i] - start) == i * 1000LL, true, __func__, __LINE__);
+    }
+
+    // Two-part dates of the whole array
+    std::vector<double> tt1(times.size());
+    std::vector<double> tt2(times.size());
+    CENanoTime::TT(&times[0], &tt1[0], &tt2[0], times.size());
+    for (std::size_t i=0; i<times.size(); i++) {
+        double t1, t2;
+        times[i].TT(&t1, &t2);
+        test_double(tt1[i], t1, __func__, __LINE__);
+        test_double(tt2[i], t2, __func__, __LINE__);
+    }
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test the ends of the range of times
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CENanoTime::test_Range(void)
+{
+    const std::int64_t lim = std::numeric_limits<std::int64_t>::max();
+    std::int64_t mjd;
+    std::int64_t sod;
+
+    // The latest time (2292) has a UTC day, but no POSIX time
+    CENanoTime last = CENanoTime::FromTT(lim);
+    last.UTC(&mjd, &sod);
+    test_greaterthan(mjd, 157000, __func__, __LINE__);
+    test_bool(CENanoTime::FromUTC(mjd, sod) == last, true, __func__, __LINE__);
+    try {
+        last.UTC();
+        test(false, __func__, __LINE__);
+    } catch (CEException::invalid_value& e) {
+        test(true, __func__, __LINE__);
+    }
+
+    // The earliest time with a TAI (1708) converts both ways
+    CENanoTime first = CENanoTime::FromTT(-lim + 40 * CENanoTime::sec_ns);
+    first.UTC(&mjd, &sod);
+    test_lessthan(mjd, -55000, __func__, __LINE__);
+    test_bool(CENanoTime::FromUTC(mjd, sod) == first, true, __func__, __LINE__);
+    test_bool(CENanoTime::FromUTC(first.UTC()) == first, true, __func__, __LINE__);
+
+    // Earlier UTC times cannot be represented
+    try {
+        CENanoTime::FromUTC(mjd - 1, sod);
+        test(false, __func__, __LINE__);
+    } catch (CEException::invalid_value& e) {
+        test(true, __func__, __LINE__);
+    }
+    try {
+        CENanoTime::FromUTC(std::numeric_limits<std::int64_t>::min());
+        test(false, __func__, __LINE__);
+    } catch (CEException::invalid_value& e) {
+        test(true, __func__, __LINE__);
+    }
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Main method that actually runs the tests
+ *************************************************************************/
+int main(int argc, char** argv) 
+{
+    test_CENanoTime tester;
+    return (!tester.runtests());
+}
@@ -0,0 +1,45 @@
+/***************************************************************************
+ *  test_CENanoTime.h: CppEphem                                            *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef test_CENanoTime_h
+#define test_CENanoTime_h
+
+#include "CENanoTime.h"
+#include "CETestSuite.h"
+
+class test_CENanoTime : public CETestSuite {
+public:
+    test_CENanoTime();
+    virtual ~test_CENanoTime();
+
+    virtual bool runtests();
+
+    /****** METHODS ******/
+
+    virtual bool test_TT(void);
+    virtual bool test_UTC(void);
+    virtual bool test_LeapSecond(void);
+    virtual bool test_Arithmetic(void);
+    virtual bool test_Range(void);
+
+};
+
+#endif /* test_CENanoTime_h */
@@ -23,9 +23,11 @@
  Defines tests for CEObserver
  */
 
+#include <cmath>
 #include <iostream>
 
 #include "test_CEObserver.h"
+#include "CEException.h"
 #include "CESkyCoord.h"
 #include "CENamespace.h"
 
@@ -64,6 +66,8 @@ bool test_CEObserver::runtests()
     test_set_geoCoords();
     test_set_atmoPars();
     test_time();
+    test_posvel();
+    test_incremental();
 
     return pass();
 }
@@ -236,6 +240,107 @@ bool test_CEObserver::test_time(void)
 }
 
 
+/**********************************************************************//**
+ * Test the observer position and velocity against SOFA
+ * 
+ * @return whether or not all tests succeeded
+ *************************************************************************/
+bool test_CEObserver::test_posvel(void)
+{
+    // A date with fixed Earth orientation parameters
+    CEEop eop = {0.3, 1.0e-6, 2.0e-6, 0.0, 0.0, 68.5, CELookupStatus::TABLE};
+    CETimeScales date1(58000.25, eop);
+    CETimeScales date2(58000.75, eop);
+    CEObserver   obs(-110.0, 32.0, 2000.0, CEAngleType::DEGREES);
+
+    // The geocentric position and velocity match iauPvtob
+    double pv[2][3];
+    iauPvtob(obs.Longitude_Rad(), obs.Latitude_Rad(), obs.Elevation_m(),
+             eop.xp, eop.yp, iauSp00(date1.TT1(), date1.TT2()), date1.ERA(), pv);
+    std::vector<double> pos1 = obs.PositionCIRS(date1);
+    std::vector<double> vel1 = obs.VelocityCIRS(date1);
+    for (int i=0; i<3; i++) {
+        test_double(pos1[i], pv[0][i] / CppEphem::m_per_au(), __func__, __LINE__);
+        test_double(vel1[i], pv[1][i] * CppEphem::sec_per_day() / CppEphem::m_per_au(),
+                    __func__, __LINE__);
+    }
+
+    // Switching dates does not reuse the wrong values
+    std::vector<double> icrs1 = obs.PositionICRS(date1);
+    std::vector<double> icrs2 = obs.PositionICRS(date2);
+    test_greaterthan(std::fabs(icrs2[0] - icrs1[0]), 1.0e-4, __func__, __LINE__);
+    test_vect(obs.PositionICRS(date1), icrs1, __func__, __LINE__);
+
+    // Nor does moving the observer
+    obs.SetLongitude(obs.Longitude_Rad() + 1.0);
+    test_greaterthan(std::fabs(obs.PositionCIRS(date1)[0] - pos1[0]), 1.0e-6, __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test the incremental updates of the position and velocity
+ * 
+ * @return whether or not all tests succeeded
+ *************************************************************************/
+bool test_CEObserver::test_incremental(void)
+{
+    CEEop eop = {0.3, 1.0e-6, 2.0e-6, 0.0, 0.0, 68.5, CELookupStatus::TABLE};
+    CEObserver exact(-110.0, 32.0, 2000.0, CEAngleType::DEGREES);
+    CEObserver incremental(exact);
+    test_bool(incremental.IncrementalError_m() == 0.0, true, __func__, __LINE__);
+    test_bool(incremental.IncrementalStep_s() == 0.0, true, __func__, __LINE__);
+
+    // One meter allows steps of about 18 seconds
+    incremental.SetIncrementalUpdate(1.0);
+    test_double(incremental.IncrementalError_m(), 1.0, __func__, __LINE__);
+    test_greaterthan(incremental.IncrementalStep_s(), 17.0, __func__, __LINE__);
+    test_lessthan(incremental.IncrementalStep_s(), 19.0, __func__, __LINE__);
+
+    // Step through a minute and a half around perihelion, and across
+    // the following UTC midnight
+    double max_pos_err = 0.0;
+    double max_cirs_err = 0.0;
+    double max_vel_err = 0.0;
+    for (double sec=0.0; sec<180.0; sec+=0.37) {
+        double mjd = (sec < 90.0) ? 58487.5 + sec/DAYSEC 
+                                  : 58488.0 + (sec - 135.0)/DAYSEC;
+        CETimeScales date(mjd, eop);
+        std::vector<double> pos  = incremental.PositionICRS(date);
+        std::vector<double> vel  = incremental.VelocityICRS(date);
+        std::vector<double> cirs = incremental.PositionCIRS(date);
+        std::vector<double> pos0  = exact.PositionICRS(date);
+        std::vector<double> vel0  = exact.VelocityICRS(date);
+        std::vector<double> cirs0 = exact.PositionCIRS(date);
+        for (int i=0; i<3; i++) {
+            max_pos_err  = std::fmax(max_pos_err, std::fabs(pos[i] - pos0[i]));
+            max_cirs_err = std::fmax(max_cirs_err, std::fabs(cirs[i] - cirs0[i]));
+            max_vel_err  = std::fmax(max_vel_err, std::fabs(vel[i] - vel0[i]));
+        }
+    }
+    test_lessthan(max_pos_err * CppEphem::m_per_au(), 1.0, __func__, __LINE__);
+    test_lessthan(max_cirs_err * CppEphem::m_per_au(), 1.0e-6, __func__, __LINE__);
+    test_lessthan(max_vel_err * CppEphem::m_per_au() / CppEphem::sec_per_day(), 0.12, 
+                  __func__, __LINE__);
+
+    // Turning it off gives the exact values again
+    incremental.SetIncrementalUpdate(0.0);
+    CETimeScales date(58487.5 + 10.0/DAYSEC, eop);
+    test_vect(incremental.PositionICRS(date), exact.PositionICRS(date), __func__, __LINE__);
+
+    // The budget cannot be negative
+    try {
+        incremental.SetIncrementalUpdate(-1.0);
+        test(false, __func__, __LINE__);
+    } catch (CEException::invalid_value& e) {
+        test(true, __func__, __LINE__);
+    }
+
+    return pass();
+}
+
+
 /**********************************************************************//**
  * Main method that actually runs the tests
  *************************************************************************/
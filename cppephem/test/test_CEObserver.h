@@ -37,6 +37,8 @@ public:
     bool test_set_geoCoords(void);
     bool test_set_atmoPars(void);
     bool test_time(void);
+    bool test_posvel(void);
+    bool test_incremental(void);
 
 private:
 
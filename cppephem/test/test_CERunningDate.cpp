@@ -61,6 +61,7 @@ bool test_CERunningDate::runtests()
     // Run each of the tests
     test_construct();
     test_timer_manip();
+    test_freeze();
 
     return pass();
 }
@@ -118,6 +119,51 @@ bool test_CERunningDate::test_timer_manip(void)
 }
 
 
+/**********************************************************************//**
+ * Test holding the date at one instant
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CERunningDate::test_freeze(void)
+{
+    CERunningDate test1(base_);
+    test(!test1.IsFrozen(), __func__, __LINE__);
+
+    // A frozen date doesn't change while time passes
+    test1.Freeze();
+    test(test1.IsFrozen(), __func__, __LINE__);
+    double jd  = test1.JD();
+    double mjd = test1.MJD();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    test(test1.JD() == jd, __func__, __LINE__);
+    test(test1.MJD() == mjd, __func__, __LINE__);
+
+    // Freezing it again doesn't move it either
+    test1.Freeze();
+    test(test1.JD() == jd, __func__, __LINE__);
+
+    // Copies are frozen at the same instant
+    CERunningDate test2(test1);
+    test(test2.IsFrozen(), __func__, __LINE__);
+    test(test2.JD() == jd, __func__, __LINE__);
+
+    // Ticking moves it to the current instant
+    test1.Tick();
+    test_greaterthan(test1.RunTime(), (jd - base_.CEDate::JD())*DAYSEC, __func__, __LINE__);
+    test(test1.JD() > jd, __func__, __LINE__);
+    test(test2.JD() == jd, __func__, __LINE__);
+
+    // Thawed dates follow the clock again
+    test1.Thaw();
+    test(!test1.IsFrozen(), __func__, __LINE__);
+    double runtime = test1.RunTime();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    test_greaterthan(test1.RunTime(), runtime, __func__, __LINE__);
+
+    return pass();
+}
+
+
 /**********************************************************************//**
  * Main method that actually runs the tests
  *************************************************************************/
@@ -36,6 +36,7 @@ public:
 
     virtual bool test_construct(void);
     virtual bool test_timer_manip(void);
+    virtual bool test_freeze(void);
 
 private:
     CEDate                    base_date_;
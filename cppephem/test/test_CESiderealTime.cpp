@@ -0,0 +1,219 @@
+/***************************************************************************
+ *  test_CESiderealTime.cpp: CppEphem                                      *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "test_CESiderealTime.h"
+#include "CENamespace.h"
+
+
+/**********************************************************************//**
+ * Default constructor
+ *************************************************************************/
+test_CESiderealTime::test_CESiderealTime() :
+    CETestSuite()
+{}
+
+
+/**********************************************************************//**
+ * Destructor
+ *************************************************************************/
+test_CESiderealTime::~test_CESiderealTime()
+{}
+
+
+/**********************************************************************//**
+ * Run tests
+ * 
+ * @return whether or not all tests succeeded
+ *************************************************************************/
+bool test_CESiderealTime::runtests()
+{
+    std::cout << "\nTesting CESiderealTime:\n";
+
+    // Run each of the tests
+    test_ERA();
+    test_GMST();
+    test_GAST();
+    test_LAST();
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test the Earth rotation angle against SOFA
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CESiderealTime::test_ERA(void)
+{
+    // Dates split in the ways SOFA suggests
+    std::vector<double> ut11;
+    std::vector<double> ut12;
+    for (double mjd=40000.0; mjd<70000.0; mjd+=1234.567) {
+        ut11.push_back(DJM0);
+        ut12.push_back(mjd);
+        ut11.push_back(DJM0 + mjd);
+        ut12.push_back(0.0);
+        ut11.push_back(0.0);
+        ut12.push_back(DJM0 + mjd);
+    }
+
+    // Single dates and arrays give exactly the same result as iauEra00
+    std::vector<double> era(ut11.size());
+    CESiderealTime::ERA(&ut11[0], &ut12[0], &era[0], era.size());
+    for (std::size_t i=0; i<era.size(); i++) {
+        double expected = iauEra00(ut11[i], ut12[i]);
+        test_double(CESiderealTime::ERA(ut11[i], ut12[i]), expected, __func__, __LINE__);
+        test_double(era[i], expected, __func__, __LINE__);
+    }
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test the Greenwich mean sidereal time against SOFA
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CESiderealTime::test_GMST(void)
+{
+    std::vector<double> ut11(100, DJM0);
+    std::vector<double> ut12(100);
+    std::vector<double> tt1(100, DJM0);
+    std::vector<double> tt2(100);
+    for (std::size_t i=0; i<ut12.size(); i++) {
+        ut12[i] = 51544.5 + i*37.123;
+        tt2[i]  = ut12[i] + 65.0/DAYSEC;
+    }
+
+    std::vector<double> gmst(ut12.size());
+    CESiderealTime::GMST(&ut11[0], &ut12[0], &tt1[0], &tt2[0], &gmst[0], gmst.size());
+    for (std::size_t i=0; i<gmst.size(); i++) {
+        double expected = iauGmst06(ut11[i], ut12[i], tt1[i], tt2[i]);
+        test_double(CESiderealTime::GMST(ut11[i], ut12[i], tt1[i], tt2[i]), 
+                    expected, __func__, __LINE__);
+        test_double(gmst[i], expected, __func__, __LINE__);
+    }
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test the Greenwich apparent sidereal time against SOFA
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CESiderealTime::test_GAST(void)
+{
+    // Dates between 1900 and 2100, including both ends of some segments
+    double max_diff = 0.0;
+    for (double t=-36525.0; t<36525.0; t+=97.3) {
+        double ee = CESiderealTime::EquationOfEquinoxes(DJ00, t);
+        max_diff = std::fmax(max_diff, 
+                             std::fabs(ee - CESiderealTime::SeriesEquationOfEquinoxes(DJ00, t)));
+    }
+    for (double t=-2.0*CESiderealTime::SegmentDays(); t<=2.0*CESiderealTime::SegmentDays(); t+=0.25) {
+        double ee = CESiderealTime::EquationOfEquinoxes(DJ00, t);
+        max_diff = std::fmax(max_diff, 
+                             std::fabs(ee - CESiderealTime::SeriesEquationOfEquinoxes(DJ00, t)));
+    }
+    test_lessthan(max_diff, 1.0e-13, __func__, __LINE__);
+
+    // GAST for single dates and arrays
+    std::vector<double> ut11(50, DJM0);
+    std::vector<double> ut12(50);
+    std::vector<double> tt1(50, DJM0);
+    std::vector<double> tt2(50);
+    for (std::size_t i=0; i<ut12.size(); i++) {
+        // Jumps back and forth between segments
+        ut12[i] = 58000.25 + ((i % 2) ? 1.0 : -1.0)*i*3.21;
+        tt2[i]  = ut12[i] + 69.184/DAYSEC;
+    }
+    std::vector<double> gast(ut12.size());
+    CESiderealTime::GAST(&ut11[0], &ut12[0], &tt1[0], &tt2[0], &gast[0], gast.size());
+    for (std::size_t i=0; i<gast.size(); i++) {
+        double expected = iauGst06a(ut11[i], ut12[i], tt1[i], tt2[i]);
+        test_lessthan(std::fabs(iauAnpm(gast[i] - expected)), 1.0e-12, __func__, __LINE__);
+        test_double(CESiderealTime::GAST(ut11[i], ut12[i], tt1[i], tt2[i]), 
+                    gast[i], __func__, __LINE__);
+    }
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test the local apparent sidereal time
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CESiderealTime::test_LAST(void)
+{
+    std::vector<double> ut11(20, DJM0);
+    std::vector<double> ut12(20);
+    std::vector<double> tt1(20, DJM0);
+    std::vector<double> tt2(20);
+    std::vector<double> longitude(20);
+    for (std::size_t i=0; i<ut12.size(); i++) {
+        ut12[i]      = 58000.0 + i*0.1;
+        tt2[i]       = ut12[i] + 69.184/DAYSEC;
+        longitude[i] = -DPI + i*0.3;
+    }
+
+    // One longitude for all dates
+    double lon = -110.0 * DD2R;
+    std::vector<double> last(ut12.size());
+    CESiderealTime::LAST(&ut11[0], &ut12[0], &tt1[0], &tt2[0], lon, &last[0], last.size());
+    for (std::size_t i=0; i<last.size(); i++) {
+        double gast = CESiderealTime::GAST(ut11[i], ut12[i], tt1[i], tt2[i]);
+        test_double(last[i], iauAnp(gast + lon), __func__, __LINE__);
+        test_double(CESiderealTime::LAST(ut11[i], ut12[i], tt1[i], tt2[i], lon),
+                    last[i], __func__, __LINE__);
+        test_greaterthan(last[i], -1.0e-15, __func__, __LINE__);
+        test_lessthan(last[i], D2PI, __func__, __LINE__);
+    }
+
+    // A longitude for each date
+    CESiderealTime::LAST(&ut11[0], &ut12[0], &tt1[0], &tt2[0], &longitude[0], &last[0], last.size());
+    for (std::size_t i=0; i<last.size(); i++) {
+        test_double(last[i], 
+                    CESiderealTime::LAST(ut11[i], ut12[i], tt1[i], tt2[i], longitude[i]),
+                    __func__, __LINE__);
+    }
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Main method that actually runs the tests
+ *************************************************************************/
+int main(int argc, char** argv) 
+{
+    test_CESiderealTime tester;
+    return (!tester.runtests());
+}
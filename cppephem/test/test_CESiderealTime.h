@@ -0,0 +1,44 @@
+/***************************************************************************
+ *  test_CESiderealTime.h: CppEphem                                        *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef test_CESiderealTime_h
+#define test_CESiderealTime_h
+
+#include "CESiderealTime.h"
+#include "CETestSuite.h"
+
+class test_CESiderealTime : public CETestSuite {
+public:
+    test_CESiderealTime();
+    virtual ~test_CESiderealTime();
+
+    virtual bool runtests();
+
+    /****** METHODS ******/
+
+    virtual bool test_ERA(void);
+    virtual bool test_GMST(void);
+    virtual bool test_GAST(void);
+    virtual bool test_LAST(void);
+
+};
+
+#endif /* test_CESiderealTime_h */
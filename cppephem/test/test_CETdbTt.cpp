@@ -0,0 +1,138 @@
+/***************************************************************************
+ *  test_CETdbTt.cpp: CppEphem                                             *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "test_CETdbTt.h"
+#include "CENamespace.h"
+
+
+/**********************************************************************//**
+ * Default constructor
+ *************************************************************************/
+test_CETdbTt::test_CETdbTt() :
+    CETestSuite()
+{}
+
+
+/**********************************************************************//**
+ * Destructor
+ *************************************************************************/
+test_CETdbTt::~test_CETdbTt()
+{}
+
+
+/**********************************************************************//**
+ * Run tests
+ * 
+ * @return whether or not all tests succeeded
+ *************************************************************************/
+bool test_CETdbTt::runtests()
+{
+    std::cout << "\nTesting CETdbTt:\n";
+
+    // Run each of the tests
+    test_Series();
+    test_TwoPart();
+    test_Arrays();
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test that the fitted values match the full series
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CETdbTt::test_Series(void)
+{
+    // Dates between 1900 and 2100, including both ends of some segments
+    double max_diff = 0.0;
+    double max_dtr  = 0.0;
+    for (double t=-36525.0; t<36525.0; t+=97.3) {
+        double dtr = CETdbTt::TdbTt(DJ00, t);
+        max_diff = std::fmax(max_diff, std::fabs(dtr - CETdbTt::SeriesTdbTt(DJ00, t)));
+        max_dtr  = std::fmax(max_dtr, std::fabs(dtr));
+    }
+    for (double t=-2.0*CETdbTt::SegmentDays(); t<=2.0*CETdbTt::SegmentDays(); t+=0.5) {
+        double dtr = CETdbTt::TdbTt(DJ00, t);
+        max_diff = std::fmax(max_diff, std::fabs(dtr - CETdbTt::SeriesTdbTt(DJ00, t)));
+    }
+    test_lessthan(max_diff, 1.0e-10, __func__, __LINE__);
+
+    // The size of the annual term
+    test_greaterthan(max_dtr, 1.6e-3, __func__, __LINE__);
+    test_lessthan(max_dtr, 1.8e-3, __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test that how the date is split in two doesn't matter
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CETdbTt::test_TwoPart(void)
+{
+    double mjd = 51544.5 + 0.123456;
+    double dtr = CETdbTt::TdbTt(DJM0, mjd);
+    test_lessthan(std::fabs(CETdbTt::TdbTt(DJM0 + mjd, 0.0) - dtr), 1.0e-12, __func__, __LINE__);
+    test_lessthan(std::fabs(CETdbTt::TdbTt(DJ00, mjd - (DJ00 - DJM0)) - dtr), 1.0e-12, __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test that the array version matches single dates
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CETdbTt::test_Arrays(void)
+{
+    std::vector<double> tt1(100, DJM0);
+    std::vector<double> tt2(100);
+    for (std::size_t i=0; i<tt2.size(); i++) {
+        // Jumps back and forth between segments
+        tt2[i] = 51544.5 + ((i % 2) ? 1.0 : -1.0)*i*1.37;
+    }
+    std::vector<double> dtr(tt2.size());
+    CETdbTt::TdbTt(&tt1[0], &tt2[0], &dtr[0], dtr.size());
+    for (std::size_t i=0; i<tt2.size(); i++) {
+        test_double(dtr[i], CETdbTt::TdbTt(tt1[i], tt2[i]), __func__, __LINE__);
+    }
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Main method that actually runs the tests
+ *************************************************************************/
+int main(int argc, char** argv) 
+{
+    test_CETdbTt tester;
+    return (!tester.runtests());
+}
@@ -0,0 +1,248 @@
+/***************************************************************************
+ *  test_CETimeScales.cpp: CppEphem                                        *
+ * ----------------------------------------------------------------------- *
+ *  Copyright © 2019 JCardenzana                                           *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <cmath>
+#include <thread>
+
+#include "test_CETimeScales.h"
+#include "CELeapSeconds.h"
+#include "CETdbTt.h"
+#include "CENamespace.h"
+
+
+/**********************************************************************//**
+ * Default constructor
+ *************************************************************************/
+test_CETimeScales::test_CETimeScales() :
+    CETestSuite()
+{
+    // Set the date to J2000 Julian date
+    base_date_.SetDate(2451545.000000);
+    base_ = CETimeScales(base_date_);
+}
+
+
+/**********************************************************************//**
+ * Destructor
+ *************************************************************************/
+test_CETimeScales::~test_CETimeScales()
+{}
+
+
+/**********************************************************************//**
+ * Run tests
+ * 
+ * @return whether or not all tests succeeded
+ *************************************************************************/
+bool test_CETimeScales::runtests()
+{
+    std::cout << "\nTesting CETimeScales:\n";
+
+    // Run each of the tests
+    test_construct();
+    test_TimeScales();
+    test_Precision();
+    test_Threads();
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test constructors
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CETimeScales::test_construct(void)
+{
+    // Date of the base object
+    test_double(base_.JD(), base_date_.JD(), __func__, __LINE__);
+    test_double(base_.MJD(), base_date_.MJD(), __func__, __LINE__);
+    test_double(base_.UTC1(), base_date_.JD1(), __func__, __LINE__);
+    test_double(base_.UTC2(), base_date_.JD2(), __func__, __LINE__);
+
+    // Default constructor uses the current date (the corrections are only
+    // looked up once a time scale is needed, so this is allowed outside of
+    // the corrections tables)
+    CETimeScales test1;
+    test_greaterthan(test1.JD(), 2458485.0, __func__, __LINE__);
+
+    // Construct from a Julian or modified Julian date
+    CETimeScales test2(base_date_.JD());
+    test_double(test2.TDB2(), base_.TDB2(), __func__, __LINE__);
+    CETimeScales test3(base_date_.MJD(), CEDateType::MJD);
+    test_double(test3.TDB1() + test3.TDB2(), base_.TDB1() + base_.TDB2(),
+                __func__, __LINE__);
+
+    // Construct from already known corrections
+    CETimeScales test4(base_date_.MJD(), base_date_.eop());
+    test_double(test4.TT1() + test4.TT2(), base_.TT1() + base_.TT2(),
+                __func__, __LINE__);
+    test_double(test4.eop().dut1, base_date_.dut1(), __func__, __LINE__);
+
+    // Copy constructor and assignment
+    CETimeScales test5(base_);
+    test_double(test5.UT12(), base_.UT12(), __func__, __LINE__);
+    test1 = base_;
+    test_double(test1.ERA(), base_.ERA(), __func__, __LINE__);
+
+    // Dates convert implicitly
+    test1.SetDate(CEDate(base_date_.MJD() + 1.0, CEDateType::MJD));
+    test_double(test1.MJD(), base_date_.MJD() + 1.0, __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test that the time scales match the separate CEDate conversions
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CETimeScales::test_TimeScales(void)
+{
+    double mjd = base_date_.MJD();
+
+    // The base object keeps the two parts of the Julian date
+    double ut11, ut12;
+    CELeapSeconds::UTC2UT1(base_date_.JD1(), base_date_.JD2(), base_date_.dut1(),
+                           &ut11, &ut12);
+    test_double(base_.UT11(), ut11, __func__, __LINE__);
+    test_double(base_.UT12(), ut12, __func__, __LINE__);
+    double tai1, tai2;
+    CELeapSeconds::UTC2TAI(base_date_.JD1(), base_date_.JD2(), &tai1, &tai2);
+    test_double(base_.TAI1(), tai1, __func__, __LINE__);
+    test_double(base_.TAI2(), tai2, __func__, __LINE__);
+    test_double(base_.ERA(), iauEra00(ut11, ut12), __func__, __LINE__);
+
+    // A modified Julian date gives the same parts as the CEDate conversions
+    CETimeScales times(mjd, base_date_.eop());
+
+    // UT1
+    CEDate::UTC2UT1(mjd, &ut11, &ut12);
+    test_double(times.UT11(), ut11, __func__, __LINE__);
+    test_double(times.UT12(), ut12, __func__, __LINE__);
+    test_double(base_.UT11() + base_.UT12(), ut11 + ut12, __func__, __LINE__);
+
+    // TAI
+    CELeapSeconds::UTC2TAI(mjd, &tai1, &tai2);
+    test_double(times.TAI1(), tai1, __func__, __LINE__);
+    test_double(times.TAI2(), tai2, __func__, __LINE__);
+
+    // TT is TAI + 32.184 s, consistent with the TAI of the same object
+    double tt1, tt2;
+    CELeapSeconds::UTC2TT(mjd, &tt1, &tt2);
+    test_double(times.TT1(), tt1, __func__, __LINE__);
+    test_double(times.TT2(), tt2, __func__, __LINE__);
+    test_double(base_.TT1() + base_.TT2(), tt1 + tt2, __func__, __LINE__);
+    test_lessthan(std::fabs(((base_.TT1() - base_.TAI1()) + (base_.TT2() - base_.TAI2()))
+                            * DAYSEC - TTMTAI), 1.0e-9, __func__, __LINE__);
+
+    // TDB
+    double tdb1, tdb2;
+    iauTttdb(tt1, tt2, CETdbTt::TdbTt(tt1, tt2), &tdb1, &tdb2);
+    test_double(times.TDB1(), tdb1, __func__, __LINE__);
+    test_double(times.TDB2(), tdb2, __func__, __LINE__);
+    test_double(base_.TDB1() + base_.TDB2(), tdb1 + tdb2, __func__, __LINE__);
+
+    // Earth rotation angle
+    test_double(times.ERA(), iauEra00(ut11, ut12), __func__, __LINE__);
+
+    // Earth orientation parameters
+    CEEop eop = base_date_.eop();
+    test_double(base_.eop().xp, eop.xp, __func__, __LINE__);
+    test_double(base_.eop().yp, eop.yp, __func__, __LINE__);
+    test_double(base_.eop().ttut1, eop.ttut1, __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test that a two-part date keeps sub-microsecond offsets
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CETimeScales::test_Precision(void)
+{
+    // 0.1 microseconds is below the resolution of a single MJD
+    double offset = 1.0e-7 / DAYSEC;
+    CEEop  eop    = base_date_.eop();
+    CETimeScales times1(CEDate(base_date_.JD()));
+    CETimeScales times2;
+    times1.SetDate(base_date_.JD(), 0.0, eop);
+    times2.SetDate(base_date_.JD(), offset, eop);
+
+    // Each time scale moves by the offset
+    double tol = 1.0e-3 * offset;
+    test_lessthan(std::fabs((times2.TAI2() - times1.TAI2()) - offset), tol,
+                  __func__, __LINE__);
+    test_lessthan(std::fabs((times2.UT12() - times1.UT12()) - offset), tol,
+                  __func__, __LINE__);
+    test_lessthan(std::fabs((times2.TT2() - times1.TT2()) - offset), tol,
+                  __func__, __LINE__);
+
+    // The same offset is lost in a single modified Julian date
+    CETimeScales times3(base_date_.MJD() + offset, eop);
+    test_lessthan(1.0e-2 * offset,
+                  std::fabs((times3.TAI2() - times1.TAI2()) - offset),
+                  __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Test that a const object can be shared by threads
+ * 
+ * @return whether the tests succeed
+ *************************************************************************/
+bool test_CETimeScales::test_Threads(void)
+{
+    const CETimeScales shared(base_date_);
+
+    // Each thread asks for the (not yet computed) time scales
+    std::vector<double> tdb(4, 0.0);
+    std::vector<std::thread> threads;
+    for (std::size_t i=0; i<tdb.size(); i++) {
+        threads.push_back(std::thread([&shared, &tdb, i]() {
+            tdb[i] = shared.TDB1() + shared.TDB2();
+        }));
+    }
+    for (std::size_t i=0; i<threads.size(); i++) {
+        threads[i].join();
+    }
+
+    test_vect(tdb, std::vector<double>(4, base_.TDB1() + base_.TDB2()),
+              __func__, __LINE__);
+
+    return pass();
+}
+
+
+/**********************************************************************//**
+ * Main method that actually runs the tests
+ *************************************************************************/
+int main(int argc, char** argv) 
+{
+    test_CETimeScales tester;
+    return (!tester.runtests());
+}